@@ -1727,6 +1727,7 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF("navigation/avoidance/thread_model/avoidance_use_high_priority_threads", true);
 
 	GLOBAL_DEF("navigation/pathfinding/max_threads", 4);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "navigation/pathfinding/path_cache_size", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 0);
 
 	GLOBAL_DEF("navigation/baking/use_crash_prevention_checks", true);
 	GLOBAL_DEF("navigation/baking/thread_model/baking_use_multiple_threads", true);
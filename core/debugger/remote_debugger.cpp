@@ -42,6 +42,10 @@
 #include "core/os/os.h"
 #include "servers/display_server.h"
 
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#endif
+
 class RemoteDebugger::PerformanceProfiler : public EngineProfiler {
 	Object *performance = nullptr;
 	int last_perf_time = 0;
@@ -684,6 +688,39 @@ void RemoteDebugger::poll_events(bool p_is_idle) {
 	}
 }
 
+void RemoteDebugger::_send_memory_tags() {
+	Array tags;
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		Memory::Tag tag = Memory::Tag(i);
+		tags.push_back(Array{ Memory::get_tag_name(tag), Memory::get_tag_usage(tag), Memory::get_tag_max_usage(tag), Memory::get_tag_alloc_count(tag) });
+	}
+
+	Memory::LargeAllocSample samples[Memory::MAX_LARGE_ALLOC_SAMPLES];
+	int sample_count = Memory::get_large_alloc_samples(samples, Memory::MAX_LARGE_ALLOC_SAMPLES);
+	Array large_allocs;
+	for (int i = 0; i < sample_count; i++) {
+		const Memory::LargeAllocSample &sample = samples[i];
+		PackedStringArray frames;
+#if defined(__GLIBC__) || defined(__APPLE__)
+		// Symbols are resolved here rather than when sampling, unresolved ones still carry a module offset usable with addr2line.
+		char **symbols = backtrace_symbols(sample.frames, sample.frame_count);
+		if (symbols) {
+			for (int j = 0; j < sample.frame_count; j++) {
+				frames.push_back(String::utf8(symbols[j]));
+			}
+			::free(symbols);
+		}
+#else
+		for (int j = 0; j < sample.frame_count; j++) {
+			frames.push_back("0x" + String::num_uint64((uint64_t)sample.frames[j], 16));
+		}
+#endif
+		large_allocs.push_back(Array{ Memory::get_tag_name(sample.tag), sample.bytes, frames });
+	}
+
+	send_message("memory_tags", Array{ tags, large_allocs });
+}
+
 Error RemoteDebugger::_core_capture(const String &p_cmd, const Array &p_data, bool &r_captured) {
 	r_captured = true;
 	if (p_cmd == "reload_scripts") {
@@ -707,6 +744,8 @@ Error RemoteDebugger::_core_capture(const String &p_cmd, const Array &p_data, bo
 		script_debugger->set_ignore_error_breaks(p_data[0]);
 	} else if (p_cmd == "break") {
 		script_debugger->debug(script_debugger->get_break_language());
+	} else if (p_cmd == "memory_tags") {
+		_send_memory_tags();
 	} else {
 		r_captured = false;
 	}
@@ -103,6 +103,7 @@ private:
 	void flush_output();
 
 	void _send_stack_vars(List<String> &p_names, List<Variant> &p_vals, int p_type);
+	void _send_memory_tags();
 
 	Error _profiler_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
 	Error _core_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
@@ -53,6 +53,7 @@
 #include "bvh_tree.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -89,6 +90,14 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When at least this many items have changed since the last collision check, their tree queries
+	// run in parallel on the WorkerThreadPool. Pairing and callbacks still happen afterwards on the
+	// calling thread, in the same order as the serial path, so the results are identical. 0 disables.
+	void params_set_parallel_pairing_threshold(uint32_t p_threshold) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing_threshold = p_threshold;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -382,6 +391,45 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Same as cull_aabb() and cull_segment(), but culling into r_hits instead of the shared buffer,
+	// and without locking. Several threads can cull at once, each with its own r_hits, as long as
+	// nothing modifies the BVH meanwhile.
+	int cull_aabb_hits(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, LocalVector<uint32_t> &r_hits, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.abb.from(p_aabb);
+		params.tester = p_tester;
+
+		tree.cull_aabb_hits(params, r_hits);
+		tree._cull_translate_hits(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
+	int cull_segment_hits(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, LocalVector<uint32_t> &r_hits, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		tree.cull_segment_hits(params, r_hits);
+		tree._cull_translate_hits(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -436,6 +484,11 @@ private:
 			return;
 		}
 
+		if (_parallel_pairing_threshold && changed_items.size() >= _parallel_pairing_threshold && WorkerThreadPool::get_singleton()) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -479,6 +532,90 @@ private:
 		_reset();
 	}
 
+	// Nothing in the tree changes while pairing, so the overlap queries of all the changed items
+	// can be done up front on several threads, each part writing into its own scratch buffers.
+	// The pair lists and callbacks are then processed serially, in changed_items order.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		uint32_t item_count = changed_items.size();
+		uint32_t part_count = MIN(item_count, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 4);
+
+		_pairing_scratch.resize(MAX(part_count, 1u));
+		for (PairingScratch &scratch : _pairing_scratch) {
+			scratch.collidees.clear();
+			scratch.collidee_counts.clear();
+		}
+
+		WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, item_count, _pairing_scratch, [this](uint32_t p_from, uint32_t p_to, PairingScratch &r_scratch) {
+			typename BVHTREE_CLASS::CullParams params;
+
+			params.result_count_overall = 0;
+			params.result_max = INT_MAX;
+			params.result_array = nullptr;
+			params.subindex_array = nullptr;
+
+			for (uint32_t i = p_from; i < p_to; i++) {
+				const BVHHandle &h = changed_items[i];
+				uint32_t changed_item_ref_id = h.id();
+
+				tree.item_fill_cullparams(h, params);
+				params.abb.from(tree._pairs[changed_item_ref_id].expanded_aabb);
+				tree.cull_aabb_hits(params, r_scratch.cull_hits);
+
+				const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(h);
+				uint32_t count = 0;
+
+				for (const uint32_t ref_id : r_scratch.cull_hits) {
+					// don't collide against ourself
+					if (ref_id == changed_item_ref_id) {
+						continue;
+					}
+
+					// Discard the pairs _collide() would reject anyway, while still in parallel.
+					const typename BVHTREE_CLASS::ItemExtra &exb = tree._extra[ref_id];
+					if ((exa.userdata == exb.userdata) && exa.userdata) {
+						continue;
+					}
+					// same argument order as _collide(), lower ID first
+					bool pair_allowed = changed_item_ref_id < ref_id ? USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata) : USER_PAIR_TEST_FUNCTION::user_pair_check(exb.userdata, exa.userdata);
+					if (!pair_allowed) {
+						continue;
+					}
+
+					r_scratch.collidees.push_back(ref_id);
+					count++;
+				}
+				r_scratch.collidee_counts.push_back(count);
+			}
+		},
+				SNAME("BVH pairing"));
+
+		// Parts cover contiguous ranges of changed_items in order, so walking them in order
+		// visits the items exactly like the serial path does.
+		uint32_t item = 0;
+		for (const PairingScratch &scratch : _pairing_scratch) {
+			uint32_t next = 0;
+			for (const uint32_t count : scratch.collidee_counts) {
+				const BVHHandle &h = changed_items[item++];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+
+				// find all the existing paired aabbs that are no longer
+				// paired, and send callbacks
+				_find_leavers(h, abb, p_full_check);
+
+				for (uint32_t n = 0; n < count; n++) {
+					BVHHandle h_collidee;
+					h_collidee.set_id(scratch.collidees[next++]);
+
+					// find NEW enterers, and send callbacks for them only
+					_collide(h, h_collidee);
+				}
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -772,6 +909,15 @@ private:
 	LocalVector<BVHHandle> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// per part buffers for parallel pairing, kept between ticks to avoid reallocating
+	struct PairingScratch {
+		LocalVector<uint32_t> cull_hits;
+		LocalVector<uint32_t> collidees;
+		LocalVector<uint32_t> collidee_counts;
+	};
+	LocalVector<PairingScratch> _pairing_scratch;
+	uint32_t _parallel_pairing_threshold = 0;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  frame_task_graph.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_task_graph.h"
+
+#include "core/os/os.h"
+
+bool FrameTaskGraph::_intersects(const LocalVector<StringName> &p_a, const LocalVector<StringName> &p_b) {
+	for (const StringName &name : p_a) {
+		if (p_b.has(name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FrameTaskGraph::_has_hazard(const Stage &p_before, const Stage &p_after) {
+	if ((p_before.flags & STAGE_FLAG_EXCLUSIVE) || (p_after.flags & STAGE_FLAG_EXCLUSIVE)) {
+		return true;
+	}
+	// Read after write, write after write and write after read, respectively.
+	return _intersects(p_before.writes, p_after.reads) || _intersects(p_before.writes, p_after.writes) || _intersects(p_before.reads, p_after.writes);
+}
+
+void FrameTaskGraph::_build_dependencies() {
+	for (Stage &stage : stages) {
+		stage.successors.clear();
+		stage.pending_predecessors = 0;
+		stage.task_id = WorkerThreadPool::INVALID_TASK_ID;
+		stage.time_usec = 0;
+	}
+
+	for (uint32_t i = 1; i < stages.size(); i++) {
+		for (uint32_t j = 0; j < i; j++) {
+			if (_has_hazard(stages[j], stages[i])) {
+				stages[j].successors.push_back(i);
+				stages[i].pending_predecessors++;
+			}
+		}
+	}
+}
+
+void FrameTaskGraph::_run_stage(Stage *p_stage) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	Callable::CallError ce;
+	Variant ret;
+	p_stage->callable.callp(nullptr, 0, ret, ce);
+	if (unlikely(ce.error != Callable::CallError::CALL_OK)) {
+		ERR_PRINT("Frame stage '" + String(p_stage->name) + "' failed: " + Variant::get_callable_error_text(p_stage->callable, nullptr, 0, ce) + ".");
+	}
+
+	p_stage->time_usec = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void FrameTaskGraph::_run_stage_task(void *p_stage) {
+	Stage *stage = (Stage *)p_stage;
+	_run_stage(stage);
+
+	FrameTaskGraph *graph = stage->graph;
+	{
+		MutexLock lock(graph->completed_mutex);
+		graph->completed.push_back(stage - graph->stages.ptr());
+	}
+	graph->completed_semaphore.post();
+}
+
+void FrameTaskGraph::_dispatch_stage(uint32_t p_index, LocalVector<uint32_t> &r_main_thread_ready) {
+	Stage &stage = stages[p_index];
+#ifdef THREADS_ENABLED
+	if (!(stage.flags & STAGE_FLAG_MAIN_THREAD)) {
+		stage.task_id = WorkerThreadPool::get_singleton()->add_native_task(&FrameTaskGraph::_run_stage_task, &stage, true, stage.name);
+		return;
+	}
+#endif
+	r_main_thread_ready.push_back(p_index);
+}
+
+void FrameTaskGraph::_finish_stage(uint32_t p_index, LocalVector<uint32_t> &r_main_thread_ready) {
+	for (uint32_t successor : stages[p_index].successors) {
+		DEV_ASSERT(stages[successor].pending_predecessors > 0);
+		if (--stages[successor].pending_predecessors == 0) {
+			_dispatch_stage(successor, r_main_thread_ready);
+		}
+	}
+}
+
+FrameTaskGraph::StageID FrameTaskGraph::add_stage(const StringName &p_name, const Callable &p_callable, const Vector<StringName> &p_reads, const Vector<StringName> &p_writes, uint32_t p_flags) {
+	ERR_FAIL_COND_V_MSG(running, INVALID_STAGE_ID, "Can't add stages to a FrameTaskGraph while it's running.");
+	ERR_FAIL_COND_V(!p_callable.is_valid(), INVALID_STAGE_ID);
+
+	Stage stage;
+	stage.graph = this;
+	stage.name = p_name;
+	stage.callable = p_callable;
+	for (const StringName &name : p_reads) {
+		stage.reads.push_back(name);
+	}
+	for (const StringName &name : p_writes) {
+		stage.writes.push_back(name);
+	}
+	stage.flags = p_flags;
+	stages.push_back(stage);
+
+	return stages.size() - 1;
+}
+
+void FrameTaskGraph::run() {
+	ERR_FAIL_COND_MSG(running, "FrameTaskGraph::run() is not reentrant.");
+	if (stages.is_empty()) {
+		return;
+	}
+
+	running = true;
+	_build_dependencies();
+
+	// Stages waiting to run on this thread, in the order they became ready.
+	LocalVector<uint32_t> main_thread_ready;
+	for (uint32_t i = 0; i < stages.size(); i++) {
+		if (stages[i].pending_predecessors == 0) {
+			_dispatch_stage(i, main_thread_ready);
+		}
+	}
+
+	uint32_t remaining = stages.size();
+	uint32_t main_thread_next = 0;
+	while (remaining) {
+		if (main_thread_next < main_thread_ready.size()) {
+			uint32_t index = main_thread_ready[main_thread_next++];
+			_run_stage(&stages[index]);
+			_finish_stage(index, main_thread_ready);
+			remaining--;
+			continue;
+		}
+
+		completed_semaphore.wait();
+		uint32_t index;
+		{
+			MutexLock lock(completed_mutex);
+			DEV_ASSERT(!completed.is_empty());
+			index = completed[completed.size() - 1];
+			completed.resize(completed.size() - 1);
+		}
+		// The stage itself is already done, this only releases the task.
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(stages[index].task_id);
+		stages[index].task_id = WorkerThreadPool::INVALID_TASK_ID;
+		_finish_stage(index, main_thread_ready);
+		remaining--;
+	}
+
+	running = false;
+}
+
+void FrameTaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a FrameTaskGraph while it's running.");
+	stages.clear();
+}
+
+StringName FrameTaskGraph::get_stage_name(StageID p_stage) const {
+	ERR_FAIL_INDEX_V(p_stage, (int32_t)stages.size(), StringName());
+	return stages[p_stage].name;
+}
+
+uint64_t FrameTaskGraph::get_stage_time_usec(StageID p_stage) const {
+	ERR_FAIL_INDEX_V(p_stage, (int32_t)stages.size(), 0);
+	return stages[p_stage].time_usec;
+}
+
+FrameTaskGraph::~FrameTaskGraph() {
+	DEV_ASSERT(!running);
+}
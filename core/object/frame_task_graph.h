@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  frame_task_graph.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/callable.h"
+
+// Runs the stages of a frame as a dependency graph on the WorkerThreadPool.
+//
+// Each stage declares the resources (arbitrary names, e.g. "physics_3d") it reads and writes.
+// A stage depends on every earlier registered stage it has a read/write or write/write hazard with,
+// so stages that don't touch the same resources can overlap, while the result is the same as running
+// them serially in registration order.
+//
+// Stages flagged STAGE_FLAG_MAIN_THREAD always run on the thread calling run(). Stages flagged
+// STAGE_FLAG_EXCLUSIVE don't overlap any other stage; use it for stages that call user code, which
+// may touch any server.
+class FrameTaskGraph {
+public:
+	typedef int32_t StageID;
+
+	enum {
+		INVALID_STAGE_ID = -1
+	};
+
+	enum StageFlags {
+		STAGE_FLAG_NONE = 0,
+		STAGE_FLAG_MAIN_THREAD = 1,
+		STAGE_FLAG_EXCLUSIVE = 2,
+	};
+
+private:
+	struct Stage {
+		FrameTaskGraph *graph = nullptr;
+		StringName name;
+		Callable callable;
+		LocalVector<StringName> reads;
+		LocalVector<StringName> writes;
+		uint32_t flags = STAGE_FLAG_NONE;
+
+		LocalVector<uint32_t> successors;
+		uint32_t pending_predecessors = 0;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		uint64_t time_usec = 0;
+	};
+
+	LocalVector<Stage> stages;
+	bool running = false;
+
+	// Stages finished by pool threads, consumed by the thread calling run().
+	Mutex completed_mutex;
+	LocalVector<uint32_t> completed;
+	Semaphore completed_semaphore;
+
+	static bool _has_hazard(const Stage &p_before, const Stage &p_after);
+	static bool _intersects(const LocalVector<StringName> &p_a, const LocalVector<StringName> &p_b);
+
+	void _build_dependencies();
+	void _dispatch_stage(uint32_t p_index, LocalVector<uint32_t> &r_main_thread_ready);
+	void _finish_stage(uint32_t p_index, LocalVector<uint32_t> &r_main_thread_ready);
+	static void _run_stage(Stage *p_stage);
+	static void _run_stage_task(void *p_stage);
+
+public:
+	StageID add_stage(const StringName &p_name, const Callable &p_callable, const Vector<StringName> &p_reads, const Vector<StringName> &p_writes, uint32_t p_flags = STAGE_FLAG_NONE);
+
+	// Runs all the stages and returns when they're done. Stages can't be added while running.
+	void run();
+	void clear();
+
+	uint32_t get_stage_count() const { return stages.size(); }
+	StringName get_stage_name(StageID p_stage) const;
+	// Time taken by the stage in the last run().
+	uint64_t get_stage_time_usec(StageID p_stage) const;
+
+	FrameTaskGraph() {}
+	~FrameTaskGraph();
+};
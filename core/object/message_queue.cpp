@@ -37,34 +37,147 @@
 #include <cstdio>
 
 #ifdef DEV_ENABLED
-// Includes safety checks to ensure that a queue set as a thread singleton override
-// is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
-	} else {                                      \
-		DEV_ASSERT(is_current_thread_override);   \
-	}
+// Ensures that a queue set as a thread singleton override is only ever used
+// from the thread it was set for.
+#define CHECK_THREAD_OVERRIDE DEV_ASSERT(this == MessageQueue::thread_singleton || !is_current_thread_override)
 #else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
-	}
+#define CHECK_THREAD_OVERRIDE
 #endif
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+SafeNumeric<uint64_t> CallQueue::last_queue_id;
+thread_local CallQueue::ShardCache CallQueue::shard_cache;
+thread_local CallQueue::ThreadLifetimeHolder CallQueue::thread_lifetime;
+
+CallQueue::ThreadLifetimeHolder::~ThreadLifetimeHolder() {
+	if (!lifetime) {
+		return;
+	}
+	// Anything pushed after this would go to a shard that may be freed at any time, so forget them all.
+	memset(shard_cache.queue_ids, 0, sizeof(shard_cache.queue_ids));
+	lifetime->exited.store(true, std::memory_order_release);
+	_unref_thread_lifetime(lifetime);
+	lifetime = nullptr;
+}
+
+CallQueue::ThreadLifetime *CallQueue::_get_thread_lifetime() {
+	if (!thread_lifetime.lifetime) {
+		thread_lifetime.lifetime = memnew(ThreadLifetime);
+		thread_lifetime.lifetime->refcount.init();
+	}
+	return thread_lifetime.lifetime;
+}
+
+void CallQueue::_unref_thread_lifetime(ThreadLifetime *p_lifetime) {
+	if (p_lifetime->refcount.unref()) {
+		memdelete(p_lifetime);
+	}
+}
+
+CallQueue::Shard *CallQueue::_register_shard() {
+	MutexLock lock(mutex);
+
+	// The shard may already exist if the cache slot was taken by another queue.
+	Thread::ID caller_id = Thread::get_caller_id();
+	Shard *shard = shards.load(std::memory_order_relaxed);
+	while (shard && shard->owner != caller_id) {
+		shard = shard->next_shard;
+	}
+
+	if (!shard) {
+		shard = memnew(Shard);
+		shard->owner = caller_id;
+		shard->owner_lifetime = _get_thread_lifetime();
+		shard->owner_lifetime->refcount.ref();
+		shard->write_page = allocator->alloc();
+		shard->read_page = shard->write_page;
+		pages_allocated.fetch_add(1, std::memory_order_relaxed);
+		shard->next_shard = shards.load(std::memory_order_relaxed);
+		shards.store(shard, std::memory_order_release);
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+	uint32_t slot = queue_id & (SHARD_CACHE_SIZE - 1);
+	shard_cache.queue_ids[slot] = queue_id;
+	shard_cache.shards[slot] = shard;
+	return shard;
+}
+
+void CallQueue::_free_shard(Shard *p_shard) {
+	Page *lists[3] = { p_shard->read_page, p_shard->free_pages, p_shard->returned_pages.load(std::memory_order_acquire) };
+	for (Page *page : lists) {
+		while (page) {
+			Page *next = page->next.load(std::memory_order_relaxed);
+			allocator->free(page);
+			pages_allocated.fetch_sub(1, std::memory_order_relaxed);
+			page = next;
+		}
+	}
+	_unref_thread_lifetime(p_shard->owner_lifetime);
+	memdelete(p_shard);
+}
+
+void CallQueue::_free_exited_shards() {
+	// Called with the mutex held and nothing being consumed, so the shard list can be edited.
+	Shard *prev = nullptr;
+	Shard *shard = shards.load(std::memory_order_relaxed);
+	while (shard) {
+		Shard *next = shard->next_shard;
+		// Whatever the thread pushed before exiting is visible once its exit is.
+		if (shard->owner_lifetime->exited.load(std::memory_order_acquire) && !_peek(shard)) {
+			if (prev) {
+				prev->next_shard = next;
+			} else {
+				shards.store(next, std::memory_order_release);
+			}
+			_free_shard(shard);
+		} else {
+			prev = shard;
+		}
+		shard = next;
+	}
+}
+
+CallQueue::Page *CallQueue::_alloc_page() {
+	// Several threads may need a page at once, so the limit is checked and taken in one step.
+	uint32_t allocated = pages_allocated.load(std::memory_order_relaxed);
+	do {
+		if (allocated >= max_pages) {
+			return nullptr;
+		}
+	} while (!pages_allocated.compare_exchange_weak(allocated, allocated + 1, std::memory_order_relaxed));
+	return allocator->alloc();
+}
+
+uint8_t *CallQueue::_reserve(Shard *p_shard, uint32_t p_room_needed) {
+	if (unlikely(p_shard->write_offset + p_room_needed > uint32_t(PAGE_SIZE_BYTES))) {
+		if (!p_shard->free_pages) {
+			p_shard->free_pages = p_shard->returned_pages.exchange(nullptr, std::memory_order_acquire);
+		}
+
+		Page *page = p_shard->free_pages;
+		if (page) {
+			p_shard->free_pages = page->next.load(std::memory_order_relaxed);
+			page->committed.store(0, std::memory_order_relaxed);
+			page->next.store(nullptr, std::memory_order_relaxed);
+		} else {
+			page = _alloc_page();
+			if (!page) {
+				return nullptr;
+			}
+		}
+
+		// Everything on the current page is published, so the reader can move past it.
+		p_shard->write_page->next.store(page, std::memory_order_release);
+		p_shard->write_page = page;
+		p_shard->write_offset = 0;
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	return &p_shard->write_page->data[p_shard->write_offset];
+}
+
+void CallQueue::_publish(Shard *p_shard, Message *p_message, uint32_t p_room_needed) {
+	p_message->sequence = next_sequence.fetch_add(1, std::memory_order_acq_rel);
+	p_shard->write_offset += p_room_needed;
+	p_shard->write_page->committed.store(p_shard->write_offset, std::memory_order_release);
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,24 +201,16 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Shard *shard = _get_shard();
+	uint8_t *buffer_end = _reserve(shard, room_needed);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -126,37 +231,27 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_publish(shard, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	Shard *shard = _get_shard();
+	uint8_t *buffer_end = _reserve(shard, room_needed);
+	if (unlikely(!buffer_end)) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -167,32 +262,24 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_publish(shard, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
+	CHECK_THREAD_OVERRIDE;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Shard *shard = _get_shard();
+	uint8_t *buffer_end = _reserve(shard, room_needed);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -200,8 +287,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_publish(shard, msg, room_needed);
 
 	return OK;
 }
@@ -223,142 +309,191 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
-Error CallQueue::flush() {
-	LOCK_MUTEX;
+CallQueue::Message *CallQueue::_peek(Shard *p_shard) {
+	while (true) {
+		Page *page = p_shard->read_page;
+		if (p_shard->read_offset < page->committed.load(std::memory_order_acquire)) {
+			return (Message *)&page->data[p_shard->read_offset];
+		}
 
-	if (pages.is_empty()) {
-		// Never allocated
-		UNLOCK_MUTEX;
-		return OK; // Do nothing.
-	}
+		Page *next = page->next.load(std::memory_order_acquire);
+		if (!next) {
+			return nullptr;
+		}
+		if (p_shard->read_offset < page->committed.load(std::memory_order_acquire)) {
+			continue; // Published right before the writer moved to the next page.
+		}
+
+		p_shard->read_page = next;
+		p_shard->read_offset = 0;
 
-	if (flushing) {
-		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		// Hand the consumed page back to the writer.
+		Page *head = p_shard->returned_pages.load(std::memory_order_relaxed);
+		do {
+			page->next.store(head, std::memory_order_relaxed);
+		} while (!p_shard->returned_pages.compare_exchange_weak(head, page, std::memory_order_release, std::memory_order_relaxed));
 	}
+}
+
+CallQueue::Message *CallQueue::_next_message(Shard *&r_current) {
+	uint64_t expected = flushed_sequence.load(std::memory_order_relaxed);
+
+	while (true) {
+		// Deferred calls tend to come in long runs from the same thread, try that one first.
+		if (r_current) {
+			Message *message = _peek(r_current);
+			if (message && message->sequence == expected) {
+				return message;
+			}
+		}
+
+		for (Shard *shard = shards.load(std::memory_order_acquire); shard; shard = shard->next_shard) {
+			if (shard == r_current) {
+				continue;
+			}
+			Message *message = _peek(shard);
+			if (message && message->sequence == expected) {
+				r_current = shard;
+				return message;
+			}
+		}
+
+		if (next_sequence.load(std::memory_order_acquire) == expected) {
+			return nullptr;
+		}
 
-	flushing = true;
+		// Another thread took the ticket but is still writing the message.
+#ifdef THREADS_ENABLED
+		Thread::yield();
+#endif
+	}
+}
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	p_message->~Message();
+}
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+void CallQueue::_consume(bool p_call) {
+	Shard *shard = nullptr;
 
-		Message *message = (Message *)&page->data[offset];
+	while (Message *message = _next_message(shard)) {
+		uint64_t sequence = message->sequence;
 
 		uint32_t advance = sizeof(Message);
 		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
 			advance += sizeof(Variant) * message->args;
 		}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
-
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+		if (p_call && sequence >= discard_sequence.load(std::memory_order_acquire)) {
+			Object *target = message->callable.get_object();
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
 			}
 		}
 
-		message->~Message();
+		_destroy_message(message);
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
+		// Only advance once the message is gone, so its page can't be recycled while in use.
+		shard->read_offset += advance;
+		flushed_sequence.store(sequence + 1, std::memory_order_release);
 	}
+}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+Error CallQueue::flush() {
+	CHECK_THREAD_OVERRIDE;
 
-	flushing = false;
-	UNLOCK_MUTEX;
-	return OK;
-}
+	{
+		MutexLock lock(mutex);
 
-void CallQueue::clear() {
-	LOCK_MUTEX;
+		if (!shards.load(std::memory_order_relaxed)) {
+			// Never allocated
+			return OK; // Do nothing.
+		}
 
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
+		if (flushing) {
+			return ERR_BUSY;
+		}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+		flushing = true;
+	}
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+	// Calls can push to this queue again, those run in this same flush.
+	_consume(true);
 
-			Message *message = (Message *)&page->data[offset];
+	MutexLock lock(mutex);
+	_free_exited_shards();
+	flushing = false;
+	return OK;
+}
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+void CallQueue::clear() {
+	CHECK_THREAD_OVERRIDE;
 
-			offset += advance;
+	{
+		MutexLock lock(mutex);
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+		if (!shards.load(std::memory_order_relaxed)) {
+			return; // Nothing to clear.
+		}
 
-			message->~Message();
+		if (flushing) {
+			// Let the ongoing flush drop everything queued so far.
+			discard_sequence.store(next_sequence.load(std::memory_order_acquire), std::memory_order_release);
+			return;
 		}
+
+		flushing = true;
 	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
+	_consume(false);
 
-	UNLOCK_MUTEX;
+	MutexLock lock(mutex);
+	_free_exited_shards();
+	flushing = false;
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
+	MutexLock lock(mutex);
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
+	// Pages can't be inspected while another flush is reading them.
+	for (Shard *shard = flushing ? nullptr : shards.load(std::memory_order_acquire); shard; shard = shard->next_shard) {
+		Page *page = shard->read_page;
+		uint32_t offset = shard->read_offset;
+		while (page) {
+			uint32_t committed = page->committed.load(std::memory_order_acquire);
+			if (offset >= committed) {
+				page = page->next.load(std::memory_order_acquire);
+				offset = 0;
+				continue;
+			}
 
 			Message *message = (Message *)&page->data[offset];
 
@@ -411,19 +546,11 @@ void CallQueue::statistics() {
 			}
 
 			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	uint32_t total_pages = pages_allocated.load(std::memory_order_relaxed);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", total_pages, total_pages * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -437,8 +564,6 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
@@ -446,18 +571,11 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	return next_sequence.load(std::memory_order_acquire) != flushed_sequence.load(std::memory_order_acquire);
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return pages_allocated.load(std::memory_order_relaxed) * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -468,6 +586,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator = memnew(Allocator(16)); // 16 elements per allocator page, 64kb per allocator page. Anything small will do, though.
 		allocator_is_custom = false;
 	}
+	queue_id = last_queue_id.increment();
 	max_pages = p_max_pages;
 	error_text = p_error_text;
 }
@@ -475,8 +594,11 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	Shard *shard = shards.load(std::memory_order_acquire);
+	while (shard) {
+		Shard *next_shard = shard->next_shard;
+		_free_shard(shard);
+		shard = next_shard;
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
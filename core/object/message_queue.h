@@ -31,13 +31,18 @@
 #pragma once
 
 #include "core/object/object_id.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
-#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
 
+// Deferred calls are appended to per-thread shards, so pushing from several
+// threads never contends on a lock. Each message takes a ticket from a
+// queue-wide counter when it is published, and flush() replays the shards
+// merged by ticket, which keeps the order identical to a single shared queue.
 class CallQueue {
 	friend class MessageQueue;
 
@@ -47,7 +52,10 @@ public:
 	};
 
 	struct Page {
-		uint8_t data[PAGE_SIZE_BYTES];
+		// Bytes published by the owning thread. Final once `next` is set.
+		std::atomic<uint32_t> committed = { 0 };
+		std::atomic<Page *> next = { nullptr };
+		alignas(8) uint8_t data[PAGE_SIZE_BYTES];
 	};
 
 	// Needs to be public to be able to define it outside the class.
@@ -65,15 +73,64 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	enum {
+		SHARD_CACHE_SIZE = 8, // Must be a power of two.
+	};
+
+	// Shared by a thread and the shards it registered, so flushes can tell the thread has exited.
+	struct ThreadLifetime {
+		SafeRefCount refcount;
+		std::atomic<bool> exited = { false };
+	};
+
+	struct ThreadLifetimeHolder {
+		ThreadLifetime *lifetime = nullptr;
+		~ThreadLifetimeHolder();
+	};
+
+	// Pages written by a single thread. Only that thread touches the write side,
+	// and only the thread currently flushing touches the read side.
+	struct Shard {
+		Shard *next_shard = nullptr;
+		Thread::ID owner = Thread::UNASSIGNED_ID;
+		ThreadLifetime *owner_lifetime = nullptr;
+
+		Page *write_page = nullptr;
+		uint32_t write_offset = 0;
+		Page *free_pages = nullptr; // Recycled pages ready for the writer.
+
+		Page *read_page = nullptr;
+		uint32_t read_offset = 0;
+
+		// Pages handed back by the reader. The writer takes the whole list at once.
+		std::atomic<Page *> returned_pages = { nullptr };
+	};
+
+	struct ShardCache {
+		uint64_t queue_ids[SHARD_CACHE_SIZE];
+		Shard *shards[SHARD_CACHE_SIZE];
+	};
+
+	static SafeNumeric<uint64_t> last_queue_id;
+	static thread_local ShardCache shard_cache;
+	static thread_local ThreadLifetimeHolder thread_lifetime;
+
+	// Protects shard registration and the flushing state, not the pushes.
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	uint64_t queue_id = 0;
+	std::atomic<Shard *> shards = { nullptr };
+	std::atomic<uint32_t> pages_allocated = { 0 };
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+
+	// Tickets handed out to published messages, and tickets already consumed.
+	std::atomic<uint64_t> next_sequence = { 0 };
+	std::atomic<uint64_t> flushed_sequence = { 0 };
+	// Messages with a lower ticket are destroyed without being called.
+	std::atomic<uint64_t> discard_sequence = { 0 };
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -82,6 +139,7 @@ private:
 
 	struct Message {
 		Callable callable;
+		uint64_t sequence;
 		int16_t type;
 		union {
 			int16_t notification;
@@ -89,15 +147,28 @@ private:
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	_FORCE_INLINE_ Shard *_get_shard() {
+		uint32_t slot = queue_id & (SHARD_CACHE_SIZE - 1);
+		if (likely(shard_cache.queue_ids[slot] == queue_id)) {
+			return shard_cache.shards[slot];
 		}
+		return _register_shard();
 	}
 
-	void _add_page();
+	static ThreadLifetime *_get_thread_lifetime();
+	static void _unref_thread_lifetime(ThreadLifetime *p_lifetime);
+
+	Shard *_register_shard();
+	void _free_shard(Shard *p_shard);
+	void _free_exited_shards();
+	Page *_alloc_page();
+	uint8_t *_reserve(Shard *p_shard, uint32_t p_room_needed);
+	void _publish(Shard *p_shard, Message *p_message, uint32_t p_room_needed);
+
+	Message *_peek(Shard *p_shard);
+	Message *_next_message(Shard *&r_current);
+	void _consume(bool p_call);
+	void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -72,15 +72,22 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		prev_task = curr_thread.current_task;
-		curr_thread.current_task = p_task;
-		curr_thread.has_pump_task = p_task->is_pump_task;
-		if (p_task->pending_notify_yield_over) {
-			curr_thread.yield_is_over = true;
+		if (p_task->group) {
+			// Group tasks can't be awaited individually nor be notified about yields,
+			// so there's no bookkeeping other threads need to see here.
+			prev_task = curr_thread.current_task.load(std::memory_order_relaxed);
+			curr_thread.current_task.store(p_task, std::memory_order_relaxed);
+		} else {
+			task_mutex.lock();
+			p_task->pool_thread_index = pool_thread_index;
+			prev_task = curr_thread.current_task.load(std::memory_order_relaxed);
+			curr_thread.current_task.store(p_task, std::memory_order_relaxed);
+			curr_thread.has_pump_task = p_task->is_pump_task;
+			if (p_task->pending_notify_yield_over) {
+				curr_thread.yield_is_over = true;
+			}
+			task_mutex.unlock();
 		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -88,14 +95,17 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	Memory::TagScope memory_tag(p_task->memory_tag);
+
 	if (p_task->group) {
 		// Handling a group
+		Group *group = p_task->group;
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			uint32_t work_index = group->index.postincrement();
 
-			if (work_index >= p_task->group->max) {
+			if (work_index >= group->max) {
 				break;
 			}
 			if (p_task->native_group_func) {
@@ -107,9 +117,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = group->completed_index.increment();
 
-			if (completed_amount == p_task->group->max) {
+			if (completed_amount == group->max) {
 				do_post = true;
 			}
 		}
@@ -119,22 +129,38 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->completed.set_to(true);
 		}
-		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
-		uint32_t finished_users = p_task->group->finished.increment();
+		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
+
+#ifdef THREADS_ENABLED
+		// The task may be freed along with the group as soon as it's marked as finished,
+		// so stop exposing it as the current one first.
+		curr_thread.current_task.store(prev_task, std::memory_order_relaxed);
+#endif
+
+		uint32_t finished_users = group->finished.increment();
 
 		if (finished_users == max_users) {
-			// Get rid of the group, because nobody else is using it.
+			// Get rid of the group (and its tasks), because nobody else is using it.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(p_task->group);
+			_free_group(group);
 		}
 
-		// For groups, tasks get rid of themselves.
+#ifdef THREADS_ENABLED
+		// High priority group tasks are the common case, and they don't need the lock at all anymore.
+		if (low_priority) {
+			MutexLock task_lock(task_mutex);
+			low_priority_threads_used--;
 
-		task_mutex.lock();
-		task_allocator.free(p_task);
+			if (_try_promote_low_priority_task()) {
+				if (prev_task) { // Otherwise, this thread will catch it.
+					_notify_threads(&curr_thread, 1, 0);
+				}
+			}
+		}
+#endif
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -158,11 +184,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
-	}
 
 #ifdef THREADS_ENABLED
-	{
-		curr_thread.current_task = prev_task;
+		curr_thread.current_task.store(prev_task, std::memory_order_relaxed);
 		if (low_priority) {
 			low_priority_threads_used--;
 
@@ -172,22 +196,67 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				}
 			}
 		}
+#endif
 
 		task_mutex.unlock();
 	}
 
+#ifdef THREADS_ENABLED
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_local_task(ThreadData *p_thread_data) {
+	// Own tasks first, newest to oldest, since they are the most likely to be hot in cache.
+	Task *task = p_thread_data->local_queue.pop();
+	if (task) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		uint32_t victim_index = (p_thread_data->index + p_thread_data->steal_index + i) % thread_count;
+		if (victim_index == p_thread_data->index) {
+			continue;
+		}
+		task = threads[victim_index].local_queue.steal();
+		if (task) {
+			p_thread_data->steal_index++; // Spread thieves across victims over time.
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkerThreadPool::_free_group(Group *p_group) {
+	Task *task = p_group->task_list;
+	while (task) {
+		Task *next = task->group_next;
+		task_allocator.free(task);
+		task = next;
+	}
+	group_allocator.free(p_group);
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: take work from the local queues without touching the task mutex.
+		Task *task_to_process = thread_data->pool->_pop_or_steal_local_task(thread_data);
+
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -200,17 +269,23 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				// Local queues are pushed to with the lock held, so checking them again here
+				// guarantees no notification is missed before going to sleep.
+				task_to_process = thread_data->pool->_pop_or_steal_local_task(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -246,7 +321,11 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread && p_tasks[i]->group && caller_pool_thread->local_queue.push(p_tasks[i])) {
+			// Group tasks fanned out from a pool thread stay local, so they can be
+			// taken back or stolen by other threads without going through the mutex.
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -286,9 +365,10 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		Task *th_current_task = th.current_task.load(std::memory_order_relaxed);
+		if (th_current_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			if (to_promote && th.awaited_task && th_current_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -355,6 +435,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
 	task->is_pump_task = p_pump_task;
+	task->memory_tag = Memory::get_current_tag();
 	tasks.insert(id, task);
 
 #ifdef THREADS_ENABLED
@@ -429,7 +510,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load(std::memory_order_relaxed)->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -498,6 +579,8 @@ void WorkerThreadPool::_unlock_unlockable_mutexes() {
 void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task) {
 	// Keep processing tasks until the condition to stop waiting is met.
 
+	const Task *caller_task = p_caller_pool_thread->current_task.load(std::memory_order_relaxed);
+
 	while (true) {
 		Task *task_to_process = nullptr;
 		bool relock_unlockables = false;
@@ -528,8 +611,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
-					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
+					uint32_t to_promote = caller_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
 						p_caller_pool_thread->signaled = true;
@@ -540,7 +623,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				break;
 			}
 
-			if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
+			if (caller_task->low_priority && low_priority_task_queue.first()) {
 				if (_try_promote_low_priority_task()) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				}
@@ -554,6 +637,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				} else {
 					task_queue.remove(task_queue.first());
 				}
+			} else {
+				task_to_process = _pop_or_steal_local_task(p_caller_pool_thread);
 			}
 
 			if (!task_to_process) {
@@ -599,7 +684,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -689,6 +774,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	} else {
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+		const Memory::Tag memory_tag = Memory::get_current_tag();
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
 			task->native_group_func = p_func;
@@ -697,6 +783,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->memory_tag = memory_tag;
+			task->group_next = group->task_list;
+			group->task_list = task;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -746,6 +835,31 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	{
 		Group *group = *groupp;
 
+		int th_index = get_thread_index();
+		if (th_index != -1) {
+			// A pool thread waiting for a group it created has the group's tasks at the bottom
+			// of its local queue. Instead of just blocking, take them back and run them here.
+			ThreadData &td = threads[th_index];
+			while (!group->completed.is_set()) {
+				Task *task = td.local_queue.pop();
+				if (!task) {
+					break;
+				}
+				if (task->group != group) {
+					// Belongs to some outer work, which must not be run from here.
+					// Pushed back with the lock held, like any other local push, so a thread
+					// about to sleep can't miss it. It may have gone to sleep while the task
+					// was out of the queue, so let one know it's available again.
+					MutexLock task_lock(task_mutex);
+					[[maybe_unused]] bool pushed_back = td.local_queue.push(task);
+					DEV_ASSERT(pushed_back);
+					_notify_threads(&td, 1, 0);
+					break;
+				}
+				_process_task(task);
+			}
+		}
+
 		if (this == singleton) {
 			_unlock_unlockable_mutexes();
 		}
@@ -760,7 +874,7 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(group);
+			_free_group(group);
 		}
 	}
 
@@ -776,8 +890,9 @@ int WorkerThreadPool::get_thread_index() const {
 
 WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task) {
-		return threads[th_index].current_task->self;
+	const Task *current_task = th_index != -1 ? threads[th_index].current_task.load(std::memory_order_relaxed) : nullptr;
+	if (current_task) {
+		return current_task->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -785,8 +900,9 @@ WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 
 WorkerThreadPool::GroupID WorkerThreadPool::get_caller_group_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task && threads[th_index].current_task->group) {
-		return threads[th_index].current_task->group->self;
+	const Task *current_task = th_index != -1 ? threads[th_index].current_task.load(std::memory_order_relaxed) : nullptr;
+	if (current_task && current_task->group) {
+		return current_task->group->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -68,6 +69,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		Task *task_list = nullptr; // Group tasks are freed together with their group.
 	};
 
 	struct Task {
@@ -86,8 +88,10 @@ private:
 		uint32_t waiting_pool = 0;
 		uint32_t waiting_user = 0;
 		bool low_priority = false;
+		Memory::Tag memory_tag = Memory::TAG_UNTAGGED; // Of the submitting thread, the task allocates on its behalf.
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		Task *group_next = nullptr;
 
 		void free_template_userdata();
 		Task() :
@@ -99,6 +103,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_CAPACITY = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -118,10 +123,14 @@ private:
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
 		bool has_pump_task : 1; // Threads can only have one pump task.
-		Task *current_task = nullptr;
+		// Written without the task mutex when running group tasks, but only ever read by other threads with it held.
+		std::atomic<Task *> current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		uint32_t steal_index = 0; // Only used by the owner thread, for rotating across victims.
+		// High-priority group tasks posted from this thread. Other threads steal from it.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_CAPACITY> local_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -176,6 +185,9 @@ private:
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	Task *_pop_or_steal_local_task(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
+	void _free_group(Group *p_group);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
@@ -216,6 +228,63 @@ private:
 		}
 	};
 
+	// Shared by the parallel_* helpers. Chunks are claimed dynamically by the pool threads
+	// and by the calling thread itself, which therefore doesn't sit idle while waiting.
+	template <typename F>
+	struct ParallelChunks {
+		const F *func = nullptr;
+		uint32_t chunk_count = 0;
+		SafeNumeric<uint32_t> next_chunk;
+
+		void run() {
+			for (uint32_t chunk = next_chunk.postincrement(); chunk < chunk_count; chunk = next_chunk.postincrement()) {
+				(*func)(chunk);
+			}
+		}
+
+		static void run_native(void *p_userdata, uint32_t p_index) {
+			((ParallelChunks *)p_userdata)->run();
+		}
+	};
+
+	static const uint32_t PARALLEL_CHUNKS_PER_RUNNER = 4; // For adaptive grains, so runners finishing early can pick up more work.
+
+	_FORCE_INLINE_ uint32_t _get_parallel_runner_count() const {
+#ifdef THREADS_ENABLED
+		return threads.size() + 1; // Calling thread included.
+#else
+		return 1;
+#endif
+	}
+
+	_FORCE_INLINE_ uint32_t _get_parallel_grain(uint32_t p_count, uint32_t p_grain) const {
+		if (p_grain > 0) {
+			return p_grain;
+		}
+		return MAX(1u, p_count / (_get_parallel_runner_count() * PARALLEL_CHUNKS_PER_RUNNER));
+	}
+
+	template <typename F>
+	void _parallel_chunks(uint32_t p_chunk_count, const String &p_description, const F &p_func) {
+		uint32_t runners = MIN(p_chunk_count, _get_parallel_runner_count());
+		if (runners <= 1) {
+			// Not worth going through the pool.
+			for (uint32_t chunk = 0; chunk < p_chunk_count; chunk++) {
+				p_func(chunk);
+			}
+			return;
+		}
+
+		ParallelChunks<F> data;
+		data.func = &p_func;
+		data.chunk_count = p_chunk_count;
+		// If called from a pool thread, the group goes to its local queue, and waiting takes
+		// unstarted tasks back, so nesting these helpers can't starve the pool.
+		GroupID group = add_native_group_task(&ParallelChunks<F>::run_native, &data, runners - 1, runners - 1, true, p_description);
+		data.run();
+		wait_for_group_task_completion(group);
+	}
+
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
 
 	void _switch_runlevel(Runlevel p_runlevel);
@@ -266,6 +335,107 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Fork-join helpers. They block until done, but the calling thread takes part in the work.
+	// Ranges are split in chunks of p_grain elements; pass 0 to derive it from the range size and thread count.
+	// Ranges fitting in a single chunk are run inline on the calling thread.
+
+	// Calls p_func(uint32_t p_from, uint32_t p_to) for every chunk of [p_begin, p_end).
+	template <typename F>
+	void parallel_for(uint32_t p_begin, uint32_t p_end, uint32_t p_grain, const F &p_func, const String &p_description = String()) {
+		if (p_end <= p_begin) {
+			return;
+		}
+		uint32_t count = p_end - p_begin;
+		uint32_t grain = _get_parallel_grain(count, p_grain);
+		uint32_t chunk_count = (count + grain - 1) / grain;
+		_parallel_chunks(chunk_count, p_description, [&](uint32_t p_chunk) {
+			uint32_t from = p_begin + p_chunk * grain;
+			p_func(from, MIN(from + grain, p_end));
+		});
+	}
+
+	// Splits [p_begin, p_end) in r_scratch.size() contiguous parts and calls p_func(uint32_t p_from, uint32_t p_to, T &r_scratch)
+	// for each one, with its own element of r_scratch. Sizing it to get_thread_count() gives per-thread scratch storage,
+	// and since parts follow the range order, the results can be merged deterministically afterwards.
+	template <typename T, typename F>
+	void parallel_for_with_scratch(uint32_t p_begin, uint32_t p_end, LocalVector<T> &r_scratch, const F &p_func, const String &p_description = String()) {
+		if (p_end <= p_begin || r_scratch.is_empty()) {
+			return;
+		}
+		uint64_t count = p_end - p_begin;
+		uint32_t parts = r_scratch.size();
+		_parallel_chunks(parts, p_description, [&](uint32_t p_part) {
+			uint32_t from = p_begin + uint32_t(p_part * count / parts);
+			uint32_t to = p_begin + uint32_t((p_part + 1) * count / parts);
+			if (from < to) {
+				p_func(from, to, r_scratch[p_part]);
+			}
+		});
+	}
+
+	// Calls p_func(uint32_t p_from, uint32_t p_to, T &r_value) to accumulate every chunk into a partial value
+	// starting at p_identity, then folds the partials in range order with p_reduce(const T &, const T &) -> T.
+	// The result only depends on the chunking, so pass a fixed grain if it must be reproducible across machines.
+	template <typename T, typename F, typename R>
+	T parallel_reduce(uint32_t p_begin, uint32_t p_end, uint32_t p_grain, const T &p_identity, const F &p_func, const R &p_reduce, const String &p_description = String()) {
+		if (p_end <= p_begin) {
+			return p_identity;
+		}
+		uint32_t count = p_end - p_begin;
+		uint32_t grain = _get_parallel_grain(count, p_grain);
+		uint32_t chunk_count = (count + grain - 1) / grain;
+
+		LocalVector<T> partials;
+		partials.resize(chunk_count);
+		_parallel_chunks(chunk_count, p_description, [&](uint32_t p_chunk) {
+			uint32_t from = p_begin + p_chunk * grain;
+			partials[p_chunk] = p_identity;
+			p_func(from, MIN(from + grain, p_end), partials[p_chunk]);
+		});
+
+		T result = p_identity;
+		for (const T &partial : partials) {
+			result = p_reduce(result, partial);
+		}
+		return result;
+	}
+
+	// Parallel prefix scan in two passes. First, p_func(uint32_t p_from, uint32_t p_to, T &r_value) accumulates every chunk
+	// like in parallel_reduce(). Then, p_scan(uint32_t p_from, uint32_t p_to, const T &p_prefix) is called for every chunk
+	// with the reduction of all the elements before it. Returns the reduction of the whole range.
+	template <typename T, typename F, typename R, typename S>
+	T parallel_scan(uint32_t p_begin, uint32_t p_end, uint32_t p_grain, const T &p_identity, const F &p_func, const R &p_reduce, const S &p_scan, const String &p_description = String()) {
+		if (p_end <= p_begin) {
+			return p_identity;
+		}
+		uint32_t count = p_end - p_begin;
+		uint32_t grain = _get_parallel_grain(count, p_grain);
+		uint32_t chunk_count = (count + grain - 1) / grain;
+
+		LocalVector<T> prefixes;
+		prefixes.resize(chunk_count);
+		_parallel_chunks(chunk_count, p_description, [&](uint32_t p_chunk) {
+			uint32_t from = p_begin + p_chunk * grain;
+			prefixes[p_chunk] = p_identity;
+			p_func(from, MIN(from + grain, p_end), prefixes[p_chunk]);
+		});
+
+		// Turn chunk totals into exclusive prefixes.
+		T total = p_identity;
+		for (T &prefix : prefixes) {
+			T chunk_total = prefix;
+			prefix = total;
+			total = p_reduce(total, chunk_total);
+		}
+
+		_parallel_chunks(chunk_count, p_description, [&](uint32_t p_chunk) {
+			uint32_t from = p_begin + p_chunk * grain;
+			p_scan(from, MIN(from + grain, p_end), prefixes[p_chunk]);
+		});
+
+		return total;
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
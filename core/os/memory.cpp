@@ -30,10 +30,18 @@
 
 #include "memory.h"
 
+#include "core/os/slab_allocator.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
 
+#if defined(MEMORY_TAGS_ENABLED) && (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#define MEMORY_BACKTRACE_ENABLED
+#endif
+
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
 }
@@ -56,9 +64,66 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_TAGS_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::alloc_count;
+
+thread_local Memory::Tag Memory::current_tag = Memory::TAG_UNTAGGED;
+
+namespace {
+
+// Each tag is hammered by different threads, keep them on their own cache line.
+struct alignas(Thread::CACHE_LINE_BYTES) TagStats {
+	SafeNumeric<uint64_t> usage;
+	SafeNumeric<uint64_t> max_usage;
+	SafeNumeric<uint64_t> alloc_count;
+};
+
+TagStats tag_stats[Memory::TAG_MAX];
+
+SafeNumeric<uint64_t> large_alloc_threshold;
+SafeNumeric<uint32_t> large_alloc_interval;
+SafeNumeric<uint32_t> large_alloc_counter;
+
+SpinLock large_alloc_samples_lock;
+Memory::LargeAllocSample large_alloc_samples[Memory::MAX_LARGE_ALLOC_SAMPLES];
+uint32_t large_alloc_sample_count = 0; // Total ever recorded, the ring position is derived from it.
+
+void _add_usage(Memory::Tag p_tag, uint64_t p_bytes) {
+	TagStats &stats = tag_stats[p_tag];
+	stats.max_usage.exchange_if_greater(stats.usage.add(p_bytes));
+}
+
+void _record_large_alloc(Memory::Tag p_tag, uint64_t p_bytes) {
+	uint64_t threshold = large_alloc_threshold.get();
+	if (likely(threshold == 0 || p_bytes < threshold)) {
+		return;
+	}
+	if (large_alloc_counter.postincrement() % large_alloc_interval.get() != 0) {
+		return;
+	}
+
+	Memory::LargeAllocSample sample;
+	sample.bytes = p_bytes;
+	sample.tag = p_tag;
+#ifdef MEMORY_BACKTRACE_ENABLED
+	void *frames[Memory::LargeAllocSample::MAX_FRAMES + 2];
+	// Skip this function and the Memory entry point.
+	int frame_count = backtrace(frames, Memory::LargeAllocSample::MAX_FRAMES + 2) - 2;
+	for (int i = 0; i < frame_count; i++) {
+		sample.frames[i] = frames[i + 2];
+	}
+	sample.frame_count = MAX(frame_count, 0);
+#endif
+
+	large_alloc_samples_lock.lock();
+	large_alloc_samples[large_alloc_sample_count % Memory::MAX_LARGE_ALLOC_SAMPLES] = sample;
+	large_alloc_sample_count++;
+	large_alloc_samples_lock.unlock();
+}
+
+} // namespace
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -93,37 +158,73 @@ void Memory::free_aligned_static(void *p_memory) {
 	free(p);
 }
 
-template <bool p_ensure_zero>
-void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
+// Blocks need a header when it is used to account for them, or to know which allocator they come from.
+#if defined(MEMORY_TAGS_ENABLED) || defined(SLAB_ALLOCATOR_ENABLED)
+static constexpr bool ALWAYS_PREPAD = true;
 #else
-	bool prepad = p_pad_align;
+static constexpr bool ALWAYS_PREPAD = false;
 #endif
 
-	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+// Allocates a block with room for the header, sets r_flags to SLAB_FLAG when it comes from the slab allocator.
+static _FORCE_INLINE_ uint8_t *_alloc_block(size_t p_bytes, bool p_ensure_zero, uint64_t &r_flags) {
+	const size_t total = p_bytes + Memory::DATA_OFFSET;
+#ifdef SLAB_ALLOCATOR_ENABLED
+	if (total <= SlabAllocator::MAX_BLOCK_SIZE && SlabAllocator::is_enabled()) {
+		uint8_t *block = (uint8_t *)SlabAllocator::alloc(SlabAllocator::get_size_class(total));
+		if (likely(block)) {
+			if (p_ensure_zero) {
+				memset(block + Memory::DATA_OFFSET, 0, p_bytes);
+			}
+			r_flags = Memory::SLAB_FLAG;
+			return block;
+		}
 	}
+#endif
+	r_flags = 0;
+	return (uint8_t *)(p_ensure_zero ? calloc(1, total) : malloc(total));
+}
 
-	ERR_FAIL_NULL_V(mem, nullptr);
-
-	if (prepad) {
-		uint8_t *s8 = (uint8_t *)mem;
+static _FORCE_INLINE_ void _free_block(uint8_t *p_block, uint64_t p_header) {
+#ifdef SLAB_ALLOCATOR_ENABLED
+	if (p_header & Memory::SLAB_FLAG) {
+		SlabAllocator::free(p_block, SlabAllocator::get_size_class((p_header & Memory::SIZE_MASK) + Memory::DATA_OFFSET));
+		return;
+	}
+#endif
+	free(p_block);
+}
 
-		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
+template <bool p_ensure_zero>
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	bool prepad = ALWAYS_PREPAD || p_pad_align;
 
-#ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
-#endif
-		return s8 + DATA_OFFSET;
-	} else {
+	if (!prepad) {
+		void *mem = p_ensure_zero ? calloc(1, p_bytes) : malloc(p_bytes);
+		ERR_FAIL_NULL_V(mem, nullptr);
 		return mem;
 	}
+
+	uint64_t flags;
+	uint8_t *s8 = _alloc_block(p_bytes, p_ensure_zero, flags);
+	ERR_FAIL_NULL_V(s8, nullptr);
+
+	uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
+
+#ifdef MEMORY_TAGS_ENABLED
+	Tag tag = current_tag;
+	*s = p_bytes | flags | (uint64_t(tag) << TAG_SHIFT);
+
+	uint64_t new_mem_usage = mem_usage.add(p_bytes);
+	max_usage.exchange_if_greater(new_mem_usage);
+	alloc_count.increment();
+
+	_add_usage(tag, p_bytes);
+	tag_stats[tag].alloc_count.increment();
+	_record_large_alloc(tag, p_bytes);
+#else
+	*s = p_bytes | flags;
+#endif
+	return s8 + DATA_OFFSET;
 }
 
 template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
@@ -136,40 +237,69 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
-#endif
+	bool prepad = ALWAYS_PREPAD || p_pad_align;
 
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-
-#ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		const uint64_t header = *s;
+		[[maybe_unused]] const uint64_t prev_bytes = header & SIZE_MASK;
+
+#ifdef MEMORY_TAGS_ENABLED
+		// Reallocations stay with the tag the block was first allocated with.
+		Tag tag = Tag(header >> TAG_SHIFT);
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - prev_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
+			_add_usage(tag, p_bytes - prev_bytes);
+			_record_large_alloc(tag, p_bytes);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(prev_bytes - p_bytes);
+			tag_stats[tag].usage.sub(prev_bytes - p_bytes);
 		}
+		if (p_bytes != 0) {
+			alloc_count.increment();
+			tag_stats[tag].alloc_count.increment();
+		}
+		const uint64_t tag_bits = uint64_t(tag) << TAG_SHIFT;
+#else
+		const uint64_t tag_bits = 0;
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_block(mem, header);
 			return nullptr;
-		} else {
-			*s = p_bytes;
+		}
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
-			ERR_FAIL_NULL_V(mem, nullptr);
+#ifdef SLAB_ALLOCATOR_ENABLED
+		if (header & SLAB_FLAG) {
+			const size_t total = p_bytes + DATA_OFFSET;
+			if (total <= SlabAllocator::MAX_BLOCK_SIZE && SlabAllocator::get_size_class(total) == SlabAllocator::get_size_class(prev_bytes + DATA_OFFSET)) {
+				*s = p_bytes | SLAB_FLAG | tag_bits;
+				return mem + DATA_OFFSET;
+			}
+
+			// Moving to another size class, or out of the slabs. The element count is kept along with the data.
+			uint64_t flags;
+			uint8_t *new_mem = _alloc_block(p_bytes, false, flags);
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+			memcpy(new_mem + ELEMENT_OFFSET, mem + ELEMENT_OFFSET, DATA_OFFSET - ELEMENT_OFFSET + MIN(prev_bytes, (uint64_t)p_bytes));
+			*(uint64_t *)(new_mem + SIZE_OFFSET) = p_bytes | flags | tag_bits;
+			_free_block(mem, header);
+			return new_mem + DATA_OFFSET;
+		}
+#endif
 
-			s = (uint64_t *)(mem + SIZE_OFFSET);
+		*s = p_bytes | tag_bits;
 
-			*s = p_bytes;
+		mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+		ERR_FAIL_NULL_V(mem, nullptr);
 
-			return mem + DATA_OFFSET;
-		}
+		s = (uint64_t *)(mem + SIZE_OFFSET);
+
+		*s = p_bytes | tag_bits;
+
+		return mem + DATA_OFFSET;
 	} else {
 		mem = (uint8_t *)realloc(mem, p_bytes);
 
@@ -184,21 +314,19 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
-#endif
+	bool prepad = ALWAYS_PREPAD || p_pad_align;
 
 	if (prepad) {
 		mem -= DATA_OFFSET;
+		const uint64_t header = *(uint64_t *)(mem + SIZE_OFFSET);
 
-#ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+#ifdef MEMORY_TAGS_ENABLED
+		const uint64_t bytes = header & SIZE_MASK;
+		mem_usage.sub(bytes);
+		tag_stats[header >> TAG_SHIFT].usage.sub(bytes);
 #endif
 
-		free(mem);
+		_free_block(mem, header);
 	} else {
 		free(mem);
 	}
@@ -209,7 +337,7 @@ uint64_t Memory::get_mem_available() {
 }
 
 uint64_t Memory::get_mem_usage() {
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_TAGS_ENABLED
 	return mem_usage.get();
 #else
 	return 0;
@@ -217,13 +345,82 @@ uint64_t Memory::get_mem_usage() {
 }
 
 uint64_t Memory::get_mem_max_usage() {
-#ifdef DEBUG_ENABLED
+#ifdef MEMORY_TAGS_ENABLED
 	return max_usage.get();
 #else
 	return 0;
 #endif
 }
 
+uint64_t Memory::get_alloc_count() {
+#ifdef MEMORY_TAGS_ENABLED
+	return alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
+const char *Memory::get_tag_name(Tag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"untagged",
+		"rendering",
+		"physics",
+		"script",
+		"resources",
+		"audio",
+	};
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_tag_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].usage.get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_max_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].max_usage.get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_alloc_count(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
+void Memory::set_large_alloc_sampling(uint64_t p_threshold, uint32_t p_interval) {
+#ifdef MEMORY_TAGS_ENABLED
+	large_alloc_interval.set(MAX(p_interval, 1u));
+	large_alloc_threshold.set(p_threshold);
+#endif
+}
+
+int Memory::get_large_alloc_samples(LargeAllocSample *r_samples, int p_max_samples) {
+#ifdef MEMORY_TAGS_ENABLED
+	large_alloc_samples_lock.lock();
+	int count = MIN(MIN((int)large_alloc_sample_count, MAX_LARGE_ALLOC_SAMPLES), p_max_samples);
+	for (int i = 0; i < count; i++) {
+		r_samples[i] = large_alloc_samples[(large_alloc_sample_count - 1 - i) % MAX_LARGE_ALLOC_SAMPLES];
+	}
+	large_alloc_samples_lock.unlock();
+	return count;
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -37,16 +37,32 @@
 #include <type_traits>
 
 class Memory {
-#ifdef DEBUG_ENABLED
+public:
+	// Subsystems allocations are accounted to while a TagScope is active on the allocating thread.
+	enum Tag : uint8_t {
+		TAG_UNTAGGED,
+		TAG_RENDERING,
+		TAG_PHYSICS,
+		TAG_SCRIPT,
+		TAG_RESOURCES,
+		TAG_AUDIO,
+		TAG_MAX,
+	};
+
+private:
+#ifdef MEMORY_TAGS_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> alloc_count;
+
+	static thread_local Tag current_tag;
 #endif
 
 public:
 	// Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ max_align_t
 	//             ┌─────────────────┬──┬────────────────┬──┬───────────...
 	//             │ uint64_t        │░░│ uint64_t       │░░│ T[]
-	//             │ alloc size      │░░│ element count  │░░│ data
+	//             │ tag|flags|size  │░░│ element count  │░░│ data
 	//             └─────────────────┴──┴────────────────┴──┴───────────...
 	// Offset:     ↑ SIZE_OFFSET        ↑ ELEMENT_OFFSET    ↑ DATA_OFFSET
 
@@ -54,6 +70,41 @@ public:
 	static constexpr size_t ELEMENT_OFFSET = ((SIZE_OFFSET + sizeof(uint64_t)) % alignof(uint64_t) == 0) ? (SIZE_OFFSET + sizeof(uint64_t)) : ((SIZE_OFFSET + sizeof(uint64_t)) + alignof(uint64_t) - ((SIZE_OFFSET + sizeof(uint64_t)) % alignof(uint64_t)));
 	static constexpr size_t DATA_OFFSET = ((ELEMENT_OFFSET + sizeof(uint64_t)) % alignof(max_align_t) == 0) ? (ELEMENT_OFFSET + sizeof(uint64_t)) : ((ELEMENT_OFFSET + sizeof(uint64_t)) + alignof(max_align_t) - ((ELEMENT_OFFSET + sizeof(uint64_t)) % alignof(max_align_t)));
 
+	// The tag an allocation was made with is kept in the top bits of its size, so it is freed from the same tag.
+	// Below it, a flag marks blocks that come from the SlabAllocator.
+	static constexpr uint64_t TAG_SHIFT = 56;
+	static constexpr uint64_t SLAB_FLAG = uint64_t(1) << 55;
+	static constexpr uint64_t SIZE_MASK = SLAB_FLAG - 1;
+
+	class TagScope {
+#ifdef MEMORY_TAGS_ENABLED
+		Tag previous_tag;
+
+	public:
+		_FORCE_INLINE_ explicit TagScope(Tag p_tag) {
+			previous_tag = current_tag;
+			current_tag = p_tag;
+		}
+		_FORCE_INLINE_ ~TagScope() {
+			current_tag = previous_tag;
+		}
+#else
+	public:
+		_FORCE_INLINE_ explicit TagScope(Tag p_tag) {}
+#endif
+	};
+
+	struct LargeAllocSample {
+		static constexpr int MAX_FRAMES = 24;
+
+		uint64_t bytes = 0;
+		Tag tag = TAG_UNTAGGED;
+		int frame_count = 0;
+		void *frames[MAX_FRAMES] = {};
+	};
+
+	static constexpr int MAX_LARGE_ALLOC_SAMPLES = 64;
+
 	template <bool p_ensure_zero = false>
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	_FORCE_INLINE_ static void *alloc_static_zeroed(size_t p_bytes, bool p_pad_align = false) { return alloc_static<true>(p_bytes, p_pad_align); }
@@ -87,6 +138,26 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	// Number of allocations and reallocations so far. Only counted with MEMORY_TAGS_ENABLED (debug builds, or `memory_tags=yes`), 0 otherwise.
+	static uint64_t get_alloc_count();
+
+	static const char *get_tag_name(Tag p_tag);
+	_FORCE_INLINE_ static Tag get_current_tag() {
+#ifdef MEMORY_TAGS_ENABLED
+		return current_tag;
+#else
+		return TAG_UNTAGGED;
+#endif
+	}
+	static uint64_t get_tag_usage(Tag p_tag);
+	static uint64_t get_tag_max_usage(Tag p_tag);
+	static uint64_t get_tag_alloc_count(Tag p_tag);
+
+	// Every p_interval-th allocation of at least p_threshold bytes is recorded along with a backtrace,
+	// where the platform can capture one. A threshold of 0 disables sampling.
+	static void set_large_alloc_sampling(uint64_t p_threshold, uint32_t p_interval = 1);
+	// Copies the most recent samples, newest first, and returns how many were copied.
+	static int get_large_alloc_samples(LargeAllocSample *r_samples, int p_max_samples);
 };
 
 class DefaultAllocator {
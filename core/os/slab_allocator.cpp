@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*  slab_allocator.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "slab_allocator.h"
+
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+
+#include <cstdlib>
+
+bool SlabAllocator::enabled = true;
+
+namespace {
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+struct FreeList {
+	FreeBlock *head;
+	uint32_t count;
+};
+
+struct alignas(Thread::CACHE_LINE_BYTES) CentralList {
+	SpinLock lock;
+	FreeList list;
+};
+
+CentralList central_lists[SlabAllocator::CLASS_COUNT];
+SafeNumeric<uint64_t> reserved_bytes;
+
+// Kept trivially destructible, so it stays usable while other thread_local objects are being destroyed.
+struct ThreadCache {
+	FreeList lists[SlabAllocator::CLASS_COUNT];
+	bool exited;
+};
+
+thread_local ThreadCache thread_cache;
+
+// Hands the blocks cached by a thread back to the central lists when it exits.
+struct ThreadCacheReleaser {
+	_FORCE_INLINE_ void ensure_registered() {}
+	~ThreadCacheReleaser();
+};
+
+thread_local ThreadCacheReleaser thread_cache_releaser;
+
+// How many blocks move between a thread cache and the central list at once.
+_FORCE_INLINE_ uint32_t _get_batch_count(uint32_t p_class) {
+	return MAX(8u, uint32_t(4096 / SlabAllocator::get_class_size(p_class)));
+}
+
+void _refill(uint32_t p_class, FreeList &r_list, uint32_t p_count) {
+	CentralList &central = central_lists[p_class];
+
+	central.lock.lock();
+	uint32_t taken = 0;
+	while (taken < p_count && central.list.head) {
+		FreeBlock *block = central.list.head;
+		central.list.head = block->next;
+		block->next = r_list.head;
+		r_list.head = block;
+		taken++;
+	}
+	central.list.count -= taken;
+	central.lock.unlock();
+	r_list.count += taken;
+
+	if (taken == p_count) {
+		return;
+	}
+
+	uint8_t *slab = (uint8_t *)malloc(SlabAllocator::SLAB_SIZE);
+	if (!slab) {
+		return;
+	}
+	reserved_bytes.add(SlabAllocator::SLAB_SIZE);
+
+	const size_t class_size = SlabAllocator::get_class_size(p_class);
+	const uint32_t block_count = SlabAllocator::SLAB_SIZE / class_size;
+	FreeList extra = {};
+	for (uint32_t i = 0; i < block_count; i++) {
+		FreeBlock *block = (FreeBlock *)(slab + i * class_size);
+		FreeList &list = taken < p_count ? r_list : extra;
+		block->next = list.head;
+		list.head = block;
+		list.count++;
+		taken++;
+	}
+
+	if (extra.head) {
+		FreeBlock *tail = extra.head;
+		while (tail->next) {
+			tail = tail->next;
+		}
+		central.lock.lock();
+		tail->next = central.list.head;
+		central.list.head = extra.head;
+		central.list.count += extra.count;
+		central.lock.unlock();
+	}
+}
+
+void _release(uint32_t p_class, FreeList &r_list, uint32_t p_count) {
+	FreeBlock *head = r_list.head;
+	FreeBlock *tail = head;
+	for (uint32_t i = 1; i < p_count; i++) {
+		tail = tail->next;
+	}
+	r_list.head = tail->next;
+	r_list.count -= p_count;
+
+	CentralList &central = central_lists[p_class];
+	central.lock.lock();
+	tail->next = central.list.head;
+	central.list.head = head;
+	central.list.count += p_count;
+	central.lock.unlock();
+}
+
+ThreadCacheReleaser::~ThreadCacheReleaser() {
+	for (uint32_t i = 0; i < SlabAllocator::CLASS_COUNT; i++) {
+		FreeList &list = thread_cache.lists[i];
+		if (list.count) {
+			_release(i, list, list.count);
+		}
+	}
+	// Anything allocated or freed from now on goes straight through the central lists.
+	thread_cache.exited = true;
+}
+
+} // namespace
+
+void *SlabAllocator::alloc(uint32_t p_class) {
+	FreeList &list = thread_cache.lists[p_class];
+	if (unlikely(!list.head)) {
+		if (likely(!thread_cache.exited)) {
+			thread_cache_releaser.ensure_registered();
+			_refill(p_class, list, _get_batch_count(p_class));
+		} else {
+			_refill(p_class, list, 1);
+		}
+		if (unlikely(!list.head)) {
+			return nullptr;
+		}
+	}
+
+	FreeBlock *block = list.head;
+	list.head = block->next;
+	list.count--;
+	return block;
+}
+
+void SlabAllocator::free(void *p_block, uint32_t p_class) {
+	FreeList &list = thread_cache.lists[p_class];
+	if (unlikely(!list.head) && likely(!thread_cache.exited)) {
+		thread_cache_releaser.ensure_registered();
+	}
+
+	FreeBlock *block = (FreeBlock *)p_block;
+	block->next = list.head;
+	list.head = block;
+	list.count++;
+
+	if (unlikely(thread_cache.exited)) {
+		_release(p_class, list, list.count);
+	} else if (unlikely(list.count > 2 * _get_batch_count(p_class))) {
+		_release(p_class, list, _get_batch_count(p_class));
+	}
+}
+
+void SlabAllocator::set_enabled(bool p_enabled) {
+	enabled = p_enabled;
+}
+
+uint64_t SlabAllocator::get_reserved_bytes() {
+	return reserved_bytes.get();
+}
@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  slab_allocator.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+
+#include <cstddef>
+
+// Size-class allocator for small blocks, used by Memory::alloc_static in builds with `slab_allocator=yes`.
+//
+// Each thread keeps a cache of free blocks per size class, so most allocations and frees don't lock.
+// Caches trade blocks in batches with a shared free list per class. This is also how blocks freed on
+// another thread than the one that allocated them are reused. Slabs are never returned to the system.
+class SlabAllocator {
+	// Only changed at startup, before other threads are started.
+	static bool enabled;
+
+public:
+	static constexpr uint32_t CLASS_COUNT = 16;
+	static constexpr size_t MAX_BLOCK_SIZE = 512;
+	static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+	// Classes are 16 bytes apart up to 128 bytes, 32 bytes apart up to 256 and 64 bytes apart up to 512.
+	static _FORCE_INLINE_ uint32_t get_size_class(size_t p_bytes) {
+		DEV_ASSERT(p_bytes > 0 && p_bytes <= MAX_BLOCK_SIZE);
+		if (p_bytes <= 128) {
+			return (p_bytes - 1) / 16;
+		} else if (p_bytes <= 256) {
+			return 8 + (p_bytes - 129) / 32;
+		}
+		return 12 + (p_bytes - 257) / 64;
+	}
+
+	static _FORCE_INLINE_ size_t get_class_size(uint32_t p_class) {
+		if (p_class < 8) {
+			return (p_class + 1) * 16;
+		} else if (p_class < 12) {
+			return 128 + (p_class - 7) * 32;
+		}
+		return 256 + (p_class - 11) * 64;
+	}
+
+	static void *alloc(uint32_t p_class);
+	static void free(void *p_block, uint32_t p_class);
+
+	static _FORCE_INLINE_ bool is_enabled() { return enabled; }
+	static void set_enabled(bool p_enabled);
+
+	// Bytes held in slabs, whether their blocks are in use or not.
+	static uint64_t get_reserved_bytes();
+};
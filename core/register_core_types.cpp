@@ -327,6 +327,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/frame_task_graph/enabled", false);
 }
 
 void register_early_core_singletons() {
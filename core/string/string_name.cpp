@@ -32,37 +32,107 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 
 struct StringName::Table {
-	constexpr static uint32_t TABLE_BITS = 16;
-	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
-	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
+	// Names are spread over shards by the top bits of their hash. Each shard has its own lock and
+	// its own bucket array, which doubles as names are added, so threads interning different names
+	// rarely wait on each other and chains stay short however many names there are.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t MIN_BUCKET_BITS = 10;
+	constexpr static uint32_t MAX_BUCKET_BITS = 32 - SHARD_BITS;
+
+	// Only used for the static shards below, which start zeroed.
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		BinaryMutex mutex;
+		_Data **buckets;
+		uint32_t bucket_bits;
+		uint32_t bucket_mask;
+		uint32_t count;
+	};
+
+	static inline Shard shards[SHARD_COUNT];
+	static inline PagedAllocator<_Data, true> allocator;
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_hash) {
+		return shards[p_hash >> (32 - SHARD_BITS)];
+	}
+
+	static void set_bucket_bits(Shard &r_shard, uint32_t p_bits) {
+		const uint32_t len = 1 << p_bits;
+		_Data **buckets = (_Data **)memalloc(sizeof(_Data *) * len);
+		for (uint32_t i = 0; i < len; i++) {
+			buckets[i] = nullptr;
+		}
+
+		// Move the existing entries over, keeping each chain doubly linked.
+		const uint32_t old_len = r_shard.buckets ? r_shard.bucket_mask + 1 : 0;
+		for (uint32_t i = 0; i < old_len; i++) {
+			_Data *d = r_shard.buckets[i];
+			while (d) {
+				_Data *next = d->next;
+				const uint32_t idx = d->hash & (len - 1);
+				d->prev = nullptr;
+				d->next = buckets[idx];
+				if (buckets[idx]) {
+					buckets[idx]->prev = d;
+				}
+				buckets[idx] = d;
+				d = next;
+			}
+		}
+
+		if (r_shard.buckets) {
+			memfree(r_shard.buckets);
+		}
+		r_shard.buckets = buckets;
+		r_shard.bucket_bits = p_bits;
+		r_shard.bucket_mask = len - 1;
+	}
+
+	// Must be called with the shard locked.
+	static void insert(Shard &r_shard, _Data *p_data) {
+		if (r_shard.count > r_shard.bucket_mask && r_shard.bucket_bits < MAX_BUCKET_BITS) {
+			set_bucket_bits(r_shard, r_shard.bucket_bits + 1);
+		}
+		r_shard.count++;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+		const uint32_t idx = p_data->hash & r_shard.bucket_mask;
+		p_data->next = r_shard.buckets[idx];
+		p_data->prev = nullptr;
+		if (r_shard.buckets[idx]) {
+			r_shard.buckets[idx]->prev = p_data;
+		}
+		r_shard.buckets[idx] = p_data;
+	}
 };
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+	for (Table::Shard &shard : Table::shards) {
+		Table::set_bucket_bits(shard, Table::MIN_BUCKET_BITS);
+		shard.count = 0;
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (Table::Shard &shard : Table::shards) {
+		shard.mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (const Table::Shard &shard : Table::shards) {
+			for (uint32_t i = 0; i <= shard.bucket_mask; i++) {
+				_Data *d = shard.buckets[i];
+				while (d) {
+					data.push_back(d);
+					d = d->next;
+				}
 			}
 		}
 
@@ -85,32 +155,44 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+	for (Table::Shard &shard : Table::shards) {
+		for (uint32_t i = 0; i <= shard.bucket_mask; i++) {
+			while (shard.buckets[i]) {
+				_Data *d = shard.buckets[i];
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+					}
 				}
-			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+				shard.buckets[i] = shard.buckets[i]->next;
+				Table::allocator.free(d);
+			}
 		}
+		memfree(shard.buckets);
+		shard.buckets = nullptr;
+		shard.bucket_bits = 0;
+		shard.bucket_mask = 0;
+		shard.count = 0;
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (Table::Shard &shard : Table::shards) {
+		shard.mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		Table::Shard &shard = Table::get_shard(_data->hash);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -118,13 +200,13 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
+			shard.buckets[_data->hash & shard.bucket_mask] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
+		shard.count--;
 		Table::allocator.free(_data);
 	}
 
@@ -211,10 +293,10 @@ StringName::StringName(const char *p_name, bool p_static) {
 	}
 
 	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
+	Table::Shard &shard = Table::get_shard(hash);
 
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
+	MutexLock lock(shard.mutex);
+	_data = shard.buckets[hash & shard.bucket_mask];
 
 	while (_data) {
 		// compare hash first
@@ -242,8 +324,6 @@ StringName::StringName(const char *p_name, bool p_static) {
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
 	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -252,10 +332,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		_data->static_count.increment();
 	}
 #endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	Table::insert(shard, _data);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -268,10 +345,10 @@ StringName::StringName(const String &p_name, bool p_static) {
 	}
 
 	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
+	Table::Shard &shard = Table::get_shard(hash);
 
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
+	MutexLock lock(shard.mutex);
+	_data = shard.buckets[hash & shard.bucket_mask];
 
 	while (_data) {
 		if (_data->hash == hash && _data->name == p_name) {
@@ -298,8 +375,6 @@ StringName::StringName(const String &p_name, bool p_static) {
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
 	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		// Keep in memory, force static.
@@ -308,10 +383,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	}
 #endif
 
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	Table::insert(shard, _data);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -30,9 +30,180 @@
 
 #include "command_queue_mt.h"
 
+#include "core/os/os.h"
+
+SafeNumeric<uint32_t> CommandQueueMT::stat_max_commands_per_flush;
+SafeNumeric<uint64_t> CommandQueueMT::stat_stall_usec;
+
+void CommandQueueMT::Block::reset() {
+	reserved.store(0, std::memory_order_relaxed);
+	end.store(BLOCK_NOT_SEALED, std::memory_order_relaxed);
+	next.store(nullptr, std::memory_order_relaxed);
+	list_next = nullptr;
+	// Zeroed headers mark commands that haven't been published yet.
+	memset(data, 0, sizeof(data));
+}
+
+CommandQueueMT::Block *CommandQueueMT::_alloc_block() {
+	// Only called by the producer sealing the tail block, so there's a single popper and no ABA problem.
+	Block *block = free_blocks.load(std::memory_order_acquire);
+	while (block && !free_blocks.compare_exchange_weak(block, block->list_next, std::memory_order_acquire)) {
+	}
+	if (block) {
+		block->list_next = nullptr;
+		return block;
+	}
+	return memnew(Block);
+}
+
+void CommandQueueMT::_seal_block(Block *p_block, uint32_t p_end) {
+	p_block->end.store(p_end, std::memory_order_release);
+	Block *next = _alloc_block();
+	p_block->next.store(next, std::memory_order_release);
+	tail.store(next);
+}
+
+void CommandQueueMT::_recycle_retired_blocks() {
+	Block **prev = &retired_blocks;
+	while (*prev) {
+		Block *block = *prev;
+		// A producer may still be checking whether this is the tail, see _reserve().
+		if (tail.load() == block || block->writers.load() != 0) {
+			prev = &block->list_next;
+			continue;
+		}
+		*prev = block->list_next;
+
+		block->reset();
+		Block *top = free_blocks.load(std::memory_order_relaxed);
+		do {
+			block->list_next = top;
+		} while (!free_blocks.compare_exchange_weak(top, block, std::memory_order_release, std::memory_order_relaxed));
+	}
+}
+
+void CommandQueueMT::_notify_sync(std::atomic<bool> *p_sync_done) {
+	p_sync_done->store(true);
+	// The pusher may return as soon as it sees the flag, so it can't be touched anymore.
+	if (sync_sleepers.load() != 0) {
+		MutexLock lock(sync_mutex);
+		sync_cond_var.notify_all();
+	}
+}
+
+void CommandQueueMT::_wait_for_sync(const std::atomic<bool> &p_sync_done) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// Most syncs are answered quickly by a consumer that is already running, so spin for a bit before sleeping.
+	for (uint32_t i = 0; i < SYNC_SPIN_ITERATIONS; i++) {
+		if (p_sync_done.load(std::memory_order_acquire)) {
+			break;
+		}
+	}
+
+	if (!p_sync_done.load()) {
+		MutexLock lock(sync_mutex);
+		sync_sleepers.fetch_add(1);
+		while (!p_sync_done.load()) {
+			sync_cond_var.wait(lock);
+		}
+		sync_sleepers.fetch_sub(1);
+	}
+
+	stat_stall_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
+}
+
+void CommandQueueMT::_notify_pending() {
+	WorkerThreadPool::TaskID pump = pump_task_id.load(std::memory_order_relaxed);
+	if (pump != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->notify_yield_over(pump);
+	}
+}
+
+void CommandQueueMT::_flush() {
+	MutexLock lock(flush_mutex);
+	if (unlikely(flushing)) {
+		// Re-entrant call, or another thread got in while the flushing one is in an unlock allowance zone.
+		return;
+	}
+	flushing = true;
+
+	// Cleared before reading, so anything pushed from now on makes it pending again.
+	pending.store(false);
+
+	uint32_t count = 0;
+	while (true) {
+		if (read_offset == head->end.load(std::memory_order_acquire)) {
+			Block *next = head->next.load(std::memory_order_acquire);
+			if (!next) {
+				break; // Still being linked.
+			}
+			head->list_next = retired_blocks;
+			retired_blocks = head;
+			head = next;
+			read_offset = 0;
+			continue;
+		}
+		if (read_offset + COMMAND_HEADER_SIZE > BLOCK_SIZE) {
+			break; // Full, but not sealed yet.
+		}
+
+		uint32_t size = head->header(read_offset).load(std::memory_order_acquire);
+		if (size == 0) {
+			break; // Reserved, but not published yet. The pusher will make the queue pending again.
+		}
+
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&head->data[read_offset + COMMAND_HEADER_SIZE]);
+		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
+		cmd->call();
+		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+		std::atomic<bool> *sync_done = cmd->sync_done;
+		cmd->~CommandBase();
+		read_offset += size;
+		count++;
+
+		if (unlikely(sync_done)) {
+			_notify_sync(sync_done);
+		}
+	}
+
+	_recycle_retired_blocks();
+	flushing = false;
+
+	if (count) {
+		stat_max_commands_per_flush.exchange_if_greater(count);
+	}
+}
+
+void CommandQueueMT::get_and_reset_stats(uint32_t &r_max_commands_per_flush, uint64_t &r_stall_usec) {
+	// Losing a concurrent update here is fine, these are just stats.
+	r_max_commands_per_flush = stat_max_commands_per_flush.get();
+	stat_max_commands_per_flush.set(0);
+	r_stall_usec = stat_stall_usec.get();
+	stat_stall_usec.sub(r_stall_usec);
+}
+
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	head = memnew(Block);
+	tail.store(head);
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	while (head) {
+		Block *next = head->next.load();
+		memdelete(head);
+		head = next;
+	}
+	while (retired_blocks) {
+		Block *next = retired_blocks->list_next;
+		memdelete(retired_blocks);
+		retired_blocks = next;
+	}
+	Block *block = free_blocks.load();
+	while (block) {
+		Block *next = block->list_next;
+		memdelete(block);
+		block = next;
+	}
 }
@@ -33,22 +33,28 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
-#include "core/templates/local_vector.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
 #include "core/typedefs.h"
 
+// Multi-producer, single-consumer queue of deferred method calls, used by the threaded server wrappers.
+//
+// Commands are written into chained fixed-size blocks. Producers reserve space in the current block with
+// an atomic add and publish the command by writing its size header last, so pushing never takes a lock
+// and never waits for the consumer to finish running commands. The producer whose reservation overflows
+// a block seals it and links the next one. Blocks are recycled by the consumer once every producer that
+// could still touch them is done.
 class CommandQueueMT {
 	struct CommandBase {
-		bool sync = false;
+		// Set by the consumer after running the command, if the pusher is waiting for it.
+		std::atomic<bool> *sync_done = nullptr;
 		virtual void call() = 0;
 		virtual ~CommandBase() = default;
-
-		CommandBase(bool p_sync) :
-				sync(p_sync) {}
 	};
 
-	template <typename T, typename M, bool NeedsSync, typename... Args>
+	template <typename T, typename M, typename... Args>
 	struct Command : public CommandBase {
 		T *instance;
 		M method;
@@ -56,7 +62,7 @@ class CommandQueueMT {
 
 		template <typename... FwdArgs>
 		_FORCE_INLINE_ Command(T *p_instance, M p_method, FwdArgs &&...p_args) :
-				CommandBase(NeedsSync), instance(p_instance), method(p_method), args(std::forward<FwdArgs>(p_args)...) {}
+				instance(p_instance), method(p_method), args(std::forward<FwdArgs>(p_args)...) {}
 
 		void call() {
 			call_impl(BuildIndexSequence<sizeof...(Args)>{});
@@ -83,7 +89,7 @@ class CommandQueueMT {
 		Tuple<GetSimpleTypeT<Args>...> args;
 
 		_FORCE_INLINE_ CommandRet(T *p_instance, M p_method, R *p_ret, GetSimpleTypeT<Args>... p_args) :
-				CommandBase(true), instance(p_instance), method(p_method), ret(p_ret), args{ p_args... } {}
+				instance(p_instance), method(p_method), ret(p_ret), args{ p_args... } {}
 
 		void call() override {
 			*ret = call_impl(BuildIndexSequence<sizeof...(Args)>{});
@@ -103,105 +109,120 @@ class CommandQueueMT {
 
 	/***** BASE *******/
 
-	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t BLOCK_SIZE = 64 * 1024;
+	// Each command is preceded by its total size, which producers write last to publish it. Zero means not published yet.
+	static const uint32_t COMMAND_HEADER_SIZE = 8;
+	static const uint32_t BLOCK_NOT_SEALED = UINT32_MAX;
+	// How long a pusher waiting for a sync command spins before going to sleep.
+	static const uint32_t SYNC_SPIN_ITERATIONS = 1024;
+
+	struct Block {
+		// Producer side. Once the block is full, reserved goes past BLOCK_SIZE and stays there.
+		std::atomic<uint32_t> reserved = 0;
+		// Producers currently using the block, so the consumer knows when it's safe to recycle it.
+		std::atomic<uint32_t> writers = 0;
+		// Set by the producer that fills the block: where its last command ends, and the block after it.
+		std::atomic<uint32_t> end = BLOCK_NOT_SEALED;
+		std::atomic<Block *> next = nullptr;
+		// Link in the free and retired lists.
+		Block *list_next = nullptr;
+
+		alignas(8) uint8_t data[BLOCK_SIZE];
+
+		_FORCE_INLINE_ std::atomic<uint32_t> &header(uint32_t p_offset) {
+			return *reinterpret_cast<std::atomic<uint32_t> *>(&data[p_offset]);
+		}
 
-	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
-	ConditionVariable sync_cond_var;
-	uint32_t sync_head = 0;
-	uint32_t sync_tail = 0;
-	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+		void reset();
+		Block() { reset(); }
+	};
+
+	// Producer side.
+	std::atomic<Block *> tail = nullptr;
+	// Blocks ready for reuse. Pushed by the consumer, popped by the producer sealing a block, which there's only one of at a time.
+	std::atomic<Block *> free_blocks = nullptr;
 	std::atomic<bool> pending{ false };
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	// Consumer side, only touched while holding flush_mutex.
+	BinaryMutex flush_mutex;
+	bool flushing = false;
+	Block *head = nullptr;
+	uint32_t read_offset = 0;
+	// Consumed blocks that may still be referenced by a producer.
+	Block *retired_blocks = nullptr;
+
+	// Pushers waiting for sync commands, once they're done spinning.
+	BinaryMutex sync_mutex;
+	ConditionVariable sync_cond_var;
+	std::atomic<uint32_t> sync_sleepers = 0;
+
+	// Stats shared by all the queues. They're only updated once per flush and per sync push, so pushing doesn't contend on them.
+	static SafeNumeric<uint32_t> stat_max_commands_per_flush;
+	static SafeNumeric<uint64_t> stat_stall_usec;
+
+	Block *_alloc_block();
+	void _seal_block(Block *p_block, uint32_t p_end);
+	void _recycle_retired_blocks();
+	void _notify_sync(std::atomic<bool> *p_sync_done);
+	void _wait_for_sync(const std::atomic<bool> &p_sync_done);
+	void _notify_pending();
+
+	// Returns the block to write to, with its writers count incremented.
+	_FORCE_INLINE_ Block *_reserve(uint32_t p_size, uint32_t &r_offset) {
+		while (true) {
+			Block *block = tail.load(std::memory_order_acquire);
+			block->writers.fetch_add(1);
+			// Checking the tail again after announcing ourselves as a writer guarantees the block won't be recycled under us.
+			if (likely(tail.load() == block && block->reserved.load(std::memory_order_relaxed) <= BLOCK_SIZE)) {
+				r_offset = block->reserved.fetch_add(p_size, std::memory_order_relaxed);
+				if (likely(r_offset + p_size <= BLOCK_SIZE)) {
+					return block;
+				}
+				if (r_offset <= BLOCK_SIZE) {
+					// First reservation not fitting, it's on us to move to the next block.
+					_seal_block(block, r_offset);
+				}
+			}
+			block->writers.fetch_sub(1, std::memory_order_release);
+#ifdef THREADS_ENABLED
+			if (tail.load(std::memory_order_acquire) == block) {
+				Thread::yield(); // Another producer is sealing the block.
+			}
+#endif
+		}
+	}
 
 	template <typename T, typename... Args>
-	_FORCE_INLINE_ void create_command(Args &&...p_args) {
-		// alloc size is size+T+safeguard
-		constexpr uint64_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
-		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
-
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
-		new (cmd) T(std::forward<Args>(p_args)...);
-		pending.store(true);
+	_FORCE_INLINE_ void create_command(std::atomic<bool> *p_sync_done, Args &&...p_args) {
+		constexpr uint64_t alloc_size = COMMAND_HEADER_SIZE + ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		static_assert(alloc_size <= BLOCK_SIZE, "Type too large to fit in the command queue.");
+
+		uint32_t offset;
+		Block *block = _reserve(alloc_size, offset);
+		T *cmd = new (&block->data[offset + COMMAND_HEADER_SIZE]) T(std::forward<Args>(p_args)...);
+		cmd->sync_done = p_sync_done;
+		block->header(offset).store(alloc_size, std::memory_order_release);
+		block->writers.fetch_sub(1, std::memory_order_release);
+
+		// Only the push making the queue non-empty needs to wake up the consumer.
+		if (!pending.exchange(true)) {
+			_notify_pending();
+		}
 	}
 
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
-		MutexLock mlock(mutex);
-		create_command<T>(std::forward<Args>(args)...);
-
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
-		}
-
 		if constexpr (NeedsSync) {
-			sync_tail++;
-			_wait_for_sync(mlock);
+			std::atomic<bool> sync_done = false;
+			create_command<T>(&sync_done, std::forward<Args>(args)...);
+			_wait_for_sync(sync_done);
+		} else {
+			create_command<T>(nullptr, std::forward<Args>(args)...);
 		}
 	}
 
-	_FORCE_INLINE_ void _prevent_sync_wraparound() {
-		bool safe_to_reset = !sync_awaiters;
-		bool already_sync_to_latest = sync_head == sync_tail;
-		if (safe_to_reset && already_sync_to_latest) {
-			sync_head = 0;
-			sync_tail = 0;
-		}
-	}
-
-	void _flush() {
-		if (unlikely(flush_read_ptr)) {
-			// Re-entrant call.
-			return;
-		}
-
-		MutexLock lock(mutex);
-
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
-			cmd->call();
-			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
-
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			}
-
-			cmd->~CommandBase();
-
-			flush_read_ptr += size;
-		}
-
-		command_mem.clear();
-		pending.store(false);
-		flush_read_ptr = 0;
-
-		_prevent_sync_wraparound();
-	}
-
-	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
-		sync_awaiters++;
-		uint32_t sync_head_goal = sync_tail;
-		do {
-			sync_cond_var.wait(p_lock);
-		} while (sync_head < sync_head_goal);
-		sync_awaiters--;
-		_prevent_sync_wraparound();
-	}
+	void _flush();
 
 	void _no_op() {}
 
@@ -209,14 +230,14 @@ public:
 	template <typename T, typename M, typename... Args>
 	void push(T *p_instance, M p_method, Args &&...p_args) {
 		// Standard command, no sync.
-		using CommandType = Command<T, M, false, Args...>;
+		using CommandType = Command<T, M, Args...>;
 		_push_internal<CommandType, false>(p_instance, p_method, std::forward<Args>(p_args)...);
 	}
 
 	template <typename T, typename M, typename... Args>
 	void push_and_sync(T *p_instance, M p_method, Args... p_args) {
 		// Standard command, sync.
-		using CommandType = Command<T, M, true, Args...>;
+		using CommandType = Command<T, M, Args...>;
 		_push_internal<CommandType, true>(p_instance, p_method, std::forward<Args>(p_args)...);
 	}
 
@@ -228,7 +249,7 @@ public:
 	}
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(pending.load())) {
+		if (unlikely(pending.load(std::memory_order_relaxed))) {
 			_flush();
 		}
 	}
@@ -242,16 +263,19 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		ERR_FAIL_COND(pump_task_id.load() == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id.load());
 		_flush();
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
-		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id);
 	}
 
+	// Largest number of commands run by a single flush, and total time pushers spent waiting for sync commands,
+	// across all queues since the last call.
+	static void get_and_reset_stats(uint32_t &r_max_commands_per_flush, uint64_t &r_stall_usec);
+
 	CommandQueueMT();
 	~CommandQueueMT();
 };
@@ -0,0 +1,602 @@
+/**************************************************************************/
+/*  ordered_hash_map.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/sort_array.h"
+
+#if defined(_MSC_VER) && !defined(__GNUC__)
+#include <intrin.h>
+#endif
+
+/**
+ * A hash map that stores its pairs in insertion order in a dense array, like CPython's dict,
+ * with a separate open addressing index of positions in that array. Up to SMALL_CAPACITY pairs
+ * there is no index at all: lookups compare the hashes one after another, and the whole map is a
+ * single allocation.
+ *
+ * The array is made of chunks that double in size and never move, so inserting never invalidates
+ * pointers to keys or values, like HashMap. Erasing leaves a hole that iteration skips. Once there
+ * are at least as many holes as pairs, erasing packs them, which moves the pairs and invalidates
+ * pointers and iterators to them, as do reserve() and sorting.
+ *
+ * Iteration order, overwriting existing keys and inserting erased keys again behave like HashMap.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class OrderedHashMap {
+public:
+	// Must be a power of two.
+	static constexpr uint32_t SMALL_CAPACITY = 8;
+	static constexpr uint32_t MAX_CHUNKS = 28;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	// Chunk i holds SMALL_CAPACITY << i pairs, their hashes first and then the pairs themselves.
+	// An EMPTY_HASH marks an erased pair.
+	uint8_t *small_chunk = nullptr;
+	uint8_t **chunks = nullptr; // Only allocated with more than one chunk, then chunks[0] == small_chunk.
+	uint32_t *index = nullptr; // Position + 1 of the pairs, 0 if empty. Only allocated with more than one chunk.
+	uint32_t index_mask = 0;
+	uint32_t chunk_count = 0;
+	uint32_t used = 0; // Positions handed out so far, including erased pairs.
+	uint32_t num_elements = 0;
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_chunk_of(uint32_t p_pos) {
+		// Chunk i starts at SMALL_CAPACITY * (2^i - 1), so it's the highest bit of this.
+		const uint32_t n = p_pos / SMALL_CAPACITY + 1;
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(n);
+#elif defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanReverse(&bit, n);
+		return bit;
+#else
+		return nearest_shift(n) - 1;
+#endif
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_chunk_start(uint32_t p_chunk) {
+		return SMALL_CAPACITY * ((1u << p_chunk) - 1);
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_chunk_capacity(uint32_t p_chunk) {
+		return SMALL_CAPACITY << p_chunk;
+	}
+
+	_FORCE_INLINE_ uint8_t *_get_chunk(uint32_t p_chunk) const {
+		return p_chunk == 0 ? small_chunk : chunks[p_chunk];
+	}
+
+	_FORCE_INLINE_ uint32_t &_get_hash(uint32_t p_pos) const {
+		const uint32_t chunk = _get_chunk_of(p_pos);
+		return ((uint32_t *)_get_chunk(chunk))[p_pos - _get_chunk_start(chunk)];
+	}
+
+	_FORCE_INLINE_ MapKeyValue &_get_pair(uint32_t p_pos) const {
+		const uint32_t chunk = _get_chunk_of(p_pos);
+		const uint32_t capacity = _get_chunk_capacity(chunk);
+		MapKeyValue *pairs = (MapKeyValue *)(_get_chunk(chunk) + capacity * sizeof(uint32_t));
+		return pairs[p_pos - _get_chunk_start(chunk)];
+	}
+
+	_FORCE_INLINE_ uint32_t _get_next_pos(uint32_t p_pos) const {
+		while (p_pos < used && _get_hash(p_pos) == EMPTY_HASH) {
+			p_pos++;
+		}
+		return p_pos;
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+
+		if (index == nullptr) {
+			const uint32_t *hashes = (const uint32_t *)small_chunk;
+			const MapKeyValue *pairs = (const MapKeyValue *)(small_chunk + SMALL_CAPACITY * sizeof(uint32_t));
+			for (uint32_t i = 0; i < used; i++) {
+				if (hashes[i] == p_hash && Comparator::compare(pairs[i].key, p_key)) {
+					r_pos = i;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Erased pairs stay in the index until it's rebuilt, their hash doesn't match anymore.
+		uint32_t slot = p_hash & index_mask;
+		while (index[slot] != 0) {
+			const uint32_t pos = index[slot] - 1;
+			if (_get_hash(pos) == p_hash && Comparator::compare(_get_pair(pos).key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+			slot = (slot + 1) & index_mask;
+		}
+		return false;
+	}
+
+	_FORCE_INLINE_ void _index_insert(uint32_t p_hash, uint32_t p_pos) {
+		uint32_t slot = p_hash & index_mask;
+		while (index[slot] != 0) {
+			slot = (slot + 1) & index_mask;
+		}
+		index[slot] = p_pos + 1;
+	}
+
+	void _rebuild_index() {
+		if (index != nullptr) {
+			Memory::free_static(index);
+			index = nullptr;
+		}
+		if (chunk_count < 2) {
+			return;
+		}
+
+		// Twice the capacity, so the index is never more than half full.
+		const uint32_t size = SMALL_CAPACITY << (chunk_count + 1);
+		index = (uint32_t *)Memory::alloc_static(sizeof(uint32_t) * size);
+		memset(index, 0, sizeof(uint32_t) * size);
+		index_mask = size - 1;
+
+		for (uint32_t pos = 0; pos < used; pos++) {
+			const uint32_t hash = _get_hash(pos);
+			if (hash != EMPTY_HASH) {
+				_index_insert(hash, pos);
+			}
+		}
+	}
+
+	void _add_chunk() {
+		CRASH_COND_MSG(chunk_count == MAX_CHUNKS, "OrderedHashMap is full.");
+		const uint32_t capacity = _get_chunk_capacity(chunk_count);
+		uint8_t *chunk = (uint8_t *)Memory::alloc_static(capacity * (sizeof(uint32_t) + sizeof(MapKeyValue)));
+
+		if (chunk_count == 0) {
+			small_chunk = chunk;
+		} else {
+			if (chunks == nullptr) {
+				chunks = (uint8_t **)Memory::alloc_static(sizeof(uint8_t *) * MAX_CHUNKS);
+				chunks[0] = small_chunk;
+			}
+			chunks[chunk_count] = chunk;
+		}
+		chunk_count++;
+	}
+
+	// Frees the chunks after the first p_keep ones.
+	void _free_chunks(uint32_t p_keep) {
+		while (chunk_count > p_keep) {
+			chunk_count--;
+			Memory::free_static(_get_chunk(chunk_count));
+		}
+		if (chunk_count < 2 && chunks != nullptr) {
+			Memory::free_static(chunks);
+			chunks = nullptr;
+		}
+		if (chunk_count == 0) {
+			small_chunk = nullptr;
+		}
+	}
+
+	MapKeyValue *_insert(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (used == _get_chunk_start(chunk_count)) {
+			// Grow even if there are holes, the pairs must not move here.
+			_add_chunk();
+			_rebuild_index();
+		}
+
+		const uint32_t pos = used++;
+		_get_hash(pos) = p_hash;
+		MapKeyValue *pair = &_get_pair(pos);
+		memnew_placement(pair, MapKeyValue(p_key, p_value));
+		if (index != nullptr) {
+			_index_insert(p_hash, pos);
+		}
+		num_elements++;
+		return pair;
+	}
+
+	// Moves the remaining pairs to the front, keeping their order. Like LocalVector and CowData,
+	// this relocates them with memcpy. The chunks are kept, as HashMap keeps its capacity.
+	void _compact() {
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < used; from++) {
+			const uint32_t hash = _get_hash(from);
+			if (hash == EMPTY_HASH) {
+				continue;
+			}
+			if (from != to) {
+				_get_hash(to) = hash;
+				memcpy((void *)&_get_pair(to), (const void *)&_get_pair(from), sizeof(MapKeyValue));
+			}
+			to++;
+		}
+		used = to;
+		_rebuild_index();
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		_get_hash(p_pos) = EMPTY_HASH;
+		_get_pair(p_pos).~MapKeyValue();
+		num_elements--;
+
+		if (num_elements == 0) {
+			used = 0;
+			if (index != nullptr) {
+				memset(index, 0, sizeof(uint32_t) * (index_mask + 1));
+			}
+		} else if (used - num_elements > SMALL_CAPACITY && used - num_elements >= num_elements) {
+			// Packing once half the positions are holes keeps erasing amortized constant time,
+			// and keeps maps whose keys keep changing from growing forever.
+			_compact();
+		}
+	}
+
+	void _copy_from(const OrderedHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (uint32_t pos = 0; pos < p_other.used; pos++) {
+			const uint32_t hash = p_other._get_hash(pos);
+			if (hash != EMPTY_HASH) {
+				const MapKeyValue &pair = p_other._get_pair(pos);
+				_insert(pair.key, pair.value, hash);
+			}
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _get_chunk_start(chunk_count); }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t pos = 0; pos < used; pos++) {
+				if (_get_hash(pos) != EMPTY_HASH) {
+					_get_pair(pos).~MapKeyValue();
+				}
+			}
+		}
+		used = 0;
+		num_elements = 0;
+
+		// Keep the first chunk, so small maps that are cleared and refilled don't allocate again.
+		_free_chunks(MIN(chunk_count, 1u));
+		_rebuild_index();
+	}
+
+	template <typename C>
+	void sort_custom() {
+		if (size() < 2) {
+			return;
+		}
+		_compact();
+
+		// Sort positions rather than the pairs, then move every pair once. Ties keep their order,
+		// like the stable sort of HashMap.
+		struct PositionSort {
+			const OrderedHashMap *map = nullptr;
+			C compare;
+			_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+				const MapKeyValue &a = map->_get_pair(p_a);
+				const MapKeyValue &b = map->_get_pair(p_b);
+				if (compare(a, b)) {
+					return true;
+				}
+				if (compare(b, a)) {
+					return false;
+				}
+				return p_a < p_b;
+			}
+		};
+
+		uint32_t *order = (uint32_t *)Memory::alloc_static(sizeof(uint32_t) * used);
+		for (uint32_t i = 0; i < used; i++) {
+			order[i] = i;
+		}
+		SortArray<uint32_t, PositionSort> sorter;
+		sorter.compare.map = this;
+		sorter.sort(order, used);
+
+		uint8_t *sorted = (uint8_t *)Memory::alloc_static(sizeof(MapKeyValue) * used);
+		for (uint32_t i = 0; i < used; i++) {
+			memcpy((void *)(sorted + sizeof(MapKeyValue) * i), (const void *)&_get_pair(order[i]), sizeof(MapKeyValue));
+			order[i] = _get_hash(order[i]);
+		}
+		for (uint32_t i = 0; i < used; i++) {
+			memcpy((void *)&_get_pair(i), (const void *)(sorted + sizeof(MapKeyValue) * i), sizeof(MapKeyValue));
+			_get_hash(i) = order[i];
+		}
+		Memory::free_static(sorted);
+		Memory::free_static(order);
+
+		_rebuild_index();
+	}
+
+	void sort() {
+		sort_custom<KeyValueSort<TKey, TValue>>();
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, _hash(p_key), pos);
+		CRASH_COND_MSG(!exists, "OrderedHashMap key not found.");
+		return _get_pair(pos).value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, _hash(p_key), pos);
+		CRASH_COND_MSG(!exists, "OrderedHashMap key not found.");
+		return _get_pair(pos).value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, _hash(p_key), pos)) {
+			return &_get_pair(pos).value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, _hash(p_key), pos)) {
+			return &_get_pair(pos).value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, _hash(p_key), pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, _hash(p_key), pos)) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity <= num_elements || used + (p_new_capacity - num_elements) <= get_capacity()) {
+			return;
+		}
+		if (used > num_elements) {
+			// New pairs only go after the last position, so reuse the holes before growing.
+			_compact();
+			if (p_new_capacity <= get_capacity()) {
+				return;
+			}
+		}
+		while (get_capacity() < p_new_capacity) {
+			_add_chunk();
+		}
+		_rebuild_index();
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (pair) {
+				pos = map->_get_next_pos(pos + 1);
+				pair = pos < map->used ? &map->_get_pair(pos) : nullptr;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const OrderedHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+			pair = p_pos < p_map->used ? &p_map->_get_pair(p_pos) : nullptr;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const OrderedHashMap *map = nullptr;
+		const MapKeyValue *pair = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (pair) {
+				pos = map->_get_next_pos(pos + 1);
+				pair = pos < map->used ? &map->_get_pair(pos) : nullptr;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(const OrderedHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+			pair = p_pos < p_map->used ? &p_map->_get_pair(p_pos) : nullptr;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return pair ? ConstIterator(map, pos) : ConstIterator();
+		}
+
+	private:
+		const OrderedHashMap *map = nullptr;
+		MapKeyValue *pair = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _get_next_pos(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, _hash(p_key), pos)) {
+			return end();
+		}
+		return Iterator(this, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _get_next_pos(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, _hash(p_key), pos)) {
+			return end();
+		}
+		return ConstIterator(this, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, _hash(p_key), pos);
+		CRASH_COND(!exists);
+		return _get_pair(pos).value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		const uint32_t hash = _hash(p_key);
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, hash, pos)) {
+			return _insert(p_key, TValue(), hash)->value;
+		}
+		return _get_pair(pos).value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t hash = _hash(p_key);
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, hash, pos)) {
+			_insert(p_key, p_value, hash);
+			return Iterator(this, used - 1);
+		}
+		_get_pair(pos).value = p_value;
+		return Iterator(this, pos);
+	}
+
+	/* Constructors */
+
+	OrderedHashMap(const OrderedHashMap &p_other) {
+		_copy_from(p_other);
+	}
+
+	void operator=(const OrderedHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		_copy_from(p_other);
+	}
+
+	OrderedHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	OrderedHashMap() {}
+
+	OrderedHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	~OrderedHashMap() {
+		clear();
+		_free_chunks(0);
+	}
+};
@@ -0,0 +1,320 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/vector.h"
+
+/**
+ * A Vector that keeps up to INLINE_CAPACITY elements inside the object itself, and only
+ * allocates Vector storage once it grows past that. Useful for containers that are usually tiny
+ * but can't be bounded, like call arguments or the elements of Array, to save the allocation and
+ * its header in the common case. The object is always as big as its inline capacity.
+ *
+ * Copying a SmallVector that fits inline copies its elements. Copying a bigger one shares the
+ * copy-on-write storage like Vector does. Once spilled, the elements stay in the Vector storage
+ * until it's emptied.
+ *
+ * As with Vector, pointers to the elements are invalidated when the size changes, and when
+ * writing to storage that is shared.
+ */
+template <typename T, uint32_t INLINE_CAPACITY>
+class SmallVector;
+
+template <typename T, uint32_t INLINE_CAPACITY>
+class SmallVectorWriteProxy {
+public:
+	_FORCE_INLINE_ T &operator[](typename CowData<T>::Size p_index) {
+		SmallVector<T, INLINE_CAPACITY> *vector = (SmallVector<T, INLINE_CAPACITY> *)(this);
+		CRASH_BAD_INDEX(p_index, vector->size());
+
+		return vector->ptrw()[p_index];
+	}
+};
+
+template <typename T, uint32_t INLINE_CAPACITY>
+class SmallVector {
+public:
+	SmallVectorWriteProxy<T, INLINE_CAPACITY> write;
+	typedef typename CowData<T>::Size Size;
+
+private:
+	// The C# glue reads these fields for Array, see godot_array in InteropStructs.cs.
+	Vector<T> heap; // Empty as long as the elements fit inline.
+	uint32_t inline_size = 0;
+	alignas(T) uint8_t inline_data[INLINE_CAPACITY * sizeof(T)];
+
+	_FORCE_INLINE_ T *_inline_ptr() { return reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ const T *_inline_ptr() const { return reinterpret_cast<const T *>(inline_data); }
+	_FORCE_INLINE_ bool _is_inline() const { return heap.is_empty(); }
+
+	void _move_to_heap() {
+		if (inline_size == 0) {
+			return;
+		}
+		heap.resize(inline_size);
+		T *dst = heap.ptrw();
+		T *src = _inline_ptr();
+		for (uint32_t i = 0; i < inline_size; i++) {
+			dst[i] = std::move(src[i]);
+			src[i].~T();
+		}
+		inline_size = 0;
+	}
+
+	template <bool p_initialize>
+	Error _resize(Size p_size) {
+		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
+
+		if (_is_inline()) {
+			if (p_size <= INLINE_CAPACITY) {
+				T *p = _inline_ptr();
+				if constexpr (!std::is_trivially_destructible_v<T>) {
+					for (Size i = p_size; i < inline_size; i++) {
+						p[i].~T();
+					}
+				}
+				for (Size i = inline_size; i < p_size; i++) {
+					if constexpr (!std::is_trivially_constructible_v<T>) {
+						memnew_placement(p + i, T);
+					} else if constexpr (p_initialize) {
+						memset((void *)(p + i), 0, sizeof(T));
+					}
+				}
+				inline_size = p_size;
+				return OK;
+			}
+			_move_to_heap();
+		}
+
+		if constexpr (p_initialize) {
+			return heap.resize_initialized(p_size);
+		} else {
+			return heap.resize(p_size);
+		}
+	}
+
+	void _copy_from(const T *p_from, Size p_size) {
+		T *p = _inline_ptr();
+		for (Size i = 0; i < p_size; i++) {
+			memnew_placement(p + i, T(p_from[i]));
+		}
+		inline_size = p_size;
+	}
+
+public:
+	_FORCE_INLINE_ const T *ptr() const { return _is_inline() ? _inline_ptr() : heap.ptr(); }
+	_FORCE_INLINE_ T *ptrw() { return _is_inline() ? _inline_ptr() : heap.ptrw(); }
+	_FORCE_INLINE_ Size size() const { return _is_inline() ? Size(inline_size) : heap.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+	_FORCE_INLINE_ Span<T> span() const { return Span<T>(ptr(), size()); }
+	_FORCE_INLINE_ operator Span<T>() const { return span(); }
+
+	// Whether the elements are currently stored inline, mostly for tests.
+	_FORCE_INLINE_ bool is_inline() const { return _is_inline(); }
+
+	_FORCE_INLINE_ const T &get(Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ const T &operator[](Size p_index) const { return get(p_index); }
+	_FORCE_INLINE_ void set(Size p_index, const T &p_elem) {
+		ERR_FAIL_INDEX(p_index, size());
+		ptrw()[p_index] = p_elem;
+	}
+
+	_FORCE_INLINE_ Error resize(Size p_size) { return _resize<false>(p_size); }
+	_FORCE_INLINE_ Error resize_initialized(Size p_size) { return _resize<true>(p_size); }
+
+	void clear() {
+		if (_is_inline()) {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				T *p = _inline_ptr();
+				for (uint32_t i = 0; i < inline_size; i++) {
+					p[i].~T();
+				}
+			}
+			inline_size = 0;
+		} else {
+			heap.clear();
+		}
+	}
+
+	bool push_back(T p_elem) {
+		if (_is_inline()) {
+			if (inline_size < INLINE_CAPACITY) {
+				memnew_placement(_inline_ptr() + inline_size, T(std::move(p_elem)));
+				inline_size++;
+				return false;
+			}
+			_move_to_heap();
+		}
+		return heap.push_back(std::move(p_elem));
+	}
+
+	Error insert(Size p_pos, T p_val) {
+		ERR_FAIL_INDEX_V(p_pos, size() + 1, ERR_INVALID_PARAMETER);
+		if (_is_inline()) {
+			if (inline_size < INLINE_CAPACITY) {
+				T *p = _inline_ptr();
+				if (p_pos == inline_size) {
+					memnew_placement(p + inline_size, T(std::move(p_val)));
+				} else {
+					memnew_placement(p + inline_size, T(std::move(p[inline_size - 1])));
+					for (Size i = inline_size - 1; i > p_pos; i--) {
+						p[i] = std::move(p[i - 1]);
+					}
+					p[p_pos] = std::move(p_val);
+				}
+				inline_size++;
+				return OK;
+			}
+			_move_to_heap();
+		}
+		return heap.insert(p_pos, std::move(p_val));
+	}
+
+	void remove_at(Size p_index) {
+		if (!_is_inline()) {
+			heap.remove_at(p_index);
+			return;
+		}
+		ERR_FAIL_INDEX(p_index, inline_size);
+		T *p = _inline_ptr();
+		for (uint32_t i = p_index; i + 1 < inline_size; i++) {
+			p[i] = std::move(p[i + 1]);
+		}
+		inline_size--;
+		p[inline_size].~T();
+	}
+
+	Size find(const T &p_val, Size p_from = 0) const {
+		if (p_from < 0) {
+			return -1;
+		}
+		return span().find(p_val, p_from);
+	}
+
+	bool erase(const T &p_val) {
+		Size idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	void fill(T p_elem) {
+		T *p = ptrw();
+		for (Size i = 0; i < size(); i++) {
+			p[i] = p_elem;
+		}
+	}
+
+	void reverse() {
+		T *p = ptrw();
+		for (Size i = 0; i < size() / 2; i++) {
+			SWAP(p[i], p[size() - i - 1]);
+		}
+	}
+
+	// Takes a copy, so appending to itself works.
+	void append_array(SmallVector p_other) {
+		const Size ds = p_other.size();
+		if (ds == 0) {
+			return;
+		}
+		const Size bs = size();
+		resize(bs + ds);
+		T *p = ptrw();
+		const T *src = p_other.ptr();
+		for (Size i = 0; i < ds; ++i) {
+			p[bs + i] = src[i];
+		}
+	}
+
+	template <typename Comparator, bool Validate = SORT_ARRAY_VALIDATE_ENABLED, typename... Args>
+	void sort_custom(Args &&...args) {
+		Size len = size();
+		if (len == 0) {
+			return;
+		}
+
+		T *data = ptrw();
+		SortArray<T, Comparator, Validate> sorter{ args... };
+		sorter.sort(data, len);
+	}
+
+	template <typename Comparator, typename Value, typename... Args>
+	Size bsearch_custom(const Value &p_value, bool p_before, Args &&...args) {
+		return span().bisect(p_value, p_before, Comparator{ args... });
+	}
+
+	void operator=(const SmallVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		if (p_from._is_inline()) {
+			_copy_from(p_from._inline_ptr(), p_from.inline_size);
+		} else {
+			heap = p_from.heap;
+		}
+	}
+
+	void operator=(const Vector<T> &p_from) {
+		clear();
+		if (p_from.size() <= INLINE_CAPACITY) {
+			_copy_from(p_from.ptr(), p_from.size());
+		} else {
+			heap = p_from;
+		}
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	SmallVector(std::initializer_list<T> p_init) {
+		if (p_init.size() <= INLINE_CAPACITY) {
+			_copy_from(p_init.begin(), p_init.size());
+		} else {
+			heap = Vector<T>(p_init);
+		}
+	}
+	SmallVector(const SmallVector &p_from) {
+		if (p_from._is_inline()) {
+			_copy_from(p_from._inline_ptr(), p_from.inline_size);
+		} else {
+			heap = p_from.heap;
+		}
+	}
+
+	_FORCE_INLINE_ ~SmallVector() {
+		clear();
+	}
+};
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  work_stealing_deque.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded Chase-Lev work-stealing deque (see "Correct and Efficient Work-Stealing
+// for Weak Memory Models", Lê et al., 2013).
+// The owner thread pushes and pops at the bottom end (LIFO, which keeps caches warm),
+// while any other thread may steal from the top end (FIFO). Neither operation blocks.
+// The capacity is fixed, so push() can fail; callers are expected to have a fallback.
+// T must be a pointer type (or any type whose zero value can act as "none").
+template <typename T, uint32_t CAPACITY = 256>
+class WorkStealingDeque {
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "WorkStealingDeque capacity must be a power of two.");
+	static_assert(std::atomic<T>::is_always_lock_free);
+	static constexpr int64_t MASK = CAPACITY - 1;
+
+	// Top and bottom are written by different threads, so keep them in separate cache lines.
+	std::atomic<int64_t> top = 0;
+	char padding_top[Thread::CACHE_LINE_BYTES - sizeof(std::atomic<int64_t>)];
+	std::atomic<int64_t> bottom = 0;
+	char padding_bottom[Thread::CACHE_LINE_BYTES - sizeof(std::atomic<int64_t>)];
+	std::atomic<T> buffer[CAPACITY] = {};
+
+public:
+	// Owner thread only. Returns false if the deque is full.
+	_FORCE_INLINE_ bool push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (unlikely(b - t >= (int64_t)CAPACITY)) {
+			return false;
+		}
+		buffer[b & MASK].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Owner thread only. Returns the most recently pushed value, or a zero value if empty.
+	_FORCE_INLINE_ T pop() {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		T value = T();
+		if (t <= b) {
+			value = buffer[b & MASK].load(std::memory_order_relaxed);
+			if (t == b) {
+				// Last element; race against thieves for it.
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					value = T();
+				}
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+		} else {
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return value;
+	}
+
+	// Any thread. Returns the oldest value, or a zero value if empty or if another thread won the race for it.
+	_FORCE_INLINE_ T steal() {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t < b) {
+			T value = buffer[t & MASK].load(std::memory_order_relaxed);
+			if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return value;
+			}
+		}
+		return T();
+	}
+
+	// Approximate when called from threads other than the owner.
+	_FORCE_INLINE_ uint32_t size() const {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? uint32_t(b - t) : 0;
+	}
+
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+	static constexpr uint32_t get_capacity() { return CAPACITY; }
+};
@@ -34,14 +34,22 @@
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
 #include "core/templates/hashfuncs.h"
+#include "core/templates/small_vector.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
 
 struct ArrayPrivate {
+	// Most arrays are tiny, like the ones returned by scripts or passed as call arguments,
+	// so those are kept inline to save an allocation.
+	static constexpr uint32_t INLINE_CAPACITY = 4;
+	typedef SmallVector<Variant, INLINE_CAPACITY> Storage;
+
+	// The C# glue reads the first three fields directly, see godot_array in InteropStructs.cs.
+	// read_only comes before the array, so its offset doesn't depend on the size of Variant.
 	SafeRefCount refcount;
-	Vector<Variant> array;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
+	Storage array;
 	ContainerTypeValidate typed;
 
 	ArrayPrivate() {}
@@ -135,12 +143,12 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 	if (_p == p_array._p) {
 		return true;
 	}
-	const Vector<Variant> &a1 = _p->array;
-	const Vector<Variant> &a2 = p_array._p->array;
-	const int size = a1.size();
-	if (size != a2.size()) {
+	const int size = _p->array.size();
+	if (size != p_array._p->array.size()) {
 		return false;
 	}
+	const Variant *a1 = _p->array.ptr();
+	const Variant *a2 = p_array._p->array.ptr();
 
 	// Heavy O(n) check
 	if (recursion_count > MAX_RECURSION) {
@@ -290,7 +298,7 @@ void Array::append_array(const Array &p_array) {
 		return;
 	}
 
-	Vector<Variant> validated_array = p_array._p->array;
+	ArrayPrivate::Storage validated_array = p_array._p->array;
 	Variant *write = validated_array.ptrw();
 	for (int i = 0; i < validated_array.size(); ++i) {
 		ERR_FAIL_COND(!_p->typed.validate(write[i], "append_array"));
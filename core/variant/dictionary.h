@@ -31,8 +31,8 @@
 #pragma once
 
 #include "core/string/ustring.h"
-#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/ordered_hash_map.h"
 #include "core/templates/pair.h"
 #include "core/variant/array.h"
 #include "core/variant/variant_deep_duplicate.h"
@@ -52,7 +52,7 @@ class Dictionary {
 	void _unref() const;
 
 public:
-	using ConstIterator = HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator;
+	using ConstIterator = OrderedHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator;
 
 	ConstIterator begin() const;
 	ConstIterator end() const;
@@ -313,6 +313,10 @@ void ScriptEditorDebugger::_video_mem_export() {
 	file_dialog->popup_file_dialog();
 }
 
+void ScriptEditorDebugger::_memory_tags_request() {
+	_put_msg("memory_tags", Array());
+}
+
 Size2 ScriptEditorDebugger::get_minimum_size() const {
 	Size2 ms = MarginContainer::get_minimum_size();
 	ms.y = MAX(ms.y, 250 * EDSCALE);
@@ -472,6 +476,45 @@ void ScriptEditorDebugger::_msg_servers_memory_usage(uint64_t p_thread_id, const
 	vmem_total->set_text(String::humanize_size(total));
 }
 
+void ScriptEditorDebugger::_msg_memory_tags(uint64_t p_thread_id, const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() < 2);
+	mem_tags_tree->clear();
+	TreeItem *root = mem_tags_tree->create_item();
+	HashMap<String, TreeItem *> tag_items;
+
+	const Array tags = p_data[0];
+	for (const Variant &v : tags) {
+		const Array tag = v;
+		ERR_CONTINUE(tag.size() < 4);
+		TreeItem *it = mem_tags_tree->create_item(root);
+		it->set_text(0, tag[0]);
+		it->set_text(1, String::humanize_size(tag[1]));
+		it->set_tooltip_text(1, TTR("Bytes:") + " " + itos(tag[1]));
+		it->set_text(2, String::humanize_size(tag[2]));
+		it->set_tooltip_text(2, TTR("Bytes:") + " " + itos(tag[2]));
+		it->set_text(3, itos(tag[3]));
+		tag_items[tag[0]] = it;
+	}
+
+	// Large allocation samples go below their tag, with their backtrace collapsed below them.
+	const Array large_allocs = p_data[1];
+	for (const Variant &v : large_allocs) {
+		const Array sample = v;
+		ERR_CONTINUE(sample.size() < 3);
+		TreeItem **tag_item = tag_items.getptr(sample[0]);
+		ERR_CONTINUE(!tag_item);
+		TreeItem *it = mem_tags_tree->create_item(*tag_item);
+		it->set_text(0, TTR("Large Allocation"));
+		it->set_text(1, String::humanize_size(sample[1]));
+		it->set_tooltip_text(1, TTR("Bytes:") + " " + itos(sample[1]));
+		it->set_collapsed(true);
+		const PackedStringArray frames = sample[2];
+		for (const String &frame : frames) {
+			mem_tags_tree->create_item(it)->set_text(0, frame);
+		}
+	}
+}
+
 void ScriptEditorDebugger::_msg_servers_drawn(uint64_t p_thread_id, const Array &p_data) {
 	can_request_idle_draw = true;
 }
@@ -953,6 +996,7 @@ void ScriptEditorDebugger::_init_parse_message_handlers() {
 	parse_message_handlers["scene:scene_tree"] = &ScriptEditorDebugger::_msg_scene_scene_tree;
 	parse_message_handlers["scene:inspect_objects"] = &ScriptEditorDebugger::_msg_scene_inspect_objects;
 	parse_message_handlers["servers:memory_usage"] = &ScriptEditorDebugger::_msg_servers_memory_usage;
+	parse_message_handlers["memory_tags"] = &ScriptEditorDebugger::_msg_memory_tags;
 	parse_message_handlers["servers:drawn"] = &ScriptEditorDebugger::_msg_servers_drawn;
 	parse_message_handlers["stack_dump"] = &ScriptEditorDebugger::_msg_stack_dump;
 	parse_message_handlers["stack_frame_vars"] = &ScriptEditorDebugger::_msg_stack_frame_vars;
@@ -1054,6 +1098,7 @@ void ScriptEditorDebugger::_notification(int p_what) {
 			vmem_notice_icon->set_texture(get_editor_theme_icon(SNAME("NodeInfo")));
 			vmem_refresh->set_button_icon(get_editor_theme_icon(SNAME("Reload")));
 			vmem_export->set_button_icon(get_editor_theme_icon(SNAME("Save")));
+			mem_tags_refresh->set_button_icon(get_editor_theme_icon(SNAME("Reload")));
 			search->set_right_icon(get_editor_theme_icon(SNAME("Search")));
 
 			reason->add_theme_color_override(SNAME("default_color"), get_theme_color(SNAME("error_color"), EditorStringName(Editor)));
@@ -1219,6 +1264,7 @@ void ScriptEditorDebugger::_update_buttons_state() {
 	const bool active = is_session_active();
 	const bool has_editor_tree = active && editor_remote_tree && editor_remote_tree->get_selected();
 	vmem_refresh->set_disabled(!active);
+	mem_tags_refresh->set_disabled(!active);
 	step->set_disabled(!active || !is_breaked() || !is_debuggable());
 	next->set_disabled(!active || !is_breaked() || !is_debuggable());
 	copy->set_disabled(!active || !is_breaked());
@@ -1906,6 +1952,8 @@ void ScriptEditorDebugger::_tab_changed(int p_tab) {
 	if (tabs->get_tab_title(p_tab) == TTR("Video RAM")) {
 		// "Video RAM" tab was clicked, refresh the data it's displaying when entering the tab.
 		_video_mem_request();
+	} else if (tabs->get_tab_title(p_tab) == TTR("Memory")) {
+		_memory_tags_request();
 	}
 }
 
@@ -2300,6 +2348,48 @@ Instead, use the monitors tab to obtain more precise VRAM usage.
 		tabs->add_child(vmem_vb);
 	}
 
+	{ // memory tags
+		VBoxContainer *mem_tags_vb = memnew(VBoxContainer);
+		HBoxContainer *mem_tags_hb = memnew(HBoxContainer);
+
+		Label *mtlb = memnew(Label(TTRC("Memory Usage by Engine Subsystem:")));
+		mtlb->set_theme_type_variation("HeaderSmall");
+		mtlb->set_h_size_flags(SIZE_EXPAND_FILL);
+		mtlb->set_tooltip_text(TTR("Only available in debug builds, and in release builds compiled with memory_tags=yes."));
+		mtlb->set_mouse_filter(MOUSE_FILTER_PASS);
+		mem_tags_hb->add_child(mtlb);
+
+		mem_tags_refresh = memnew(Button);
+		mem_tags_refresh->set_accessibility_name(TTRC("Refresh Memory Usage"));
+		mem_tags_refresh->set_theme_type_variation(SceneStringName(FlatButton));
+		mem_tags_hb->add_child(mem_tags_refresh);
+		mem_tags_vb->add_child(mem_tags_hb);
+		mem_tags_refresh->connect(SceneStringName(pressed), callable_mp(this, &ScriptEditorDebugger::_memory_tags_request));
+
+		mem_tags_tree = memnew(Tree);
+		mem_tags_tree->set_v_size_flags(SIZE_EXPAND_FILL);
+		mem_tags_tree->set_h_size_flags(SIZE_EXPAND_FILL);
+		mem_tags_vb->add_child(mem_tags_tree);
+
+		mem_tags_vb->set_name(TTR("Memory"));
+		mem_tags_tree->set_columns(4);
+		mem_tags_tree->set_column_titles_visible(true);
+		mem_tags_tree->set_column_title(0, TTR("Tag"));
+		mem_tags_tree->set_column_expand(0, true);
+		mem_tags_tree->set_column_expand(1, false);
+		mem_tags_tree->set_column_title(1, TTR("Usage"));
+		mem_tags_tree->set_column_custom_minimum_width(1, 100 * EDSCALE);
+		mem_tags_tree->set_column_expand(2, false);
+		mem_tags_tree->set_column_title(2, TTR("Peak"));
+		mem_tags_tree->set_column_custom_minimum_width(2, 100 * EDSCALE);
+		mem_tags_tree->set_column_expand(3, false);
+		mem_tags_tree->set_column_title(3, TTR("Allocations"));
+		mem_tags_tree->set_column_custom_minimum_width(3, 100 * EDSCALE);
+		mem_tags_tree->set_hide_root(true);
+
+		tabs->add_child(mem_tags_vb);
+	}
+
 	{ // misc
 		VBoxContainer *misc = memnew(VBoxContainer);
 		misc->set_name(TTR("Misc"));
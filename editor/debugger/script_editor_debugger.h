@@ -139,6 +139,9 @@ private:
 	LineEdit *vmem_total = nullptr;
 	TextureRect *vmem_notice_icon = nullptr;
 
+	Tree *mem_tags_tree = nullptr;
+	Button *mem_tags_refresh = nullptr;
+
 	Tree *stack_dump = nullptr;
 	LineEdit *search = nullptr;
 	OptionButton *threads = nullptr;
@@ -204,6 +207,7 @@ private:
 	void _msg_scene_scene_tree(uint64_t p_thread_id, const Array &p_data);
 	void _msg_scene_inspect_objects(uint64_t p_thread_id, const Array &p_data);
 	void _msg_servers_memory_usage(uint64_t p_thread_id, const Array &p_data);
+	void _msg_memory_tags(uint64_t p_thread_id, const Array &p_data);
 	void _msg_servers_drawn(uint64_t p_thread_id, const Array &p_data);
 	void _msg_stack_dump(uint64_t p_thread_id, const Array &p_data);
 	void _msg_stack_frame_vars(uint64_t p_thread_id, const Array &p_data);
@@ -239,6 +243,7 @@ private:
 
 	void _video_mem_request();
 	void _video_mem_export();
+	void _memory_tags_request();
 
 	void _resources_reimported(const PackedStringArray &p_resources);
 
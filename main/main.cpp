@@ -46,12 +46,15 @@
 #include "core/io/image_loader.h"
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
+#include "core/object/frame_task_graph.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
+#include "core/os/slab_allocator.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
 #include "core/string/translation_server.h"
+#include "core/templates/command_queue_mt.h"
 #include "core/version.h"
 #include "drivers/register_driver_types.h"
 #include "main/app_icon.gen.h"
@@ -142,6 +145,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -163,6 +167,7 @@ static PackedData *packed_data = nullptr;
 static ZipArchive *zip_packed_data = nullptr;
 #endif
 static MessageQueue *message_queue = nullptr;
+static FrameTaskGraph *frame_task_graph = nullptr;
 
 #if defined(STEAMAPI_ENABLED)
 static SteamTracker *steam_tracker = nullptr;
@@ -259,6 +264,9 @@ static bool force_res = false;
 // Debug
 
 static bool use_debug_profiler = false;
+#ifdef MODULE_GDSCRIPT_ENABLED
+static String gdscript_profile_output;
+#endif
 #ifdef DEBUG_ENABLED
 static bool debug_collisions = false;
 static bool debug_paths = false;
@@ -628,6 +636,9 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--profile-output <file>", "Sample GDScript call stacks while running and write them to <file> in collapsed-stack format on exit (for flame graphs).\n");
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -655,6 +666,9 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--disable-vsync", "Forces disabling of vertical synchronization, even if enabled in the project settings. Does not override driver-level V-Sync enforcement.\n");
 	print_help_option("--disable-render-loop", "Disable render loop so rendering only occurs when called explicitly from script.\n");
 	print_help_option("--disable-crash-handler", "Disable crash handler when supported by the platform code.\n");
+#ifdef SLAB_ALLOCATOR_ENABLED
+	print_help_option("--disable-slab-allocator", "Serve small allocations from the system allocator instead of the built-in slab allocator.\n");
+#endif
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
@@ -1421,6 +1435,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 			use_debug_profiler = true;
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (arg == "--profile-output") {
+			if (N) {
+				gdscript_profile_output = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing profile output file path argument, aborting.\n");
+				goto error;
+			}
+#endif // MODULE_GDSCRIPT_ENABLED
 		} else if (arg == "-l" || arg == "--language") { // language
 
 			if (N) {
@@ -1811,6 +1835,11 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			profile_gpu = true;
 		} else if (arg == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
+#ifdef SLAB_ALLOCATOR_ENABLED
+		} else if (arg == "--disable-slab-allocator") {
+			// Blocks allocated so far remember where they came from, so they are still freed correctly.
+			SlabAllocator::set_enabled(false);
+#endif
 		} else if (arg == "--skip-breakpoints") {
 			skip_breakpoints = true;
 		} else if (I->get() == "--ignore-error-breaks") {
@@ -1961,6 +1990,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 #endif
 	}
 
+	if (!editor && !project_manager && GLOBAL_GET("threading/frame_task_graph/enabled")) {
+		frame_task_graph = memnew(FrameTaskGraph);
+	}
+
 #ifdef TOOLS_ENABLED
 	if (!project_manager && !editor) {
 		// If we didn't find a project, we fall back to the project manager.
@@ -2083,6 +2116,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("debug/settings/stdout/print_gpu_profile", false);
 	GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
 	GLOBAL_DEF("debug/settings/physics_interpolation/enable_warnings", true);
+	Memory::set_large_alloc_sampling(
+			GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/memory/large_allocation_sample_threshold", PROPERTY_HINT_RANGE, "0,1073741824,1,or_greater,suffix:B"), 16 * 1024 * 1024),
+			GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/memory/large_allocation_sample_interval", PROPERTY_HINT_RANGE, "1,1000,1,or_greater"), 1));
 	if (!OS::get_singleton()->_verbose_stdout) { // Not manually overridden.
 		OS::get_singleton()->_verbose_stdout = GLOBAL_GET("debug/settings/stdout/verbose_stdout");
 	}
@@ -3735,6 +3771,12 @@ Error Main::setup2(bool p_show_boot_logo) {
 		EngineDebugger::get_singleton()->profiler_enable("scripts", true);
 	}
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+	if (!gdscript_profile_output.is_empty() && GDScriptSamplingProfiler::get_singleton()) {
+		GDScriptSamplingProfiler::get_singleton()->start();
+	}
+#endif
+
 	if (!project_manager) {
 		// If not running the project manager, and now that the engine is
 		// able to load resources, load the global shader variables.
@@ -4671,6 +4713,46 @@ static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
+static void _flush_message_queue() {
+	message_queue->flush();
+}
+
+// Runs the navigation and physics steps of a physics tick as a graph, so the stages that don't depend
+// on each other overlap. Returns the time spent in navigation stages.
+static uint64_t _physics_step_frame_graph(double p_step) {
+	// Same order as the serial loop: navigation callbacks and the calls they defer run before physics steps.
+#ifndef NAVIGATION_2D_DISABLED
+	NavigationServer2D::get_singleton()->add_physics_process_frame_stages(*frame_task_graph, p_step);
+#endif // NAVIGATION_2D_DISABLED
+#ifndef NAVIGATION_3D_DISABLED
+	NavigationServer3D::get_singleton()->add_physics_process_frame_stages(*frame_task_graph, p_step);
+#endif // NAVIGATION_3D_DISABLED
+	FrameTaskGraph::StageID navigation_end = frame_task_graph->get_stage_count();
+
+#if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+	frame_task_graph->add_stage(SNAME("Flush message queue"), callable_mp_static(&_flush_message_queue), {}, {}, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD | FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+#endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+
+#ifndef PHYSICS_3D_DISABLED
+	PhysicsServer3D::get_singleton()->end_sync();
+	PhysicsServer3D::get_singleton()->add_step_frame_stages(*frame_task_graph, p_step);
+#endif // PHYSICS_3D_DISABLED
+#ifndef PHYSICS_2D_DISABLED
+	PhysicsServer2D::get_singleton()->end_sync();
+	PhysicsServer2D::get_singleton()->add_step_frame_stages(*frame_task_graph, p_step);
+#endif // PHYSICS_2D_DISABLED
+
+	frame_task_graph->run();
+
+	uint64_t navigation_ticks = 0;
+	for (FrameTaskGraph::StageID i = 0; i < navigation_end; i++) {
+		navigation_ticks += frame_task_graph->get_stage_time_usec(i);
+	}
+	frame_task_graph->clear();
+
+	return navigation_ticks;
+}
+
 // Return false means iterating further, returning true means `OS::run`
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
@@ -4757,31 +4839,41 @@ bool Main::iteration() {
 			break;
 		}
 
+		if (frame_task_graph) {
 #if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
-		uint64_t navigation_begin = OS::get_singleton()->get_ticks_usec();
+			uint64_t navigation_ticks = _physics_step_frame_graph(physics_step * time_scale);
+			navigation_process_ticks = MAX(navigation_process_ticks, navigation_ticks);
+			navigation_process_max = MAX(navigation_ticks, navigation_process_max);
+#else
+			_physics_step_frame_graph(physics_step * time_scale);
+#endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+		} else {
+#if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+			uint64_t navigation_begin = OS::get_singleton()->get_ticks_usec();
 
 #ifndef NAVIGATION_2D_DISABLED
-		NavigationServer2D::get_singleton()->physics_process(physics_step * time_scale);
+			NavigationServer2D::get_singleton()->physics_process(physics_step * time_scale);
 #endif // NAVIGATION_2D_DISABLED
 #ifndef NAVIGATION_3D_DISABLED
-		NavigationServer3D::get_singleton()->physics_process(physics_step * time_scale);
+			NavigationServer3D::get_singleton()->physics_process(physics_step * time_scale);
 #endif // NAVIGATION_3D_DISABLED
 
-		navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
-		navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
+			navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
+			navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
 
-		message_queue->flush();
+			message_queue->flush();
 #endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 
 #ifndef PHYSICS_3D_DISABLED
-		PhysicsServer3D::get_singleton()->end_sync();
-		PhysicsServer3D::get_singleton()->step(physics_step * time_scale);
+			PhysicsServer3D::get_singleton()->end_sync();
+			PhysicsServer3D::get_singleton()->step(physics_step * time_scale);
 #endif // PHYSICS_3D_DISABLED
 
 #ifndef PHYSICS_2D_DISABLED
-		PhysicsServer2D::get_singleton()->end_sync();
-		PhysicsServer2D::get_singleton()->step(physics_step * time_scale);
+			PhysicsServer2D::get_singleton()->end_sync();
+			PhysicsServer2D::get_singleton()->step(physics_step * time_scale);
 #endif // PHYSICS_2D_DISABLED
+		}
 
 		message_queue->flush();
 
@@ -4869,6 +4961,11 @@ bool Main::iteration() {
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
 		performance->set_navigation_process_time(USEC_TO_SEC(navigation_process_max));
+		uint32_t command_queue_max_commands_per_flush = 0;
+		uint64_t command_queue_stall_usec = 0;
+		CommandQueueMT::get_and_reset_stats(command_queue_max_commands_per_flush, command_queue_stall_usec);
+		performance->set_command_queue_stats(command_queue_max_commands_per_flush, USEC_TO_SEC(command_queue_stall_usec));
+		performance->update_memory_tag_alloc_rates();
 		process_max = 0;
 		physics_process_max = 0;
 		navigation_process_max = 0;
@@ -4981,6 +5078,11 @@ void Main::cleanup(bool p_force) {
 	// Flush before uninitializing the scene, but delete the MessageQueue as late as possible.
 	message_queue->flush();
 
+	if (frame_task_graph) {
+		memdelete(frame_task_graph);
+		frame_task_graph = nullptr;
+	}
+
 	OS::get_singleton()->delete_main_loop();
 
 	OS::get_singleton()->_cmdline.clear();
@@ -4992,6 +5094,13 @@ void Main::cleanup(bool p_force) {
 
 	WorkerThreadPool::get_singleton()->exit_languages_threads();
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+	if (!gdscript_profile_output.is_empty() && GDScriptSamplingProfiler::get_singleton()) {
+		GDScriptSamplingProfiler::get_singleton()->stop();
+		GDScriptSamplingProfiler::get_singleton()->save_collapsed_stacks(gdscript_profile_output);
+	}
+#endif
+
 	ScriptServer::finish_languages();
 
 	// Sync pending commands that may have been queued from a different thread during ScriptServer finalization
@@ -129,6 +129,18 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_MAX_COMMANDS_PER_FLUSH);
+	BIND_ENUM_CONSTANT(COMMAND_QUEUE_STALL_TIME);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPT);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPT_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES_ALLOCS);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO_ALLOCS);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -209,6 +221,18 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("command_queue/max_commands_per_flush"),
+		PNAME("command_queue/stall_time"),
+		PNAME("memory/rendering"),
+		PNAME("memory/physics"),
+		PNAME("memory/script"),
+		PNAME("memory/resources"),
+		PNAME("memory/audio"),
+		PNAME("memory/rendering_allocs"),
+		PNAME("memory/physics_allocs"),
+		PNAME("memory/script_allocs"),
+		PNAME("memory/resources_allocs"),
+		PNAME("memory/audio_allocs"),
 	};
 	static_assert(std::size(names) == MONITOR_MAX);
 
@@ -432,6 +456,30 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case COMMAND_QUEUE_MAX_COMMANDS_PER_FLUSH:
+			return _command_queue_max_commands_per_flush;
+		case COMMAND_QUEUE_STALL_TIME:
+			return _command_queue_stall_time;
+		case MEMORY_RENDERING:
+			return Memory::get_tag_usage(Memory::TAG_RENDERING);
+		case MEMORY_PHYSICS:
+			return Memory::get_tag_usage(Memory::TAG_PHYSICS);
+		case MEMORY_SCRIPT:
+			return Memory::get_tag_usage(Memory::TAG_SCRIPT);
+		case MEMORY_RESOURCES:
+			return Memory::get_tag_usage(Memory::TAG_RESOURCES);
+		case MEMORY_AUDIO:
+			return Memory::get_tag_usage(Memory::TAG_AUDIO);
+		case MEMORY_RENDERING_ALLOCS:
+			return _memory_tag_alloc_rate[Memory::TAG_RENDERING];
+		case MEMORY_PHYSICS_ALLOCS:
+			return _memory_tag_alloc_rate[Memory::TAG_PHYSICS];
+		case MEMORY_SCRIPT_ALLOCS:
+			return _memory_tag_alloc_rate[Memory::TAG_SCRIPT];
+		case MEMORY_RESOURCES_ALLOCS:
+			return _memory_tag_alloc_rate[Memory::TAG_RESOURCES];
+		case MEMORY_AUDIO_ALLOCS:
+			return _memory_tag_alloc_rate[Memory::TAG_AUDIO];
 
 		default: {
 		}
@@ -503,6 +551,18 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
@@ -522,6 +582,19 @@ void Performance::set_navigation_process_time(double p_pt) {
 	_navigation_process_time = p_pt;
 }
 
+void Performance::set_command_queue_stats(uint32_t p_max_commands_per_flush, double p_stall_time) {
+	_command_queue_max_commands_per_flush = p_max_commands_per_flush;
+	_command_queue_stall_time = p_stall_time;
+}
+
+void Performance::update_memory_tag_alloc_rates() {
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		uint64_t alloc_count = Memory::get_tag_alloc_count(Memory::Tag(i));
+		_memory_tag_alloc_rate[i] = alloc_count - _memory_tag_alloc_count[i];
+		_memory_tag_alloc_count[i] = alloc_count;
+	}
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -569,6 +642,12 @@ Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_navigation_process_time = 0;
+	_command_queue_max_commands_per_flush = 0;
+	_command_queue_stall_time = 0;
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		_memory_tag_alloc_count[i] = Memory::get_tag_alloc_count(Memory::Tag(i));
+		_memory_tag_alloc_rate[i] = 0;
+	}
 	_monitor_modification_time = 0;
 	singleton = this;
 }
@@ -50,6 +50,10 @@ class Performance : public Object {
 	double _process_time;
 	double _physics_process_time;
 	double _navigation_process_time;
+	uint32_t _command_queue_max_commands_per_flush;
+	double _command_queue_stall_time;
+	uint64_t _memory_tag_alloc_count[Memory::TAG_MAX];
+	uint64_t _memory_tag_alloc_rate[Memory::TAG_MAX];
 
 	class MonitorCall {
 		Callable _callable;
@@ -125,6 +129,18 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		COMMAND_QUEUE_MAX_COMMANDS_PER_FLUSH,
+		COMMAND_QUEUE_STALL_TIME,
+		MEMORY_RENDERING,
+		MEMORY_PHYSICS,
+		MEMORY_SCRIPT,
+		MEMORY_RESOURCES,
+		MEMORY_AUDIO,
+		MEMORY_RENDERING_ALLOCS,
+		MEMORY_PHYSICS_ALLOCS,
+		MEMORY_SCRIPT_ALLOCS,
+		MEMORY_RESOURCES_ALLOCS,
+		MEMORY_AUDIO_ALLOCS,
 		MONITOR_MAX
 	};
 
@@ -142,6 +158,8 @@ public:
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
+	void set_command_queue_stats(uint32_t p_max_commands_per_flush, double p_stall_time);
+	void update_memory_tag_alloc_rates();
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -33,6 +33,7 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -1539,6 +1540,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptInlineCache::invalidate_all();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -1651,6 +1653,8 @@ GDScript::~GDScript() {
 		return;
 	}
 	destructing = true;
+	// Inline caches may be keyed on this script.
+	GDScriptInlineCache::invalidate_all();
 
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
@@ -2934,6 +2938,25 @@ GDScriptLanguage::CallLevel *GDScriptLanguage::_get_stack_level(uint32_t p_level
 	return level;
 }
 
+String GDScriptLanguage::get_folded_call_stack() const {
+	LocalVector<const GDScriptFunction *> functions;
+	functions.reserve(_call_stack_size);
+	for (CallLevel *cl = _call_stack; cl; cl = cl->prev) {
+		if (cl->function) {
+			functions.push_back(cl->function);
+		}
+	}
+
+	String folded;
+	for (int64_t i = int64_t(functions.size()) - 1; i >= 0; i--) {
+		if (!folded.is_empty()) {
+			folded += ";";
+		}
+		folded += String(functions[i]->get_source()) + ":" + String(functions[i]->get_name());
+	}
+	return folded;
+}
+
 GDScriptLanguage::GDScriptLanguage() {
 	ERR_FAIL_COND(singleton);
 	singleton = this;
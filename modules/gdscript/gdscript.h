@@ -83,6 +83,7 @@ class GDScript : public Script {
 
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptAnalyzer;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
@@ -361,6 +362,7 @@ public:
 class GDScriptInstance : public ScriptInstance {
 	friend class GDScript;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptCompiler;
@@ -564,6 +566,10 @@ public:
 		return csi;
 	}
 
+	// The current thread's call stack as `file:function` frames joined with ';',
+	// outermost first, which is the collapsed-stack profile format.
+	String get_folded_call_stack() const;
+
 	struct {
 		StringName _init;
 		StringName _static_init;
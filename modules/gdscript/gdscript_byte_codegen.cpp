@@ -30,8 +30,12 @@
 
 #include "gdscript_byte_codegen.h"
 
+#include "gdscript_inline_cache.h"
+
 #include "core/debugger/engine_debugger.h"
 
+SafeFlag GDScriptByteCodeGenerator::optimizations_enabled(true);
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -150,6 +154,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		last_jump_target = opcodes.size();
 	}
 }
 
@@ -159,6 +164,7 @@ void GDScriptByteCodeGenerator::end_parameters() {
 
 void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) {
 	function = memnew(GDScriptFunction);
+	optimize = optimizations_enabled.is_set();
 
 	function->name = p_function_name;
 	function->_script = p_script;
@@ -392,12 +398,26 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
 
+#ifndef DEBUG_ENABLED
+	if (GDScriptNativeFunctions::has_registrations()) {
+		function->_native_function = GDScriptNativeFunctions::find(function);
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
 	function->setter_names = setter_names;
@@ -602,8 +622,8 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	if (valid) {
+		Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 		if (p_target.mode == Address::TEMPORARY) {
-			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
 			if (result_type != temp_type) {
 				write_type_adjust(p_target, result_type);
@@ -613,6 +633,11 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		// Remember the instruction, a conditional jump on its result may be fused into it.
+		last_validated_operator_pos = opcodes.size();
+		last_validated_operator_target = p_target;
+		last_validated_operator_type = result_type;
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -690,16 +715,35 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 	}
 }
 
+bool GDScriptByteCodeGenerator::fuse_jump_condition(const Address &p_condition, GDScriptFunction::Opcode p_fused_opcode) {
+	// A conditional jump right after the validated operator computing its condition becomes a single compare-and-branch.
+	// The operator result is still stored, the jump target is appended by the caller as usual.
+	if (!optimize || last_validated_operator_pos < 0 || last_validated_operator_pos + 5 != opcodes.size() || last_jump_target == opcodes.size()) {
+		return false;
+	}
+	if (last_validated_operator_type != Variant::BOOL || p_condition.mode != Address::TEMPORARY || last_validated_operator_target.mode != Address::TEMPORARY || last_validated_operator_target.address != p_condition.address) {
+		return false;
+	}
+
+	opcodes.write[last_validated_operator_pos] = p_fused_opcode;
+	last_validated_operator_pos = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
+	if (!fuse_jump_condition(p_left_operand, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_left_operand);
+	}
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
+	if (!fuse_jump_condition(p_right_operand, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_right_operand);
+	}
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -721,15 +765,19 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_left_operand);
+	if (!fuse_jump_condition(p_left_operand, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
+		append(p_left_operand);
+	}
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_right_operand);
+	if (!fuse_jump_condition(p_right_operand, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
+		append(p_right_operand);
+	}
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -755,8 +803,10 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_jump_condition(p_condition, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -859,6 +909,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +928,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1021,6 +1073,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	last_jump_target = opcodes.size();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1091,6 +1144,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1116,6 +1170,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1350,6 +1405,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1363,6 +1419,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1376,6 +1433,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1510,8 +1568,10 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_jump_condition(p_condition, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1730,6 +1790,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	last_jump_target = continue_addr;
 	append_opcode(iterate_opcode);
 	append(counter);
 	if (p_is_range) {
@@ -1782,12 +1843,15 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_jump_target = opcodes.size();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_jump_condition(p_condition, GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1826,6 +1890,15 @@ void GDScriptByteCodeGenerator::write_breakpoint() {
 
 void GDScriptByteCodeGenerator::write_newline(int p_line) {
 	if (GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+#ifndef DEBUG_ENABLED
+		// Without a debugger nothing can stop on a line that has no code, so consecutive lines collapse into the last one.
+		if (optimize && last_line_pos >= 0 && last_line_pos + 2 == opcodes.size() && last_jump_target != opcodes.size()) {
+			opcodes.write[last_line_pos + 1] = p_line;
+			current_line = p_line;
+			return;
+		}
+		last_line_pos = opcodes.size();
+#endif
 		// Add newline for debugger and stack tracking if enabled in the project settings.
 		append_opcode(GDScriptFunction::OPCODE_LINE);
 		append(p_line);
@@ -97,6 +97,20 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
+
+	// Peephole state. Instructions are only fused when no jump lands between them.
+	int last_jump_target = -1;
+	int last_validated_operator_pos = -1;
+	Address last_validated_operator_target;
+	Variant::Type last_validated_operator_type = Variant::NIL;
+#ifndef DEBUG_ENABLED
+	int last_line_pos = -1;
+#endif
+
+	// Read once per function in write_start(), so a function is never compiled with a mix of both settings.
+	static SafeFlag optimizations_enabled;
+	bool optimize = true;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -449,11 +463,21 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_jump_target = opcodes.size();
 	}
 
+	bool fuse_jump_condition(const Address &p_condition, GDScriptFunction::Opcode p_fused_opcode);
+
 public:
+	static void set_optimizations_enabled(bool p_enabled) { optimizations_enabled.set_to(p_enabled); }
+	static bool are_optimizations_enabled() { return optimizations_enabled.is_set(); }
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
@@ -464,6 +488,7 @@ public:
 	virtual void clear_temporaries() override;
 	virtual void clear_address(const Address &p_address) override;
 	virtual bool is_local_dirty(const Address &p_address) const override;
+	virtual bool is_optimizing() const override { return optimize; }
 
 	virtual void start_parameters() override;
 	virtual void end_parameters() override;
@@ -75,16 +75,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = _parse(get_parser(), path, source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -107,6 +98,19 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 	return result;
 }
 
+Error GDScriptParserRef::_parse(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash) {
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	} else {
+		String source = GDScriptCache::get_source_code(remapped_path);
+		r_source_hash = source.hash();
+		return p_parser->parse(source, p_path, false);
+	}
+}
+
 void GDScriptParserRef::clear() {
 	if (clearing) {
 		return;
@@ -143,6 +147,7 @@ GDScriptParserRef::~GDScriptParserRef() {
 }
 
 GDScriptCache *GDScriptCache::singleton = nullptr;
+bool GDScriptCache::parallel_parsing_enabled = true;
 
 SafeBinaryMutex<GDScriptCache::BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex() {
 	return GDScriptCache::mutex;
@@ -295,6 +300,97 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+void GDScriptCache::_parse_job(void *p_userdata, uint32_t p_index) {
+	ParseJob &job = static_cast<ParseJob *>(p_userdata)[p_index];
+	job.result = GDScriptParserRef::_parse(job.parser, job.path, job.source_hash);
+}
+
+void GDScriptCache::_find_dependencies(const GDScriptParser *p_parser, const String &p_path, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	LocalVector<String> candidates;
+	const GDScriptParser::ClassNode *tree = p_parser->get_tree();
+	if (tree != nullptr && !tree->extends_path.is_empty()) {
+		candidates.push_back(tree->extends_path);
+	}
+	for (const String &path : p_parser->get_preload_paths()) {
+		candidates.push_back(path);
+	}
+	for (const StringName &name : p_parser->get_referenced_identifiers()) {
+		if (ScriptServer::is_global_class(name) && ScriptServer::get_global_class_language(name) == GDScriptLanguage::get_singleton()->get_name()) {
+			candidates.push_back(ScriptServer::get_global_class_path(name));
+		}
+	}
+
+	const String base_dir = p_path.get_base_dir();
+	for (String path : candidates) {
+		if (path.is_relative_path()) {
+			path = base_dir.path_join(path);
+		}
+		path = path.simplify_path();
+		if (path.get_extension().to_lower() != "gd" || r_visited.has(path)) {
+			continue;
+		}
+		r_visited.insert(path);
+
+		if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+			continue;
+		}
+		r_pending.push_back(path);
+	}
+}
+
+// Parses the dependencies of an already parsed script wave by wave, each wave
+// in parallel. Parsing doesn't depend on other scripts, unlike analysis, which
+// then finds the parsers ready in the cache.
+// TODO: Analysis and compilation still run serially, and nothing is cached on
+// disk between runs, so every startup is a cold load. Both need their own change.
+void GDScriptCache::_parse_dependencies(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsed) {
+	HashSet<String> visited;
+	visited.insert(p_path);
+	LocalVector<String> pending;
+	_find_dependencies(singleton->parser_map[p_path]->get_parser(), p_path, visited, pending);
+
+	while (!pending.is_empty()) {
+		LocalVector<ParseJob> jobs;
+		jobs.resize(pending.size());
+		for (uint32_t i = 0; i < pending.size(); i++) {
+			jobs[i].path = pending[i];
+			// Constructed here, since the first parser registers the annotations.
+			jobs[i].parser = memnew(GDScriptParser);
+		}
+		pending.clear();
+
+		if (jobs.size() == 1) {
+			_parse_job(jobs.ptr(), 0);
+		} else {
+			WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_job, jobs.ptr(), jobs.size(), -1, true, SNAME("GDScriptCache::parse_dependencies"));
+			// The jobs don't use the cache, so let other threads in while waiting.
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		for (ParseJob &job : jobs) {
+			if (singleton->cleared || singleton->parser_map.has(job.path)) {
+				// Cleared or parsed by another thread meanwhile.
+				memdelete(job.parser);
+				continue;
+			}
+
+			_find_dependencies(job.parser, job.path, visited, pending);
+
+			Ref<GDScriptParserRef> parser_ref;
+			parser_ref.instantiate();
+			parser_ref->path = job.path;
+			parser_ref->parser = job.parser;
+			parser_ref->status = GDScriptParserRef::PARSED;
+			parser_ref->result = job.result;
+			parser_ref->source_hash = job.source_hash;
+			singleton->parser_map[job.path] = parser_ref.ptr();
+			r_parsed.push_back(parser_ref);
+		}
+	}
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -353,12 +449,25 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Keeps the parsers made ahead of analysis alive until the script is compiled.
+	LocalVector<Ref<GDScriptParserRef>> parsed_dependencies;
+
 	if (script.is_null()) {
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
 			return script;
 		}
+
+		if (parallel_parsing_enabled && singleton->parser_map.has(p_path)) {
+			_parse_dependencies(p_path, parsed_dependencies);
+#ifdef DEV_ENABLED
+			// The lock is held from here until reload, so the analyzer finds them as they were installed.
+			for (const Ref<GDScriptParserRef> &dependency : parsed_dependencies) {
+				DEV_ASSERT(dependency->get_status() == GDScriptParserRef::PARSED);
+			}
+#endif
+		}
 	}
 
 	const String remapped_path = ResourceLoader::path_remap(p_path);
@@ -36,6 +36,7 @@
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
 class GDScriptAnalyzer;
 class GDScriptParser;
@@ -65,6 +66,8 @@ private:
 	friend class GDScriptCache;
 	friend class GDScript;
 
+	static Error _parse(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash);
+
 public:
 	Status get_status() const;
 	String get_path() const;
@@ -96,6 +99,19 @@ class GDScriptCache {
 
 	bool cleared = false;
 
+	static bool parallel_parsing_enabled;
+
+	struct ParseJob {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+	};
+
+	static void _parse_job(void *p_userdata, uint32_t p_index);
+	static void _find_dependencies(const GDScriptParser *p_parser, const String &p_path, HashSet<String> &r_visited, LocalVector<String> &r_pending);
+	static void _parse_dependencies(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsed);
+
 public:
 	static const int BINARY_MUTEX_TAG = 2;
 
@@ -118,6 +134,12 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	// When enabled, loading a script parses the scripts it extends, preloads or
+	// names by global class on worker threads before analyzing it. Only parsing
+	// runs on worker threads, analysis and compilation stay serial.
+	static void set_parallel_parsing_enabled(bool p_enabled) { parallel_parsing_enabled = p_enabled; }
+	static bool is_parallel_parsing_enabled() { return parallel_parsing_enabled; }
+
 	static void clear();
 
 	GDScriptCache();
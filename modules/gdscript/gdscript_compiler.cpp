@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -251,6 +252,36 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+static bool _can_operate_in_place(Variant::Operator p_operator, const GDScriptCodeGenerator::Address &p_target, const GDScriptCodeGenerator::Address &p_operand) {
+	// Only typed locals are guaranteed to already hold a value of their type.
+	if (p_target.mode != GDScriptCodeGenerator::Address::LOCAL_VARIABLE || !p_target.type.has_type || p_target.type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	if (!p_operand.type.has_type || p_operand.type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	// Division and modulo don't use validated operators (no division by zero check), and the generic path clears the target first.
+	if (p_operator == Variant::OP_DIVIDE || p_operator == Variant::OP_MODULE) {
+		return false;
+	}
+	// Restricted to value types whose validated operators read both operands before writing the result.
+	switch (p_target.type.builtin_type) {
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+			break;
+		default:
+			return false;
+	}
+	return Variant::get_operator_return_type(p_operator, p_target.type.builtin_type, p_operand.type.builtin_type) == p_target.type.builtin_type &&
+			Variant::get_validated_operator_evaluator(p_operator, p_target.type.builtin_type, p_operand.type.builtin_type) != nullptr;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -1343,7 +1374,12 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 				GDScriptCodeGenerator::Address to_assign;
 				bool has_operation = assignment->operation != GDScriptParser::AssignmentNode::OP_NONE;
-				if (has_operation) {
+				// A typed local can be the operator target itself, saving a temporary and a copy for statements like `i += 1`.
+				bool in_place_operation = has_operation && !is_member && !assignment->use_conversion_assign && gen->is_optimizing() &&
+						_can_operate_in_place(assignment->variant_op, target, assigned_value);
+				if (in_place_operation) {
+					gen->write_binary_operator(target, assignment->variant_op, target, assigned_value);
+				} else if (has_operation) {
 					// Perform operation.
 					GDScriptCodeGenerator::Address op_result = codegen.add_temporary(_gdtype_from_datatype(assignment->get_datatype(), codegen.script));
 					GDScriptCodeGenerator::Address og_value = _parse_expression(codegen, r_error, assignment->assignee);
@@ -1357,7 +1393,9 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					to_assign = assigned_value;
 				}
 
-				if (has_setter && !is_in_setter) {
+				if (in_place_operation) {
+					// Already stored by the operation.
+				} else if (has_setter && !is_in_setter) {
 					// Call setter.
 					Vector<GDScriptCodeGenerator::Address> args;
 					args.push_back(to_assign);
@@ -3317,6 +3355,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	// Member layouts and functions are about to change.
+	GDScriptInlineCache::invalidate_all();
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
@@ -3340,6 +3381,8 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
+	GDScriptInlineCache::invalidate_all();
+
 	if (has_static_data && !root->annotated_static_unload) {
 		GDScriptCache::add_static_script(p_script);
 	}
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "gdscript_native.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
@@ -41,6 +42,7 @@
 #include "core/variant/variant.h"
 
 class GDScriptInstance;
+class GDScriptInlineCache;
 class GDScript;
 
 class GDScriptDataType {
@@ -269,6 +271,8 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -459,6 +463,8 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptNativeFunctions;
+	friend class GDScriptNativeTranslator;
 
 	StringName name;
 	StringName source;
@@ -515,6 +521,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -533,6 +540,8 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
+	GDScriptNativeFunctionPtr _native_function = nullptr; // Translated ahead of time, only used in release builds.
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
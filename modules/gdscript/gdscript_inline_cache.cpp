@@ -0,0 +1,575 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#include "gdscript_inline_cache.h"
+
+#include "gdscript.h"
+
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
+std::atomic<uint32_t> GDScriptInlineCache::epoch = { 1 };
+bool GDScriptInlineCache::enabled = true;
+BinaryMutex GDScriptInlineCache::write_mutex;
+HashMap<const GDScriptFunction *, HashSet<GDScriptInlineCache *>> GDScriptInlineCache::function_users;
+
+bool GDScriptInlineCache::_make_key(const Variant *p_base, Key &r_key) {
+	if (unlikely(!enabled)) {
+		return false;
+	}
+
+	r_key.type = p_base->get_type();
+	if (r_key.type != Variant::OBJECT) {
+		return r_key.type != Variant::NIL;
+	}
+
+	Object *obj = p_base->get_validated_object();
+	if (unlikely(!obj)) {
+		// Let the generic path report freed instances.
+		return false;
+	}
+
+	ScriptInstance *script_instance = obj->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		r_key.instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key.script = r_key.instance->script.ptr();
+	}
+
+	r_key.object = obj;
+	r_key.class_name = &obj->get_class_name();
+	return true;
+}
+
+bool GDScriptInlineCache::_is_valid_chain(const GDScript *p_script) {
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (!sptr->valid) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptInlineCache::_has_script_function(const GDScript *p_script, const StringName &p_name) {
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (sptr->member_functions.has(p_name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const ClassDB::ClassInfo *GDScriptInlineCache::_get_native_class_info(const Key &p_key) {
+	const ClassDB::ClassInfo *info = ClassDB::classes.getptr(*p_key.class_name);
+	if (!info || info->gdextension) {
+		// Extension classes may resolve names on their own.
+		return nullptr;
+	}
+	return info;
+}
+
+void GDScriptInlineCache::_resolve_get(const Key &p_key, const StringName &p_name, Target &r_target) {
+	if (!p_key.object) {
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(p_key.type, p_name);
+		if (getter) {
+			r_target.kind = KIND_BUILTIN_MEMBER;
+			r_target.getter = getter;
+		}
+		return;
+	}
+
+	if (p_key.script) {
+		// Mirror the lookup order of GDScriptInstance::get().
+		if (!_is_valid_chain(p_key.script)) {
+			return;
+		}
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_key.script->member_indices.find(p_name);
+		if (E) {
+			if (!E->value.getter) {
+				r_target.kind = KIND_SCRIPT_MEMBER;
+				r_target.index = E->value.index;
+			}
+			return;
+		}
+		const StringName &get_function = GDScriptLanguage::get_singleton()->strings._get;
+		for (const GDScript *sptr = p_key.script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) ||
+					sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(get_function)) {
+				return;
+			}
+		}
+	}
+
+	// Mirror ClassDB::get_property().
+	const ClassDB::ClassInfo *check = _get_native_class_info(p_key);
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (!psg->getter) {
+				return;
+			}
+			if (psg->index >= 0 || !psg->_getptr) {
+				// Called through Object::callp(), which gives the script a chance first.
+				if (_has_script_function(p_key.script, psg->getter)) {
+					return;
+				}
+				r_target.method = ClassDB::get_method(*p_key.class_name, psg->getter);
+				r_target.check_result = true;
+			} else {
+				r_target.method = psg->_getptr;
+			}
+			if (r_target.method) {
+				r_target.kind = KIND_NATIVE_PROPERTY;
+				r_target.index = psg->index;
+			}
+			return;
+		}
+		if (check->constant_map.has(p_name) || check->method_map.has(p_name) || check->signal_map.has(p_name)) {
+			return;
+		}
+		check = check->inherits_ptr;
+	}
+}
+
+void GDScriptInlineCache::_resolve_set(const Key &p_key, const StringName &p_name, Target &r_target) {
+	if (!p_key.object) {
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(p_key.type, p_name);
+		if (setter) {
+			r_target.kind = KIND_BUILTIN_MEMBER;
+			r_target.setter = setter;
+			r_target.value_type = Variant::get_member_type(p_key.type, p_name);
+		}
+		return;
+	}
+
+	if (p_key.script) {
+		// Mirror the lookup order of GDScriptInstance::set().
+		if (!_is_valid_chain(p_key.script)) {
+			return;
+		}
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_key.script->member_indices.find(p_name);
+		if (E) {
+			if (!E->value.setter) {
+				r_target.kind = KIND_SCRIPT_MEMBER;
+				r_target.index = E->value.index;
+				r_target.member_type = &E->value.data_type;
+			}
+			return;
+		}
+		const StringName &set_function = GDScriptLanguage::get_singleton()->strings._set;
+		for (const GDScript *sptr = p_key.script; sptr; sptr = sptr->_base) {
+			if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(set_function)) {
+				return;
+			}
+		}
+	}
+
+	// Mirror ClassDB::set_property().
+	const ClassDB::ClassInfo *check = _get_native_class_info(p_key);
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (!psg->setter) {
+				return;
+			}
+			if (psg->_setptr) {
+				r_target.method = psg->_setptr;
+			} else {
+				if (_has_script_function(p_key.script, psg->setter)) {
+					return;
+				}
+				r_target.method = ClassDB::get_method(*p_key.class_name, psg->setter);
+			}
+			if (r_target.method) {
+				r_target.kind = KIND_NATIVE_PROPERTY;
+				r_target.index = psg->index;
+			}
+			return;
+		}
+		check = check->inherits_ptr;
+	}
+}
+
+void GDScriptInlineCache::_resolve_call(const Key &p_key, const StringName &p_name, Target &r_target) {
+	if (!p_key.object || p_name == CoreStringName(free_)) {
+		// Built-in methods keep going through Variant::callp(), and free() is special.
+		return;
+	}
+
+	if (p_key.script) {
+		// Mirror the lookup order of GDScriptInstance::callp().
+		if (!_is_valid_chain(p_key.script) || p_name == SceneStringName(_ready)) {
+			return;
+		}
+		for (const GDScript *sptr = p_key.script; sptr; sptr = sptr->_base) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+			if (E) {
+				r_target.kind = KIND_SCRIPT_FUNCTION;
+				r_target.function = E->value;
+				return;
+			}
+		}
+	}
+
+	if (!_get_native_class_info(p_key)) {
+		return;
+	}
+	r_target.method = ClassDB::get_method(*p_key.class_name, p_name);
+	if (r_target.method) {
+		r_target.kind = KIND_NATIVE_METHOD;
+	}
+}
+
+void GDScriptInlineCache::_load_target(const std::atomic<uint64_t> *p_words, Target &r_target) {
+	static_assert(std::is_trivially_copyable_v<Target>);
+	uint64_t words[TARGET_WORDS];
+	for (int i = 0; i < TARGET_WORDS; i++) {
+		words[i] = p_words[i].load(std::memory_order_relaxed);
+	}
+	memcpy((void *)&r_target, words, sizeof(Target));
+}
+
+void GDScriptInlineCache::_store_target(std::atomic<uint64_t> *p_words, const Target &p_target) {
+	uint64_t words[TARGET_WORDS] = {};
+	memcpy(words, (const void *)&p_target, sizeof(Target));
+	for (int i = 0; i < TARGET_WORDS; i++) {
+		p_words[i].store(words[i], std::memory_order_relaxed);
+	}
+}
+
+void GDScriptInlineCache::_unregister_targets(Storage *p_storage) {
+	const int target_count = p_storage->target_count.load(std::memory_order_relaxed);
+	for (int i = 0; i < target_count; i++) {
+		Target target;
+		_load_target(p_storage->targets[i], target);
+		if (target.kind == KIND_SCRIPT_FUNCTION) {
+			HashSet<GDScriptInlineCache *> *users = function_users.getptr(target.function);
+			if (users) {
+				users->erase(this);
+				if (users->is_empty()) {
+					function_users.erase(target.function);
+				}
+			}
+		}
+	}
+}
+
+void GDScriptInlineCache::_remove_function_targets(const GDScriptFunction *p_function) {
+	Storage *current = storage.load(std::memory_order_relaxed);
+	const uint32_t sequence = current->sequence.load(std::memory_order_relaxed);
+	current->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	const int target_count = current->target_count.load(std::memory_order_relaxed);
+	int kept = 0;
+	for (int i = 0; i < target_count; i++) {
+		Target target;
+		_load_target(current->targets[i], target);
+		if (target.kind == KIND_SCRIPT_FUNCTION && target.function == p_function) {
+			continue;
+		}
+		if (kept != i) {
+			_store_target(current->targets[kept], target);
+		}
+		kept++;
+	}
+	current->target_count.store(kept, std::memory_order_relaxed);
+	// The site may be monomorphic again.
+	current->megamorphic.store(false, std::memory_order_relaxed);
+
+	current->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool GDScriptInlineCache::_find(const Key &p_key, const StringName &p_name, Operation p_operation, Target &r_target) {
+	const uint32_t current_epoch = epoch.load(std::memory_order_acquire);
+
+	Storage *current = storage.load(std::memory_order_acquire);
+	if (likely(current)) {
+		const uint32_t sequence = current->sequence.load(std::memory_order_acquire);
+		if (likely(!(sequence & 1) && current->epoch.load(std::memory_order_relaxed) == current_epoch)) {
+			const int target_count = MIN(current->target_count.load(std::memory_order_relaxed), MAX_TARGETS);
+			const bool megamorphic = current->megamorphic.load(std::memory_order_relaxed);
+			bool found = false;
+			for (int i = 0; i < target_count; i++) {
+				_load_target(current->targets[i], r_target);
+				if (r_target.type == p_key.type && r_target.class_name == p_key.class_name && r_target.script == p_key.script) {
+					found = true;
+					break;
+				}
+			}
+			// Only trust what was read if no writer came in the meantime.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (likely(current->sequence.load(std::memory_order_relaxed) == sequence)) {
+				if (likely(found)) {
+					return true;
+				}
+				if (megamorphic) {
+					return false;
+				}
+			}
+		}
+	}
+
+	Target target;
+	target.type = p_key.type;
+	target.class_name = p_key.class_name;
+	target.script = p_key.script;
+	switch (p_operation) {
+		case OPERATION_GET:
+			_resolve_get(p_key, p_name, target);
+			break;
+		case OPERATION_SET:
+			_resolve_set(p_key, p_name, target);
+			break;
+		case OPERATION_CALL:
+			_resolve_call(p_key, p_name, target);
+			break;
+	}
+	r_target = target;
+
+	MutexLock lock(write_mutex);
+	if (unlikely(epoch.load(std::memory_order_acquire) != current_epoch)) {
+		// Invalidated while resolving, the result may already be stale.
+		return true;
+	}
+	if (unlikely(!current)) {
+		current = storage.load(std::memory_order_relaxed);
+		if (!current) {
+			current = memnew(Storage);
+			storage.store(current, std::memory_order_release);
+		}
+	}
+
+	const bool reset = current->epoch.load(std::memory_order_relaxed) != current_epoch;
+	int target_count = reset ? 0 : current->target_count.load(std::memory_order_relaxed);
+	for (int i = 0; i < target_count; i++) {
+		Target existing;
+		_load_target(current->targets[i], existing);
+		if (existing.type == p_key.type && existing.class_name == p_key.class_name && existing.script == p_key.script) {
+			// Filled by another thread in the meantime.
+			return true;
+		}
+	}
+	if (!reset && current->megamorphic.load(std::memory_order_relaxed)) {
+		return true;
+	}
+	if (reset) {
+		_unregister_targets(current);
+	}
+
+	const uint32_t sequence = current->sequence.load(std::memory_order_relaxed);
+	current->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	if (reset) {
+		current->epoch.store(current_epoch, std::memory_order_relaxed);
+		current->megamorphic.store(false, std::memory_order_relaxed);
+	}
+	if (target_count < MAX_TARGETS) {
+		_store_target(current->targets[target_count++], target);
+		if (target.kind == KIND_SCRIPT_FUNCTION) {
+			function_users[target.function].insert(this);
+		}
+	} else {
+		current->megamorphic.store(true, std::memory_order_relaxed);
+	}
+	current->target_count.store(target_count, std::memory_order_relaxed);
+	current->sequence.store(sequence + 2, std::memory_order_release);
+
+	return true;
+}
+
+bool GDScriptInlineCache::get(const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	Key key;
+	if (!_make_key(p_base, key)) {
+		return false;
+	}
+	Target target;
+	if (!_find(key, p_name, OPERATION_GET, target)) {
+		return false;
+	}
+
+	switch (target.kind) {
+		case KIND_BUILTIN_MEMBER: {
+			if (unlikely(&r_ret == p_base)) {
+				Variant ret;
+				target.getter(p_base, &ret);
+				r_ret = ret;
+			} else {
+				target.getter(p_base, &r_ret);
+			}
+			return true;
+		}
+		case KIND_NATIVE_PROPERTY: {
+			Callable::CallError ce;
+			Variant ret;
+			if (target.index >= 0) {
+				Variant index = target.index;
+				const Variant *args[1] = { &index };
+				ret = target.method->call(key.object, args, 1, ce);
+			} else {
+				ret = target.method->call(key.object, nullptr, 0, ce);
+			}
+			r_ret = (!target.check_result || ce.error == Callable::CallError::CALL_OK) ? ret : Variant();
+			return true;
+		}
+		case KIND_SCRIPT_MEMBER: {
+			if (unlikely(&r_ret == p_base)) {
+				// Overwriting the base may free the instance holding the member.
+				const Variant ret = key.instance->members[target.index];
+				r_ret = ret;
+			} else {
+				r_ret = key.instance->members[target.index];
+			}
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptInlineCache::set(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	Key key;
+	if (!_make_key(p_base, key)) {
+		return false;
+	}
+	Target target;
+	if (!_find(key, p_name, OPERATION_SET, target)) {
+		return false;
+	}
+
+	switch (target.kind) {
+		case KIND_BUILTIN_MEMBER: {
+			if (p_value->get_type() != target.value_type) {
+				// Let Variant::set_named() convert the value.
+				return false;
+			}
+			target.setter(p_base, p_value);
+			r_valid = true;
+			return true;
+		}
+		case KIND_NATIVE_PROPERTY: {
+#ifdef TOOLS_ENABLED
+			if (!key.object->is_edited()) {
+				key.object->set_edited(true);
+			}
+#endif
+			Callable::CallError ce;
+			if (target.index >= 0) {
+				Variant index = target.index;
+				const Variant *args[2] = { &index, p_value };
+				target.method->call(key.object, args, 2, ce);
+			} else {
+				const Variant *args[1] = { p_value };
+				target.method->call(key.object, args, 1, ce);
+			}
+			r_valid = ce.error == Callable::CallError::CALL_OK;
+			return true;
+		}
+		case KIND_SCRIPT_MEMBER: {
+			if (target.member_type->has_type && !target.member_type->is_type(*p_value)) {
+				// Let GDScriptInstance::set() convert the value.
+				return false;
+			}
+#ifdef TOOLS_ENABLED
+			if (!key.object->is_edited()) {
+				key.object->set_edited(true);
+			}
+#endif
+			key.instance->members.write[target.index] = *p_value;
+			r_valid = true;
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+bool GDScriptInlineCache::call(Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	Key key;
+	if (!_make_key(p_base, key)) {
+		return false;
+	}
+	Target target;
+	if (!_find(key, p_name, OPERATION_CALL, target)) {
+		return false;
+	}
+
+	switch (target.kind) {
+		case KIND_NATIVE_METHOD: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			r_error.error = Callable::CallError::CALL_OK;
+			r_ret = target.method->call(key.object, p_args, p_argcount, r_error);
+			return true;
+		}
+		case KIND_SCRIPT_FUNCTION: {
+#ifdef DEBUG_ENABLED
+			_ObjectDebugLock debug_lock(key.object);
+#endif
+			r_error.error = Callable::CallError::CALL_OK;
+			r_ret = target.function->call(key.instance, p_args, p_argcount, r_error);
+			return true;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+void GDScriptInlineCache::invalidate_all() {
+	epoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void GDScriptInlineCache::invalidate_function(const GDScriptFunction *p_function) {
+	MutexLock lock(write_mutex);
+	HashSet<GDScriptInlineCache *> *users = function_users.getptr(p_function);
+	if (!users) {
+		return;
+	}
+	for (GDScriptInlineCache *cache : *users) {
+		cache->_remove_function_targets(p_function);
+	}
+	function_users.erase(p_function);
+}
+
+GDScriptInlineCache::~GDScriptInlineCache() {
+	Storage *current = storage.load(std::memory_order_relaxed);
+	if (current) {
+		MutexLock lock(write_mutex);
+		_unregister_targets(current);
+		memdelete(current);
+	}
+}
@@ -0,0 +1,159 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/variant/callable.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScript;
+class GDScriptDataType;
+class GDScriptFunction;
+class GDScriptInstance;
+class MethodBind;
+class Object;
+
+// Per-instruction cache used by the untyped named get, set and call opcodes.
+// It remembers how a name was resolved for up to MAX_TARGETS receiver shapes,
+// keyed on the Variant type, the native class and the GDScript of the base,
+// so later executions skip the lookups through ClassDB and the script member
+// maps. Compiling, clearing or freeing any script invalidates all caches,
+// freeing a function only drops the entries calling it.
+class GDScriptInlineCache {
+public:
+	static constexpr int MAX_TARGETS = 4;
+
+private:
+	enum Kind : uint8_t {
+		KIND_UNRESOLVED, // Known to need the generic path.
+		KIND_BUILTIN_MEMBER, // Validated getter or setter of a built-in type.
+		KIND_NATIVE_PROPERTY, // Getter or setter of a ClassDB property.
+		KIND_NATIVE_METHOD, // ClassDB method.
+		KIND_SCRIPT_MEMBER, // GDScript member variable without accessors.
+		KIND_SCRIPT_FUNCTION, // GDScript member function.
+	};
+
+	// Plain data, so it can be stored as words and read without locking.
+	struct Target {
+		Variant::Type type = Variant::NIL;
+		Kind kind = KIND_UNRESOLVED;
+		const StringName *class_name = nullptr; // Unique per native class.
+		const GDScript *script = nullptr;
+
+		Variant::ValidatedGetter getter = nullptr;
+		Variant::ValidatedSetter setter = nullptr;
+		Variant::Type value_type = Variant::NIL;
+		MethodBind *method = nullptr;
+		GDScriptFunction *function = nullptr;
+		const GDScriptDataType *member_type = nullptr;
+		int index = -1;
+		bool check_result = false;
+	};
+
+	static constexpr int TARGET_WORDS = (sizeof(Target) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	struct Key {
+		Variant::Type type = Variant::NIL;
+		Object *object = nullptr;
+		const StringName *class_name = nullptr;
+		GDScriptInstance *instance = nullptr;
+		const GDScript *script = nullptr;
+	};
+
+	// Allocated on the first miss and kept until the cache is freed.
+	// Hits read it as a seqlock: writers make the sequence odd while they
+	// change the entries, and readers retry on the slow path if the
+	// sequence changed while they were reading. Everything is atomic, so
+	// a hit racing with a writer is discarded rather than undefined.
+	struct Storage {
+		std::atomic<uint32_t> sequence = { 0 };
+		std::atomic<uint32_t> epoch = { 0 };
+		std::atomic<int> target_count = { 0 };
+		std::atomic<bool> megamorphic = { false };
+		std::atomic<uint64_t> targets[MAX_TARGETS][TARGET_WORDS] = {};
+	};
+
+	enum Operation {
+		OPERATION_GET,
+		OPERATION_SET,
+		OPERATION_CALL,
+	};
+
+	static std::atomic<uint32_t> epoch;
+	static bool enabled;
+
+	// Writers are serialized by this mutex, which also guards the caches
+	// each script function is a call target of.
+	static BinaryMutex write_mutex;
+	static HashMap<const GDScriptFunction *, HashSet<GDScriptInlineCache *>> function_users;
+
+	std::atomic<Storage *> storage = { nullptr };
+
+	static bool _make_key(const Variant *p_base, Key &r_key);
+	static bool _is_valid_chain(const GDScript *p_script);
+	static bool _has_script_function(const GDScript *p_script, const StringName &p_name);
+	static const ClassDB::ClassInfo *_get_native_class_info(const Key &p_key);
+	static void _resolve_get(const Key &p_key, const StringName &p_name, Target &r_target);
+	static void _resolve_set(const Key &p_key, const StringName &p_name, Target &r_target);
+	static void _resolve_call(const Key &p_key, const StringName &p_name, Target &r_target);
+
+	static void _load_target(const std::atomic<uint64_t> *p_words, Target &r_target);
+	static void _store_target(std::atomic<uint64_t> *p_words, const Target &p_target);
+	void _unregister_targets(Storage *p_storage);
+	void _remove_function_targets(const GDScriptFunction *p_function);
+
+	bool _find(const Key &p_key, const StringName &p_name, Operation p_operation, Target &r_target);
+
+public:
+	// Each of these returns false when the caller must take the generic path.
+	bool get(const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool set(Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	bool call(Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	static void invalidate_all();
+	// Drops the entries calling `p_function`, which is about to be freed.
+	static void invalidate_function(const GDScriptFunction *p_function);
+
+	// For benchmarking and troubleshooting, the caches can be bypassed.
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+
+	GDScriptInlineCache() {}
+	GDScriptInlineCache(const GDScriptInlineCache &) = delete;
+	GDScriptInlineCache &operator=(const GDScriptInlineCache &) = delete;
+	~GDScriptInlineCache();
+};
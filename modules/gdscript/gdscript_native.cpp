@@ -0,0 +1,552 @@
+/**************************************************************************/
+/*  gdscript_native.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant_internal.h"
+
+// Bump when the meaning of normalized code changes, so stale generated code is ignored.
+static constexpr int32_t NORMALIZED_CODE_VERSION = 1;
+static constexpr int NORMALIZED_HEADER_SIZE = 4;
+
+GDScriptNativeFunctions::Registration *GDScriptNativeFunctions::first = nullptr;
+bool GDScriptNativeFunctions::enabled = true;
+
+GDScriptNativeFunctions::Registration::Registration(const int32_t *p_code, uint32_t p_code_size, GDScriptNativeFunctionPtr p_function) {
+	code = p_code;
+	code_size = p_code_size;
+	hash = hash_code(p_code, p_code_size);
+	function = p_function;
+	next = first;
+	first = this;
+}
+
+GDScriptNativeFunctions::Registration::~Registration() {
+	for (Registration **E = &first; *E; E = &(*E)->next) {
+		if (*E == this) {
+			*E = next;
+			break;
+		}
+	}
+}
+
+bool GDScriptNativeFunctions::_get_instruction_layout(const int *p_code, int p_code_size, int p_ip, int &r_size, int &r_jump_offset) {
+	r_size = 0;
+	r_jump_offset = -1;
+
+	const int opcode = p_code[p_ip];
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_END:
+			r_size = 1;
+			break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE:
+			r_size = 2;
+			break;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+			r_size = 3;
+			break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			r_size = 4;
+			break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			r_size = 5;
+			break;
+		case GDScriptFunction::OPCODE_JUMP:
+			r_size = 2;
+			r_jump_offset = 1;
+			break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			r_size = 3;
+			r_jump_offset = 2;
+			break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			r_size = 6;
+			r_jump_offset = 5;
+			break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE:
+			r_size = 7;
+			r_jump_offset = 6;
+			break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE:
+			r_size = 6;
+			r_jump_offset = 5;
+			break;
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			// Opcode, instruction argument count, instruction arguments, call argument count and function index.
+			if (p_ip + 1 >= p_code_size || p_code[p_ip + 1] < 0) {
+				return false;
+			}
+			r_size = 4 + p_code[p_ip + 1];
+			break;
+		default:
+			if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_COLOR) {
+				r_size = 2;
+				break;
+			}
+			return false;
+	}
+
+	return p_ip + r_size <= p_code_size;
+}
+
+Vector<int32_t> GDScriptNativeFunctions::normalize(const GDScriptFunction *p_function, String *r_reason) {
+#define FAIL(m_reason)          \
+	if (r_reason) {             \
+		*r_reason = (m_reason); \
+	}                           \
+	return Vector<int32_t>();
+
+	if (!p_function->_code_ptr) {
+		FAIL("The function has no code.");
+	}
+	if (p_function->is_vararg() || p_function->_default_arg_count > 0) {
+		FAIL("Functions with default or variadic arguments are not supported.");
+	}
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+
+	// Number of words taken by line opcodes before each address.
+	LocalVector<int> removed;
+	removed.resize(code_size + 1);
+
+	int removed_words = 0;
+	for (int ip = 0; ip < code_size;) {
+		int size = 0;
+		int jump_offset = -1;
+		if (code[ip] == GDScriptFunction::OPCODE_ASSERT || code[ip] == GDScriptFunction::OPCODE_BREAKPOINT) {
+			FAIL("Functions using assert or breakpoint are not supported, release builds compile them differently.");
+		}
+		if (!_get_instruction_layout(code, code_size, ip, size, jump_offset)) {
+			FAIL(vformat("Unsupported instruction (opcode %d) at address %d.", code[ip], ip));
+		}
+		for (int i = 0; i < size; i++) {
+			removed[ip + i] = removed_words;
+		}
+		if (code[ip] == GDScriptFunction::OPCODE_LINE) {
+			removed_words += size;
+		}
+		ip += size;
+	}
+	removed[code_size] = removed_words;
+
+	Vector<int32_t> result;
+	result.resize(NORMALIZED_HEADER_SIZE + code_size - removed_words);
+	int32_t *w = result.ptrw();
+	w[0] = NORMALIZED_CODE_VERSION;
+	w[1] = p_function->_stack_size;
+	w[2] = p_function->_argument_count;
+	w[3] = p_function->_static ? 1 : 0;
+
+	int pos = NORMALIZED_HEADER_SIZE;
+	for (int ip = 0; ip < code_size;) {
+		int size = 0;
+		int jump_offset = -1;
+		_get_instruction_layout(code, code_size, ip, size, jump_offset);
+		if (code[ip] != GDScriptFunction::OPCODE_LINE) {
+			for (int i = 0; i < size; i++) {
+				w[pos + i] = code[ip + i];
+			}
+			if (jump_offset >= 0) {
+				const int target = code[ip + jump_offset];
+				if (target < 0 || target > code_size) {
+					FAIL(vformat("Invalid jump target at address %d.", ip));
+				}
+				w[pos + jump_offset] = target - removed[target];
+			}
+			pos += size;
+		}
+		ip += size;
+	}
+
+	return result;
+#undef FAIL
+}
+
+uint32_t GDScriptNativeFunctions::hash_code(const int32_t *p_code, uint32_t p_code_size) {
+	return hash_murmur3_buffer(p_code, p_code_size * sizeof(int32_t));
+}
+
+GDScriptNativeFunctionPtr GDScriptNativeFunctions::find(const GDScriptFunction *p_function) {
+	if (!enabled || !first) {
+		return nullptr;
+	}
+
+	const Vector<int32_t> code = normalize(p_function);
+	if (code.is_empty()) {
+		return nullptr;
+	}
+
+	const uint32_t hash = hash_code(code.ptr(), code.size());
+	for (const Registration *E = first; E; E = E->next) {
+		if (E->hash == hash && E->code_size == (uint32_t)code.size() && memcmp(E->code, code.ptr(), code.size() * sizeof(int32_t)) == 0) {
+			return E->function;
+		}
+	}
+	return nullptr;
+}
+
+Variant GDScriptNativeFunctions::call_static(const GDScriptFunction *p_function, GDScriptNativeFunctionPtr p_native, const Variant **p_args, int p_argcount) {
+	ERR_FAIL_NULL_V(p_native, Variant());
+	ERR_FAIL_COND_V(p_argcount != p_function->_argument_count, Variant());
+
+	LocalVector<Variant> stack;
+	stack.resize(p_function->_stack_size);
+	stack[GDScriptFunction::ADDR_STACK_CLASS] = p_function->_script;
+	for (int i = 0; i < p_argcount; i++) {
+		stack[i + GDScriptFunction::FIXED_ADDRESSES_MAX] = *p_args[i];
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		Callable::CallError ce;
+		Variant::construct(E.value, stack[E.key], nullptr, 0, ce);
+	}
+
+	GDScriptNativeFrame frame;
+	frame.stack = stack.ptr();
+	frame.constants = p_function->_constants_ptr;
+	frame.operator_funcs = p_function->_operator_funcs_ptr;
+	frame.builtin_methods = p_function->_builtin_methods_ptr;
+	frame.constructors = p_function->_constructors_ptr;
+	frame.utilities = p_function->_utilities_ptr;
+	frame.methods = p_function->_methods_ptr;
+	frame.caller_memory_tag = Memory::get_current_tag();
+
+	Variant ret;
+	p_native(frame, ret);
+	return ret;
+}
+
+void GDScriptNativeFunctions::return_typed_builtin(Variant *p_value, Variant::Type p_type, Variant &r_ret) {
+	// Same as OPCODE_RETURN_TYPED_BUILTIN in release builds.
+	if (p_value->get_type() == p_type) {
+		r_ret = *p_value;
+		return;
+	}
+	Callable::CallError ce;
+	if (Variant::can_convert_strict(p_value->get_type(), p_type)) {
+		Variant::construct(p_type, r_ret, const_cast<const Variant **>(&p_value), 1, ce);
+	} else {
+		Variant::construct(p_type, r_ret, nullptr, 0, ce);
+	}
+}
+
+void GDScriptNativeFunctions::assign_typed_builtin(Variant *p_dst, Variant *p_src, Variant::Type p_type) {
+	// Same as OPCODE_ASSIGN_TYPED_BUILTIN in release builds.
+	if (p_src->get_type() != p_type) {
+		Callable::CallError ce;
+		Variant::construct(p_type, *p_dst, const_cast<const Variant **>(&p_src), 1, ce);
+	} else {
+		*p_dst = *p_src;
+	}
+}
+
+#ifdef TOOLS_ENABLED
+
+String GDScriptNativeTranslator::_address(int p_address) {
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_STACK:
+			return vformat("s[%d]", index);
+		case GDScriptFunction::ADDR_TYPE_CONSTANT:
+			return vformat("c[%d]", index);
+		case GDScriptFunction::ADDR_TYPE_MEMBER:
+			return vformat("m[%d]", index);
+	}
+	ERR_FAIL_V_MSG("s[0]", "Invalid address type.");
+}
+
+String GDScriptNativeTranslator::_translate_code(const Vector<int32_t> &p_code, const String &p_symbol) {
+	static const char *type_adjust_types[] = {
+		"bool",
+		"int64_t",
+		"double",
+		"String",
+		"Vector2",
+		"Vector2i",
+		"Rect2",
+		"Rect2i",
+		"Vector3",
+		"Vector3i",
+		"Transform2D",
+		"Vector4",
+		"Vector4i",
+		"Plane",
+		"Quaternion",
+		"AABB",
+		"Basis",
+		"Transform3D",
+		"Projection",
+		"Color",
+	};
+	static_assert(std::size(type_adjust_types) == GDScriptFunction::OPCODE_TYPE_ADJUST_COLOR - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL + 1);
+
+	const int32_t *body = p_code.ptr() + NORMALIZED_HEADER_SIZE;
+	const int body_size = p_code.size() - NORMALIZED_HEADER_SIZE;
+
+	// Only emit labels that are jumped to.
+	HashSet<int> labels;
+	for (int ip = 0; ip < body_size;) {
+		int size = 0;
+		int jump_offset = -1;
+		GDScriptNativeFunctions::_get_instruction_layout(body, body_size, ip, size, jump_offset);
+		if (jump_offset >= 0) {
+			labels.insert(body[ip + jump_offset]);
+		}
+		ip += size;
+	}
+
+#define ADDR(m_ofs) _address(body[ip + (m_ofs)])
+#define JUMP_TO(m_ofs) vformat("goto L%d;", body[ip + (m_ofs)])
+
+	String out;
+	out += vformat("static void %s(const GDScriptNativeFrame &p_frame, Variant &r_ret) {\n", p_symbol);
+	out += "\t[[maybe_unused]] Variant *s = p_frame.stack;\n";
+	out += "\t[[maybe_unused]] Variant *c = p_frame.constants;\n";
+	out += "\t[[maybe_unused]] Variant *m = p_frame.members;\n";
+
+	for (int ip = 0; ip < body_size;) {
+		int size = 0;
+		int jump_offset = -1;
+		GDScriptNativeFunctions::_get_instruction_layout(body, body_size, ip, size, jump_offset);
+
+		if (labels.has(ip)) {
+			out += vformat("L%d:\n", ip);
+		}
+
+		String line;
+		const int opcode = body[ip];
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_END:
+				line = "return;";
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+				line = vformat("%s = Variant();", ADDR(1));
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+				line = vformat("%s = true;", ADDR(1));
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				line = vformat("%s = false;", ADDR(1));
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN:
+				line = vformat("%s = %s;", ADDR(1), ADDR(2));
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+				line = vformat("GDScriptNativeFunctions::assign_typed_builtin(&%s, &%s, Variant::Type(%d));", ADDR(1), ADDR(2), body[ip + 3]);
+				break;
+			case GDScriptFunction::OPCODE_RETURN:
+				line = vformat("r_ret = %s;\n\treturn;", ADDR(1));
+				break;
+			case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+				line = vformat("GDScriptNativeFunctions::return_typed_builtin(&%s, Variant::Type(%d), r_ret);\n\treturn;", ADDR(1), body[ip + 2]);
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+				line = vformat("p_frame.operator_funcs[%d](&%s, &%s, &%s);", body[ip + 4], ADDR(1), ADDR(2), ADDR(3));
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+				line = vformat("p_frame.operator_funcs[%d](&%s, &%s, &%s);\n", body[ip + 4], ADDR(1), ADDR(2), ADDR(3));
+				line += vformat("\tif (%s*VariantInternal::get_bool(&%s)) {\n\t\t%s\n\t}", opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF ? "" : "!", ADDR(3), JUMP_TO(5));
+				break;
+			case GDScriptFunction::OPCODE_JUMP:
+				line = JUMP_TO(1);
+				break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				line = vformat("if (%s%s.booleanize()) {\n\t\t%s\n\t}", opcode == GDScriptFunction::OPCODE_JUMP_IF ? "" : "!", ADDR(1), JUMP_TO(2));
+				break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE:
+				line = "{\n";
+				line += vformat("\t\tconst int64_t from = *VariantInternal::get_int(&%s);\n", ADDR(2));
+				line += vformat("\t\tconst int64_t to = *VariantInternal::get_int(&%s);\n", ADDR(3));
+				line += vformat("\t\tconst int64_t step = *VariantInternal::get_int(&%s);\n", ADDR(4));
+				line += vformat("\t\tVariantInternal::initialize(&%s, Variant::INT);\n", ADDR(1));
+				line += vformat("\t\t*VariantInternal::get_int(&%s) = from;\n", ADDR(1));
+				line += "\t\tif (from == to ? true : (from < to ? step <= 0 : step >= 0)) {\n";
+				line += vformat("\t\t\t%s\n", JUMP_TO(6));
+				line += "\t\t}\n";
+				line += vformat("\t\tVariantInternal::initialize(&%s, Variant::INT);\n", ADDR(5));
+				line += vformat("\t\t*VariantInternal::get_int(&%s) = from;\n", ADDR(5));
+				line += "\t}";
+				break;
+			case GDScriptFunction::OPCODE_ITERATE_RANGE:
+				line = "{\n";
+				line += vformat("\t\tconst int64_t to = *VariantInternal::get_int(&%s);\n", ADDR(2));
+				line += vformat("\t\tconst int64_t step = *VariantInternal::get_int(&%s);\n", ADDR(3));
+				line += vformat("\t\tint64_t *count = VariantInternal::get_int(&%s);\n", ADDR(1));
+				line += "\t\t*count += step;\n";
+				line += "\t\tif ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {\n";
+				line += vformat("\t\t\t%s\n", JUMP_TO(5));
+				line += "\t\t}\n";
+				line += vformat("\t\t*VariantInternal::get_int(&%s) = *count;\n", ADDR(4));
+				line += "\t}";
+				break;
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+				// Instruction arguments are the call arguments followed by the base and return value (or just the return value for utilities and constructors).
+				const int instr_arg_count = body[ip + 1];
+				const int argc = body[ip + 2 + instr_arg_count];
+				const int index = body[ip + 3 + instr_arg_count];
+#define INSTR_ARG(m_idx) _address(body[ip + 2 + (m_idx)])
+
+				line = "{\n";
+				if (argc > 0) {
+					line += "\t\tconst Variant *args[] = { ";
+					for (int i = 0; i < argc; i++) {
+						line += (i > 0 ? ", &" : "&") + INSTR_ARG(i);
+					}
+					line += " };\n";
+				} else {
+					line += "\t\tconst Variant **args = nullptr;\n";
+				}
+				switch (opcode) {
+					case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+						line += "\t\tMemory::TagScope native_memory_tag(p_frame.caller_memory_tag);\n";
+						line += vformat("\t\tp_frame.methods[%d]->validated_call(*VariantInternal::get_object(&%s), args, &%s);\n", index, INSTR_ARG(argc), INSTR_ARG(argc + 1));
+						break;
+					case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+						line += vformat("\t\tVariantInternal::initialize(&%s, Variant::NIL);\n", INSTR_ARG(argc + 1));
+						line += "\t\tMemory::TagScope native_memory_tag(p_frame.caller_memory_tag);\n";
+						line += vformat("\t\tp_frame.methods[%d]->validated_call(*VariantInternal::get_object(&%s), args, nullptr);\n", index, INSTR_ARG(argc));
+						break;
+					case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+						line += vformat("\t\tp_frame.builtin_methods[%d](&%s, args, %d, &%s);\n", index, INSTR_ARG(argc), argc, INSTR_ARG(argc + 1));
+						break;
+					case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+						line += vformat("\t\tp_frame.utilities[%d](&%s, args, %d);\n", index, INSTR_ARG(argc), argc);
+						break;
+					default:
+						line += vformat("\t\tp_frame.constructors[%d](&%s, args);\n", index, INSTR_ARG(argc));
+						break;
+				}
+				line += "\t}";
+#undef INSTR_ARG
+			} break;
+			default:
+				line = vformat("VariantTypeAdjust<%s>::adjust(&%s);", type_adjust_types[opcode - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL], ADDR(1));
+				break;
+		}
+
+		out += "\t" + line + "\n";
+		ip += size;
+	}
+
+	if (labels.has(body_size)) {
+		out += vformat("L%d:\n\treturn;\n", body_size);
+	}
+	out += "}\n";
+
+#undef ADDR
+#undef JUMP_TO
+	return out;
+}
+
+bool GDScriptNativeTranslator::add_function(const GDScriptFunction *p_function, String *r_reason) {
+	ERR_FAIL_NULL_V(p_function, false);
+
+	Vector<int32_t> code = GDScriptNativeFunctions::normalize(p_function, r_reason);
+	if (code.is_empty()) {
+		return false;
+	}
+
+	for (const Entry &E : entries) {
+		if (E.code == code) {
+			return true;
+		}
+	}
+
+	Entry entry;
+	entry.name = String(p_function->source) + "::" + String(p_function->name);
+	entry.code = code;
+	entries.push_back(entry);
+	return true;
+}
+
+int GDScriptNativeTranslator::add_script(const GDScript *p_script) {
+	ERR_FAIL_NULL_V(p_script, 0);
+
+	int count = 0;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
+		if (add_function(E.value)) {
+			count++;
+		}
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+		count += add_script(E.value.ptr());
+	}
+	return count;
+}
+
+String GDScriptNativeTranslator::generate_source() const {
+	String out;
+	out += "// This file is generated by the GDScript exporter, do not edit.\n";
+	out += "// Compile it into a release export template (for example as part of a custom module)\n";
+	out += "// to run the functions below natively instead of in the GDScript VM.\n\n";
+	out += "#include \"modules/gdscript/gdscript_native.h\"\n\n";
+	out += "#include \"core/object/method_bind.h\"\n";
+	out += "#include \"core/variant/variant_internal.h\"\n";
+
+	for (int i = 0; i < entries.size(); i++) {
+		const Entry &entry = entries[i];
+		const String symbol = vformat("gdscript_native_%d", i);
+
+		out += vformat("\n// %s\n", entry.name);
+		out += vformat("static const int32_t %s_code[] = {", symbol);
+		for (int j = 0; j < entry.code.size(); j++) {
+			out += (j % 16 == 0 ? "\n\t" : " ") + itos(entry.code[j]) + ",";
+		}
+		out += "\n};\n\n";
+		out += _translate_code(entry.code, symbol);
+		out += vformat("\nstatic GDScriptNativeFunctions::Registration %s_registration(%s_code, %d, &%s);\n", symbol, symbol, entry.code.size(), symbol);
+	}
+
+	return out;
+}
+
+#endif // TOOLS_ENABLED
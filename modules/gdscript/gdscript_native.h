@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  gdscript_native.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/variant.h"
+
+class GDScript;
+class GDScriptFunction;
+class MethodBind;
+
+// Everything a function translated to C++ by GDScriptNativeTranslator needs
+// from the running script. The stack is laid out exactly as the VM lays it out.
+struct GDScriptNativeFrame {
+	Variant *stack = nullptr;
+	Variant *members = nullptr;
+	Variant *constants = nullptr;
+	const Variant::ValidatedOperatorEvaluator *operator_funcs = nullptr;
+	const Variant::ValidatedBuiltInMethod *builtin_methods = nullptr;
+	const Variant::ValidatedConstructor *constructors = nullptr;
+	const Variant::ValidatedUtilityFunction *utilities = nullptr;
+	MethodBind *const *methods = nullptr;
+	// Native methods run with the tag the script was called with, as in the VM.
+	Memory::Tag caller_memory_tag = Memory::TAG_UNTAGGED;
+};
+
+typedef void (*GDScriptNativeFunctionPtr)(const GDScriptNativeFrame &p_frame, Variant &r_ret);
+
+// Registry of functions translated ahead of time. A translated function is
+// identified by its normalized bytecode, which doesn't depend on line tracking,
+// so any compiled function with the exact same code can run it. Constants,
+// members and method binds are still taken from the running script.
+class GDScriptNativeFunctions {
+public:
+	// Generated code registers itself with static instances of this, which
+	// only link pointers so they are safe to construct before main().
+	struct Registration {
+		const int32_t *code = nullptr;
+		uint32_t code_size = 0;
+		uint32_t hash = 0;
+		GDScriptNativeFunctionPtr function = nullptr;
+		Registration *next = nullptr;
+
+		Registration(const int32_t *p_code, uint32_t p_code_size, GDScriptNativeFunctionPtr p_function);
+		~Registration();
+	};
+
+private:
+	static Registration *first;
+	static bool enabled;
+
+	static bool _get_instruction_layout(const int *p_code, int p_code_size, int p_ip, int &r_size, int &r_jump_offset);
+
+public:
+	// Bytecode without line opcodes and with jump targets adjusted accordingly,
+	// preceded by a small header. Empty if the function uses anything that
+	// can't be translated, see GDScriptNativeTranslator.
+	static Vector<int32_t> normalize(const GDScriptFunction *p_function, String *r_reason = nullptr);
+	static uint32_t hash_code(const int32_t *p_code, uint32_t p_code_size);
+	static GDScriptNativeFunctionPtr find(const GDScriptFunction *p_function);
+	static bool has_registrations() { return first != nullptr; }
+
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+
+	// Runs `p_native` as `p_function` would run, on a stack laid out like
+	// GDScriptFunction::call() lays it out, for functions that don't use
+	// members. Arguments must already have the parameter types. Used to check
+	// translations against the VM.
+	static Variant call_static(const GDScriptFunction *p_function, GDScriptNativeFunctionPtr p_native, const Variant **p_args, int p_argcount);
+
+	// Used by generated code.
+	static void return_typed_builtin(Variant *p_value, Variant::Type p_type, Variant &r_ret);
+	static void assign_typed_builtin(Variant *p_dst, Variant *p_src, Variant::Type p_type);
+
+	friend class GDScriptNativeTranslator;
+};
+
+#ifdef TOOLS_ENABLED
+// Translates fully statically typed functions to C++ source for export. Each
+// instruction becomes the same call the VM would make with its operands
+// resolved at translation time, so the generated code has no dispatch and no
+// operand decoding. The output is meant to be compiled into an export
+// template, where release builds pick the functions up when scripts load.
+// Functions using `assert` or `breakpoint` are never translated: the editor
+// compiles them with debug-only code that release builds leave out, so
+// their bytecode could not match anyway.
+class GDScriptNativeTranslator {
+	struct Entry {
+		String name;
+		Vector<int32_t> code;
+	};
+
+	Vector<Entry> entries;
+
+	static String _address(int p_address);
+	static String _translate_code(const Vector<int32_t> &p_code, const String &p_symbol);
+
+public:
+	// Returns true if the function was added (or an identical one already was).
+	bool add_function(const GDScriptFunction *p_function, String *r_reason = nullptr);
+	// Adds every translatable function of the script and its inner classes,
+	// returns how many were added.
+	int add_script(const GDScript *p_script);
+
+	int get_function_count() const { return entries.size(); }
+	String generate_source() const;
+};
+#endif // TOOLS_ENABLED
@@ -2763,6 +2763,8 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_identifier(ExpressionNode
 			case SuiteNode::Local::UNDEFINED:
 				ERR_FAIL_V_MSG(nullptr, "Undefined local found.");
 		}
+	} else {
+		referenced_identifiers.insert(identifier->name);
 	}
 
 	return identifier;
@@ -3591,6 +3593,10 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 		push_error(R"(Expected resource path after "(".)");
 	} else if (preload->path->type == Node::LITERAL) {
 		override_completion_context(preload->path, COMPLETION_RESOURCE_PATH, preload);
+		const Variant &path = static_cast<LiteralNode *>(preload->path)->value;
+		if (path.get_type() == Variant::STRING) {
+			preload_paths.push_back(path);
+		}
 	}
 
 	pop_completion_call();
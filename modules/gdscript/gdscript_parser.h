@@ -1343,6 +1343,10 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// Non-local names and literal preload paths, so the scripts this one likely
+	// depends on can be found before analysis. See `GDScriptCache`.
+	HashSet<StringName> referenced_identifiers;
+	Vector<String> preload_paths;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1602,6 +1606,8 @@ public:
 	bool is_tool() const { return _is_tool; }
 	Ref<GDScriptParserRef> get_depended_parser_for(const String &p_path);
 	const HashMap<String, Ref<GDScriptParserRef>> &get_depended_parsers();
+	const HashSet<StringName> &get_referenced_identifiers() const { return referenced_identifiers; }
+	const Vector<String> &get_preload_paths() const { return preload_paths; }
 	ClassNode *find_class(const String &p_qualified_name) const;
 	bool has_class(const GDScriptParser::ClassNode *p_class) const;
 	static Variant::Type get_builtin_type(const StringName &p_type); // Excluding `Variant::NIL` and `Variant::OBJECT`.
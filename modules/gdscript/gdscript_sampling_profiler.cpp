@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_epoch;
+thread_local uint32_t GDScriptSamplingProfiler::seen_epoch = 0;
+uint32_t GDScriptSamplingProfiler::start_epoch = 0;
+
+void GDScriptSamplingProfiler::_thread_func(void *p_user) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_user);
+	while (profiler->running.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		sample_epoch.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample(uint32_t p_epoch, uint32_t p_seen_epoch) {
+	// The epoch also moves on while stopping, and threads catch up with it lazily.
+	if (singleton == nullptr || !singleton->running.is_set()) {
+		return;
+	}
+
+	// Epochs from before the profiler started don't count. Differences stay correct when the counter wraps.
+	const uint32_t weight = MIN(p_epoch - p_seen_epoch, p_epoch - start_epoch);
+	if (weight == 0) {
+		return;
+	}
+	const String folded_stack = GDScriptLanguage::get_singleton()->get_folded_call_stack();
+	if (!folded_stack.is_empty()) {
+		singleton->add_sample(folded_stack, weight);
+	}
+}
+
+Error GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_V_MSG(running.is_set(), ERR_ALREADY_IN_USE, "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND_V_MSG(!GDScriptLanguage::get_singleton()->should_track_call_stack(), ERR_UNAVAILABLE, R"(The GDScript sampling profiler needs call stacks. Enable the "debug/settings/gdscript/always_track_call_stacks" project setting to use it in release builds.)");
+
+	clear();
+	interval_usec = MAX(p_interval_usec, MIN_INTERVAL_USEC);
+	start_epoch = sample_epoch.get();
+	running.set();
+	thread.start(_thread_func, this);
+	return OK;
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::add_sample(const String &p_folded_stack, uint64_t p_count) {
+	MutexLock lock(mutex);
+	uint64_t *count = stacks.getptr(p_folded_stack);
+	if (count) {
+		*count += p_count;
+	} else {
+		stacks.insert(p_folded_stack, p_count);
+	}
+	sample_count += p_count;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+	sample_count = 0;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+
+	// Sorted, so that profiles of the same run diff cleanly.
+	Vector<String> keys;
+	keys.resize(stacks.size());
+	int idx = 0;
+	for (const KeyValue<String, uint64_t> &E : stacks) {
+		keys.write[idx++] = E.key;
+	}
+	keys.sort();
+
+	String collapsed;
+	for (const String &key : keys) {
+		collapsed += key + " " + itos(stacks[key]) + "\n";
+	}
+	return collapsed;
+}
+
+Error GDScriptSamplingProfiler::save_collapsed_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot open file "%s" to write the GDScript profile.)", p_path));
+	file->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		stop();
+		start(p_opts.size() > 0 ? uint32_t(int(p_opts[0])) : DEFAULT_INTERVAL_USEC);
+		return;
+	}
+
+	stop();
+	if (EngineDebugger::is_active()) {
+		Array data = { get_collapsed_stacks(), get_sample_count() };
+		EngineDebugger::get_singleton()->send_message("gdscript_sampler:stacks", data);
+	}
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
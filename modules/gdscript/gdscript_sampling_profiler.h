@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Statistical profiler for GDScript. A background thread bumps a sample epoch
+// at a fixed interval, and every interpreter thread folds its own call stack
+// into a shared aggregate at its next safepoint (function entry or jump). The
+// call stacks are thread-local, so they can't be read from the sampling thread.
+// A thread that missed several epochs, for example while in a long native call,
+// records its stack once with the number of epochs missed as the weight.
+// Results are kept as collapsed stacks, the text format read by flamegraph.pl,
+// speedscope and most other flame graph tools.
+class GDScriptSamplingProfiler : public EngineProfiler {
+	static GDScriptSamplingProfiler *singleton;
+
+	static SafeNumeric<uint32_t> sample_epoch;
+	static thread_local uint32_t seen_epoch;
+	static uint32_t start_epoch;
+
+	Thread thread;
+	SafeFlag running;
+	uint32_t interval_usec = DEFAULT_INTERVAL_USEC;
+
+	Mutex mutex;
+	HashMap<String, uint64_t> stacks;
+	uint64_t sample_count = 0;
+
+	static void _thread_func(void *p_user);
+	static void _take_sample(uint32_t p_epoch, uint32_t p_seen_epoch);
+
+public:
+	static constexpr uint32_t DEFAULT_INTERVAL_USEC = 1000;
+	static constexpr uint32_t MIN_INTERVAL_USEC = 100;
+
+	static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+
+	// Called by the VM at safepoints. Only touches a shared counter and a
+	// thread-local unless a sample is due.
+	_FORCE_INLINE_ static void poll() {
+		const uint32_t epoch = sample_epoch.get();
+		if (unlikely(epoch != seen_epoch)) {
+			const uint32_t previous = seen_epoch;
+			seen_epoch = epoch;
+			_take_sample(epoch, previous);
+		}
+	}
+
+	Error start(uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	void stop();
+	bool is_running() const { return running.is_set(); }
+
+	void add_sample(const String &p_folded_stack, uint64_t p_count = 1);
+	void clear();
+	uint64_t get_sample_count();
+	String get_collapsed_stacks();
+	Error save_collapsed_stacks(const String &p_path);
+
+	// Remote debugger interface, registered as the "gdscript_sampler" profiler.
+	// The optional first option is the sampling interval in microseconds. The
+	// aggregate is sent as a "gdscript_sampler:stacks" message when disabled.
+	virtual void toggle(bool p_enable, const Array &p_opts) override;
+	virtual void add(const Array &p_data) override {}
+	virtual void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override {}
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
@@ -32,7 +32,9 @@
 
 #include "gdscript.h"
 #include "gdscript_cache.h"
+#include "gdscript_native.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
@@ -70,6 +72,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+Ref<GDScriptSamplingProfiler> gdscript_sampling_profiler;
 
 #ifdef TOOLS_ENABLED
 
@@ -81,7 +84,15 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	// Where to write C++ translations of statically typed functions, empty to disable.
+	String native_source_path;
+	GDScriptNativeTranslator native_translator;
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_source_path", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
 
@@ -89,10 +100,24 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		native_source_path = get_option("gdscript/native_source_path");
+		native_translator = GDScriptNativeTranslator();
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd") {
+			return;
+		}
+
+		if (!native_source_path.is_empty()) {
+			Ref<GDScript> scr = ResourceLoader::load(p_path);
+			if (scr.is_valid() && scr->is_valid()) {
+				native_translator.add_script(scr.ptr());
+			}
+		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
 			return;
 		}
 
@@ -111,6 +136,17 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (native_source_path.is_empty()) {
+			return;
+		}
+
+		Ref<FileAccess> f = FileAccess::open(native_source_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot write GDScript native source to \"%s\".", native_source_path));
+		f->store_string(native_translator.generate_source());
+		print_verbose(vformat("GDScript: Translated %d functions to \"%s\".", native_translator.get_function_count(), native_source_path));
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
@@ -151,6 +187,9 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		gdscript_cache = memnew(GDScriptCache);
 
+		gdscript_sampling_profiler.instantiate();
+		gdscript_sampling_profiler->bind("gdscript_sampler");
+
 		GDScriptUtilityFunctions::register_functions();
 	}
 
@@ -168,6 +207,8 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+		gdscript_sampling_profiler.unref(); // Stops sampling and unbinds.
+
 		ScriptServer::unregister_language(script_language_gd);
 
 		if (gdscript_cache) {
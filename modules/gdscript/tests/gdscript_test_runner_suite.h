@@ -32,6 +32,8 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_byte_codegen.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -47,6 +49,16 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime without bytecode optimizations") {
+		// The same scripts and expected results, so optimized and unoptimized bytecode must behave the same.
+		GDScriptByteCodeGenerator::set_optimizations_enabled(false);
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, false, false);
+		int fail_count = runner.run_tests();
+		GDScriptByteCodeGenerator::set_optimizations_enabled(true);
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass without bytecode optimizations.");
+	}
 }
 #endif // TOOLS_ENABLED
 
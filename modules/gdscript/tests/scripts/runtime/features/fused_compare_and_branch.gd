@@ -0,0 +1,77 @@
+# Typed comparisons feeding a branch are compiled into a single compare-and-branch
+# instruction, and compound assignments to typed locals write their result in place.
+# None of this may change what the code does.
+
+func count_below(values: Array[int], limit: int) -> int:
+	var count := 0
+	for value in values:
+		if value < limit:
+			count += 1
+	return count
+
+func classify(x: int) -> String:
+	if x < 0:
+		return "negative"
+	elif x == 0:
+		return "zero"
+	elif x > 100:
+		return "large"
+	return "positive"
+
+func test():
+	print(count_below([1, 5, 3, 8, 2], 4))
+	print([classify(-3), classify(0), classify(7), classify(1000)])
+
+	var i := 0
+	var total := 0
+	while i < 10:
+		total += i
+		i += 1
+	print([i, total])
+
+	var f := 1.0
+	while f < 100.0:
+		f *= 3.0
+	print(f)
+
+	var v := Vector2i(1, 2)
+	v += Vector2i(3, 4)
+	v *= 2
+	print(v)
+
+	# Both operands are read before the target is written.
+	var n := 3
+	n += n
+	n *= n
+	n -= 1
+	print(n)
+
+	var m := 17
+	m %= 5
+	print(m)
+
+	var a := 4
+	var b := 9
+	print(a < b and b < 10)
+	print(a > b or b == 9)
+	print(a > b and b == 9)
+	print("less" if a < b else "not less")
+
+	var hits := 0
+	for j in range(20):
+		if j % 2 == 0 and j > 10:
+			hits += 1
+		elif j == 3 or j == 5:
+			hits += 10
+	print(hits)
+
+	var found := -1
+	var k := 0
+	while k < 100:
+		k += 1
+		if k % 7 != 0:
+			continue
+		if k > 20:
+			found = k
+			break
+	print(found)
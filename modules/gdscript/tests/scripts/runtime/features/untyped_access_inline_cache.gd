@@ -0,0 +1,112 @@
+# Untyped accesses are sped up by per-instruction caches. The same instruction
+# must keep giving the right result when it sees different kinds of receivers,
+# including more of them than a cache can hold.
+
+class A:
+	var value = 1
+	var typed_value: float = 0.5
+	func describe():
+		return "A %s" % value
+
+class B:
+	var padding = 0
+	var value = 2
+	var typed_value: float = 1.5
+	func describe():
+		return "B %s" % value
+
+class C extends A:
+	func describe():
+		return "C %s" % value
+
+class WithAccessors:
+	var backing = 0
+	var value:
+		get:
+			return backing * 10
+		set(v):
+			backing = v
+	var typed_value: float = 0.0
+	func describe():
+		return "WithAccessors %s" % value
+
+class Dynamic:
+	func _get(property):
+		if property == &"value":
+			return 42
+		return null
+
+class Moving extends Node2D:
+	var speed = 3
+
+func read_value(obj):
+	return obj.value
+
+func write_value(obj, v):
+	obj.value = v
+
+func write_typed_value(obj, v):
+	obj.typed_value = v
+	return typeof(obj.typed_value) == TYPE_FLOAT
+
+func describe(obj):
+	return obj.describe()
+
+func read_x(v):
+	return v.x
+
+func write_x(v, x):
+	v.x = x
+	return v
+
+func read_position(obj):
+	return obj.position
+
+func write_position(obj, v):
+	obj.position = v
+
+func get_class_of(obj):
+	return obj.get_class()
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), WithAccessors.new(), Dynamic.new(), { value = 7 }]
+	for _i in 2:
+		var values = []
+		for obj in receivers:
+			values.push_back(read_value(obj))
+		print(values)
+
+	var objects = [receivers[0], receivers[1], receivers[2], receivers[3]]
+	var written = []
+	for obj in objects:
+		write_value(obj, 5)
+	for obj in objects:
+		written.push_back(read_value(obj))
+	print(written)
+
+	var typed = []
+	for obj in objects:
+		typed.push_back(write_typed_value(obj, 3))
+	for obj in objects:
+		typed.push_back(write_typed_value(obj, 2.5))
+	print(typed)
+
+	for _i in 2:
+		var descriptions = []
+		for obj in objects:
+			descriptions.push_back(describe(obj))
+		print(descriptions)
+
+	print([read_x(Vector2(3, 4)), read_x(Vector3(5, 6, 7)), read_x(Vector2i(8, 9))])
+	print(write_x(Vector2(3, 4), 7))
+	print(write_x(Vector2(3, 4), 1.5))
+
+	var node = Node2D.new()
+	var moving = Moving.new()
+	for i in 2:
+		write_position(node, Vector2(1, 2 + i))
+		write_position(moving, Vector2(4, 5 + i))
+		print([read_position(node), read_position(moving), moving.speed])
+	print([get_class_of(node), get_class_of(moving), get_class_of(receivers[0])])
+	node.free()
+	moving.free()
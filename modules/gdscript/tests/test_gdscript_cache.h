@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript_cache.h"
+#include "gdscript_test_runner.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static void write_cache_test_script(const String &p_path, const String &p_source) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+}
+
+static void remove_cache_test_scripts(const String &p_dir, const Vector<String> &p_names) {
+	for (const String &name : p_names) {
+		GDScriptCache::remove_script(p_dir.path_join(name));
+		DirAccess::remove_absolute(p_dir.path_join(name));
+	}
+	DirAccess::remove_absolute(p_dir);
+}
+
+static void check_gdscript_dependency_loading(bool p_parallel) {
+	const String dir = TestUtils::get_temp_path(p_parallel ? "gdscript_cache_parallel" : "gdscript_cache_serial");
+	DirAccess::make_dir_recursive_absolute(dir);
+
+	write_cache_test_script(dir.path_join("root.gd"), R"(
+extends "base.gd"
+
+const Left = preload("left.gd")
+const Right = preload("./right.gd")
+
+static func total() -> int:
+	return Left.value() + Right.value() + base_value()
+)");
+	write_cache_test_script(dir.path_join("base.gd"), R"(
+extends RefCounted
+
+static func base_value() -> int:
+	return 100
+)");
+	write_cache_test_script(dir.path_join("left.gd"), R"(
+extends RefCounted
+
+static func value() -> int:
+	return 1
+)");
+	write_cache_test_script(dir.path_join("right.gd"), R"(
+extends RefCounted
+
+const Left = preload("left.gd")
+
+static func value() -> int:
+	return Left.value() + 10
+)");
+
+	GDScriptCache::set_parallel_parsing_enabled(p_parallel);
+	Error error = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(dir.path_join("root.gd"), error);
+	GDScriptCache::set_parallel_parsing_enabled(true);
+
+	REQUIRE(error == OK);
+	REQUIRE(gdscript.is_valid());
+	CHECK(gdscript->is_valid());
+	CHECK(int(gdscript->call("total")) == 112);
+
+	gdscript.unref();
+	remove_cache_test_scripts(dir, { "root.gd", "base.gd", "left.gd", "right.gd" });
+}
+
+TEST_CASE("[Modules][GDScript] Loading scripts with dependencies") {
+	GDScriptLanguage::get_singleton()->init();
+
+	SUBCASE("Serial parsing") {
+		check_gdscript_dependency_loading(false);
+	}
+	SUBCASE("Dependencies parsed in parallel") {
+		check_gdscript_dependency_loading(true);
+	}
+}
+
+// Returns the time to load the root script of the project in milliseconds.
+static double benchmark_gdscript_project_load(const String &p_dir, int p_count, bool p_parallel) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	Vector<String> names;
+	String root_source = "extends RefCounted\n\n";
+	for (int i = 0; i < p_count; i++) {
+		const String name = vformat("script_%d.gd", i);
+		names.push_back(name);
+		root_source += vformat("const Script%d = preload(\"%s\")\n", i, name);
+
+		String source = "extends RefCounted\n\nvar counter := 0\n";
+		for (int j = 0; j < 20; j++) {
+			source += vformat("\nfunc method_%d(value: int) -> int:\n\tvar result := value\n\tfor k in range(%d):\n\t\tresult += k * %d\n\tif result > %d:\n\t\tcounter += 1\n\treturn result\n", j, j + 1, i, j * 10);
+		}
+		write_cache_test_script(p_dir.path_join(name), source);
+	}
+	names.push_back("root.gd");
+	write_cache_test_script(p_dir.path_join("root.gd"), root_source);
+
+	GDScriptCache::set_parallel_parsing_enabled(p_parallel);
+	Error error = OK;
+	Ref<GDScript> gdscript;
+	const double msec = benchmark_msec(1, [&]() {
+		gdscript = GDScriptCache::get_full_script(p_dir.path_join("root.gd"), error);
+	});
+	GDScriptCache::set_parallel_parsing_enabled(true);
+	CHECK(error == OK);
+
+	gdscript.unref();
+	remove_cache_test_scripts(p_dir, names);
+	return msec;
+}
+
+TEST_CASE_BENCHMARK("[Modules][GDScript] Project load with parallel parsing") {
+	const int COUNT = 500;
+
+	GDScriptLanguage::get_singleton()->init();
+	// Each load uses fresh paths, so both start with nothing cached.
+	const double serial = benchmark_gdscript_project_load(TestUtils::get_temp_path("gdscript_load_serial"), COUNT, false);
+	const double parallel = benchmark_gdscript_project_load(TestUtils::get_temp_path("gdscript_load_parallel"), COUNT, true);
+	print_line(vformat("Loading %d scripts: serial parsing %.3f ms, parallel parsing %.3f ms.", COUNT, serial, parallel));
+}
+
+} // namespace GDScriptTests
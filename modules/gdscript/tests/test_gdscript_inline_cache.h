@@ -0,0 +1,212 @@
+/**************************************************************************/
+/*  test_gdscript_inline_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript_inline_cache.h"
+#include "gdscript_test_runner.h"
+
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Returns the time of the whole call in milliseconds.
+static double benchmark_gdscript_call(Object *p_runner, const StringName &p_method, const Variant &p_receiver, int p_count, bool p_use_cache) {
+	GDScriptInlineCache::set_enabled(p_use_cache);
+	const double msec = benchmark_msec(1, [&]() {
+		p_runner->call(p_method, p_receiver, p_count);
+	});
+	GDScriptInlineCache::set_enabled(true);
+	return msec;
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches follow the receiver") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+class A:
+	var value = 1
+	func get_value():
+		return value
+
+class B extends A:
+	func get_value():
+		return value * 10
+
+class C:
+	var value = 3
+	func get_value():
+		return value * 100
+
+func make_receivers():
+	return [A.new(), B.new(), C.new(), Vector2(4, 0), Vector3(5, 0, 0), Vector4(6, 0, 0, 0)]
+
+func sum_values(receivers):
+	var total = 0
+	for receiver in receivers:
+		if receiver is A or receiver is C:
+			total += receiver.value + receiver.get_value()
+		else:
+			total += receiver.x
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> runner = memnew(RefCounted);
+	runner->set_script(gdscript);
+	const Array receivers = runner->call("make_receivers");
+	// More shapes than a cache holds, so the sites become megamorphic.
+	const int64_t expected = (1 + 1) + (1 + 10) + (3 + 300) + 4 + 5 + 6;
+	for (int i = 0; i < 3; i++) {
+		CHECK(int64_t(runner->call("sum_values", receivers)) == expected);
+	}
+
+	GDScriptInlineCache::set_enabled(false);
+	CHECK(int64_t(runner->call("sum_values", receivers)) == expected);
+	GDScriptInlineCache::set_enabled(true);
+}
+
+TEST_CASE_BENCHMARK("[Modules][GDScript] Untyped property access and method calls") {
+	const int COUNT = 1000000;
+
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+class Enemy:
+	var health = 100
+	func hit(amount):
+		health -= amount
+		return health
+
+func make_enemy():
+	return Enemy.new()
+
+func untyped_script_members(enemy, count):
+	var total = 0
+	for i in count:
+		enemy.health = i
+		total += enemy.health
+	return total
+
+func typed_script_members(enemy: Enemy, count: int) -> int:
+	var total := 0
+	for i in count:
+		enemy.health = i
+		total += enemy.health
+	return total
+
+func untyped_script_calls(enemy, count):
+	for i in count:
+		enemy.hit(1)
+
+func typed_script_calls(enemy: Enemy, count: int) -> void:
+	for i in count:
+		enemy.hit(1)
+
+func untyped_native_properties(node, count):
+	var total = 0.0
+	for i in count:
+		node.rotation = total
+		total += node.rotation + 1.0
+	return total
+
+func typed_native_properties(node: Node2D, count: int) -> float:
+	var total := 0.0
+	for i in count:
+		node.rotation = total
+		total += node.rotation + 1.0
+	return total
+
+func untyped_native_calls(node, count):
+	for i in count:
+		node.get_rotation()
+
+func typed_native_calls(node: Node2D, count: int) -> void:
+	for i in count:
+		node.get_rotation()
+
+func untyped_builtin_members(vector, count):
+	var total = 0.0
+	for i in count:
+		vector.x = total
+		total += vector.y + 1.0
+	return total
+
+func typed_builtin_members(vector: Vector2, count: int) -> float:
+	var total := 0.0
+	for i in count:
+		vector.x = total
+		total += vector.y + 1.0
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> runner = memnew(RefCounted);
+	runner->set_script(gdscript);
+	Node2D *node = memnew(Node2D);
+
+	struct Case {
+		const char *name;
+		StringName untyped;
+		StringName typed;
+		Variant receiver;
+	};
+	const Case cases[] = {
+		{ "Script members", "untyped_script_members", "typed_script_members", runner->call("make_enemy") },
+		{ "Script calls", "untyped_script_calls", "typed_script_calls", runner->call("make_enemy") },
+		{ "Native properties", "untyped_native_properties", "typed_native_properties", node },
+		{ "Native calls", "untyped_native_calls", "typed_native_calls", node },
+		{ "Built-in members", "untyped_builtin_members", "typed_builtin_members", Vector2(1, 2) },
+	};
+
+	for (const Case &c : cases) {
+		double generic = benchmark_gdscript_call(runner.ptr(), c.untyped, c.receiver, COUNT, false);
+		double cached = benchmark_gdscript_call(runner.ptr(), c.untyped, c.receiver, COUNT, true);
+		double typed = benchmark_gdscript_call(runner.ptr(), c.typed, c.receiver, COUNT, true);
+		print_line(vformat("%s, %d iterations: untyped without caches %.3f ms, untyped with caches %.3f ms, typed %.3f ms.",
+				c.name, COUNT, generic, cached, typed));
+	}
+
+	memdelete(node);
+}
+
+} // namespace GDScriptTests
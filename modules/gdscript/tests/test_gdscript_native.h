@@ -0,0 +1,228 @@
+/**************************************************************************/
+/*  test_gdscript_native.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "../gdscript_native.h"
+#include "gdscript_test_runner.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<GDScript> compile_native_test_script() {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func sum_range(count: int) -> int:
+	var total := 0
+	for i in range(count):
+		if i > 2:
+			total += i
+	return total
+
+func untyped_sum(values):
+	var total = 0
+	for value in values:
+		total += value.size()
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	return gdscript;
+}
+
+static void dummy_native_function(const GDScriptNativeFrame &p_frame, Variant &r_ret) {
+	r_ret = 42;
+}
+
+TEST_CASE("[Modules][GDScript] Native translation of statically typed functions") {
+	Ref<GDScript> gdscript = compile_native_test_script();
+	const GDScriptFunction *typed = gdscript->get_member_functions()["sum_range"];
+	const GDScriptFunction *untyped = gdscript->get_member_functions()["untyped_sum"];
+
+	SUBCASE("Only statically typed functions are translated") {
+		String reason;
+		CHECK_FALSE(GDScriptNativeFunctions::normalize(typed, &reason).is_empty());
+		CHECK(reason.is_empty());
+		CHECK(GDScriptNativeFunctions::normalize(untyped, &reason).is_empty());
+		CHECK_FALSE(reason.is_empty());
+
+		GDScriptNativeTranslator translator;
+		CHECK(translator.add_script(gdscript.ptr()) == 1);
+		const String source = translator.generate_source();
+		CHECK(source.contains("static void gdscript_native_0(const GDScriptNativeFrame &p_frame, Variant &r_ret) {"));
+		CHECK(source.contains("static GDScriptNativeFunctions::Registration gdscript_native_0_registration("));
+		CHECK_FALSE(source.contains("gdscript_native_1"));
+	}
+
+	SUBCASE("Identical functions share the translation") {
+		GDScriptNativeTranslator translator;
+		CHECK(translator.add_function(typed));
+		CHECK(translator.add_function(typed));
+		CHECK(translator.get_function_count() == 1);
+	}
+
+	SUBCASE("Registered translations are found by code") {
+		const Vector<int32_t> code = GDScriptNativeFunctions::normalize(typed);
+		REQUIRE_FALSE(code.is_empty());
+
+		CHECK(GDScriptNativeFunctions::find(typed) == nullptr);
+		{
+			GDScriptNativeFunctions::Registration registration(code.ptr(), code.size(), &dummy_native_function);
+			CHECK(GDScriptNativeFunctions::find(typed) == &dummy_native_function);
+			CHECK(GDScriptNativeFunctions::find(untyped) == nullptr);
+
+			GDScriptNativeFunctions::set_enabled(false);
+			CHECK(GDScriptNativeFunctions::find(typed) == nullptr);
+			GDScriptNativeFunctions::set_enabled(true);
+		}
+		CHECK(GDScriptNativeFunctions::find(typed) == nullptr);
+	}
+
+	SUBCASE("Native method calls run with the caller's memory tag") {
+		Ref<GDScript> with_call = memnew(GDScript);
+		with_call->set_source_code(R"(
+extends RefCounted
+
+func child_count(node: Node) -> int:
+	return node.get_child_count()
+)");
+		ERR_PRINT_OFF;
+		const Error error = with_call->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+
+		GDScriptNativeTranslator translator;
+		REQUIRE(translator.add_function(with_call->get_member_functions()["child_count"]));
+		const String source = translator.generate_source();
+		const int tag_scope = source.find("Memory::TagScope native_memory_tag(p_frame.caller_memory_tag);");
+		CHECK(tag_scope >= 0);
+		CHECK(source.find("->validated_call(") > tag_scope);
+	}
+
+	SUBCASE("Functions using assert are not translated") {
+		Ref<GDScript> with_assert = memnew(GDScript);
+		with_assert->set_source_code(R"(
+extends RefCounted
+
+func checked_double(value: int) -> int:
+	assert(value >= 0)
+	return value * 2
+)");
+		ERR_PRINT_OFF;
+		const Error error = with_assert->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+
+		String reason;
+		CHECK(GDScriptNativeFunctions::normalize(with_assert->get_member_functions()["checked_double"], &reason).is_empty());
+		CHECK(reason.contains("assert"));
+	}
+}
+
+// The generated part of test_gdscript_native_translation.cpp.
+static const char *NATIVE_TRANSLATION_SOURCE = R"GEN(// This file is generated by the GDScript exporter, do not edit.
+// Compile it into a release export template (for example as part of a custom module)
+// to run the functions below natively instead of in the GDScript VM.
+
+#include "modules/gdscript/gdscript_native.h"
+
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+
+// ::mul_add
+static const int32_t gdscript_native_0_code[] = {
+	1, 7, 2, 0, 1, 3, 4, 6, 0, 1, 6, 4, 5, 1, 66, 5,
+	159,
+};
+
+static void gdscript_native_0(const GDScriptNativeFrame &p_frame, Variant &r_ret) {
+	[[maybe_unused]] Variant *s = p_frame.stack;
+	[[maybe_unused]] Variant *c = p_frame.constants;
+	[[maybe_unused]] Variant *m = p_frame.members;
+	p_frame.operator_funcs[0](&s[3], &s[4], &s[6]);
+	p_frame.operator_funcs[1](&s[6], &s[4], &s[5]);
+	r_ret = s[5];
+	return;
+	return;
+}
+
+static GDScriptNativeFunctions::Registration gdscript_native_0_registration(gdscript_native_0_code, 17, &gdscript_native_0);
+)GEN";
+
+TEST_CASE("[Modules][GDScript] Checked-in native translation matches the VM") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func mul_add(a: int, b: int) -> int:
+	return a * b + b
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	const GDScriptFunction *function = gdscript->get_member_functions()["mul_add"];
+
+	// test_gdscript_native_translation.cpp is this translation, compiled into the test binary.
+	// Regenerate both from the output of generate_source() when the compiler changes.
+	GDScriptNativeTranslator translator;
+	REQUIRE(translator.add_function(function));
+	CHECK_MESSAGE(translator.generate_source() == String(NATIVE_TRANSLATION_SOURCE), "The checked-in translation is out of date.");
+
+	const GDScriptNativeFunctionPtr native = GDScriptNativeFunctions::find(function);
+	REQUIRE(native != nullptr);
+
+	Ref<RefCounted> runner = memnew(RefCounted);
+	runner->set_script(gdscript);
+	const int64_t values[][2] = { { 6, 7 }, { -3, 5 }, { 0, 0 }, { int64_t(1) << 40, 3 } };
+	for (const int64_t *pair : values) {
+		const Variant args[2] = { pair[0], pair[1] };
+		const Variant *argptrs[2] = { &args[0], &args[1] };
+		Callable::CallError ce;
+		const Variant vm_result = runner->callp("mul_add", argptrs, 2, ce);
+		REQUIRE(ce.error == Callable::CallError::CALL_OK);
+
+		CHECK(vm_result == Variant(pair[0] * pair[1] + pair[1]));
+		CHECK(GDScriptNativeFunctions::call_static(function, native, argptrs, 2) == vm_result);
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
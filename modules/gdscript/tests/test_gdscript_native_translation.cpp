@@ -0,0 +1,57 @@
+/**************************************************************************/
+/*  test_gdscript_native_translation.cpp                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+// This file is generated by the GDScript exporter, do not edit.
+// Compile it into a release export template (for example as part of a custom module)
+// to run the functions below natively instead of in the GDScript VM.
+
+#include "modules/gdscript/gdscript_native.h"
+
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+
+// ::mul_add
+static const int32_t gdscript_native_0_code[] = {
+	1, 7, 2, 0, 1, 3, 4, 6, 0, 1, 6, 4, 5, 1, 66, 5,
+	159,
+};
+
+static void gdscript_native_0(const GDScriptNativeFrame &p_frame, Variant &r_ret) {
+	[[maybe_unused]] Variant *s = p_frame.stack;
+	[[maybe_unused]] Variant *c = p_frame.constants;
+	[[maybe_unused]] Variant *m = p_frame.members;
+	p_frame.operator_funcs[0](&s[3], &s[4], &s[6]);
+	p_frame.operator_funcs[1](&s[6], &s[4], &s[5]);
+	r_ret = s[5];
+	return;
+	return;
+}
+
+static GDScriptNativeFunctions::Registration gdscript_native_0_registration(gdscript_native_0_code, 17, &gdscript_native_0);
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  test_gdscript_sampling_profiler.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript_sampling_profiler.h"
+#include "gdscript_test_runner.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Sampling profiler aggregation") {
+	Ref<GDScriptSamplingProfiler> profiler;
+	profiler.instantiate();
+
+	profiler->add_sample("res://main.gd:_process;res://main.gd:update");
+	profiler->add_sample("res://main.gd:_process");
+	profiler->add_sample("res://main.gd:_process;res://main.gd:update", 2);
+	CHECK(profiler->get_sample_count() == 4);
+	CHECK(profiler->get_collapsed_stacks() == "res://main.gd:_process 1\nres://main.gd:_process;res://main.gd:update 3\n");
+
+	profiler->clear();
+	CHECK(profiler->get_sample_count() == 0);
+	CHECK(profiler->get_collapsed_stacks().is_empty());
+}
+
+// Call stacks are only always tracked in debug builds.
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler captures running scripts") {
+	GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+	REQUIRE(profiler != nullptr);
+
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+static func spin(msec: int) -> int:
+	var count := 0
+	var end := Time.get_ticks_msec() + msec
+	while Time.get_ticks_msec() < end:
+		count += 1
+	return count
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	REQUIRE(profiler->start(GDScriptSamplingProfiler::MIN_INTERVAL_USEC) == OK);
+	const Variant count = gdscript->call("spin", 50);
+	profiler->stop();
+
+	CHECK(int64_t(count) > 0);
+	CHECK(profiler->get_sample_count() > 0);
+	CHECK(profiler->get_collapsed_stacks().contains(":spin "));
+	profiler->clear();
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler weights samples missed in native calls") {
+	GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+	REQUIRE(profiler != nullptr);
+
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+static func sleep(msec: int) -> void:
+	OS.delay_msec(msec)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	REQUIRE(profiler->start(GDScriptSamplingProfiler::MIN_INTERVAL_USEC) == OK);
+	gdscript->call("sleep", 50);
+	profiler->stop();
+
+	// No safepoint runs during the native call, the function records all the epochs it missed when returning.
+	int64_t sleep_samples = 0;
+	for (const String &line : profiler->get_collapsed_stacks().split("\n", false)) {
+		if (line.contains(":sleep ")) {
+			sleep_samples += line.get_slicec(' ', line.get_slice_count(" ") - 1).to_int();
+		}
+	}
+	CHECK(sleep_samples > 1);
+	CHECK(uint64_t(sleep_samples) == profiler->get_sample_count());
+	profiler->clear();
+}
+#endif // DEBUG_ENABLED
+
+} // namespace GDScriptTests
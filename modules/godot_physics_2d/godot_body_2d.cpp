@@ -605,13 +605,20 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = 0.0;
 	biased_linear_velocity = Vector2();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	// Shapes temporarily extend for raycast, see integrate_forces_finish().
+	integrated_motion = motion;
+	integrated_motion_pending = do_motion;
 
 	contact_count = 0;
 }
 
+void GodotBody2D::integrate_forces_finish() {
+	if (integrated_motion_pending) {
+		_update_shapes_with_motion(integrated_motion);
+		integrated_motion_pending = false;
+	}
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
@@ -619,16 +626,9 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
-		}
 		return;
 	}
 
@@ -644,7 +644,7 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -654,6 +654,27 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody2D::integrate_velocities_finish() {
+	if (mode == PhysicsServer2D::BODY_MODE_STATIC || !get_space()) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
+		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
+			set_active(false); //stopped moving, deactivate
+		}
+		return;
+	}
+
+	if (continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED) {
+		_update_shapes();
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -138,6 +138,10 @@ class GodotBody2D : public GodotCollisionObject2D {
 	Vector<Contact> contacts; //no contacts by default
 	int contact_count = 0;
 
+	// Motion left by integrate_forces() for integrate_forces_finish().
+	Vector2 integrated_motion;
+	bool integrated_motion_pending = false;
+
 	Callable body_state_callback;
 
 	struct ForceIntegrationCallbackData {
@@ -315,8 +319,13 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// integrate_forces() and integrate_velocities() only change this body, so they can run
+	// for all active bodies in parallel. The matching *_finish() calls update the broadphase
+	// and the space lists, and must run afterwards on one thread, in active list order.
 	void integrate_forces(real_t p_step);
+	void integrate_forces_finish();
 	void integrate_velocities(real_t p_step);
+	void integrate_velocities_finish();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -32,6 +32,7 @@
 
 #include "core/math/math_funcs.h"
 #include "core/math/rect2.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject2D;
 
@@ -59,6 +60,11 @@ public:
 	virtual int cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
+	// Versions of cull_segment() and cull_aabb() that can run on several threads at once, each with
+	// its own r_hits buffer, as long as the broadphase isn't modified meanwhile.
+	virtual int cull_segment_hits(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, LocalVector<uint32_t> &r_hits, int *p_result_indices = nullptr) = 0;
+	virtual int cull_aabb_hits(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, LocalVector<uint32_t> &r_hits, int *p_result_indices = nullptr) = 0;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
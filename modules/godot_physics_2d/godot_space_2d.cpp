@@ -34,10 +34,12 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+#define QUERY_BATCH_MIN_PART_SIZE 32
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -115,7 +117,7 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject2D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits) {
 	ERR_FAIL_COND_V(space->locked, false);
 
 	Vector2 begin, end;
@@ -124,7 +126,7 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_segment_hits(begin, end, r_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, *r_cull_hits, r_query_subindex_results) : space->broadphase->cull_segment(begin, end, r_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,17 +137,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_query_subindex_results[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,6 +207,10 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	return _intersect_ray(p_parameters, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -254,7 +260,7 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+bool GodotPhysicsDirectSpaceState2D::_cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits) {
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -262,22 +268,22 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_hits(aabb, r_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, *r_cull_hits, r_query_subindex_results) : space->broadphase->cull_aabb(aabb, r_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_query_results[i];
+		int shape_idx = r_query_subindex_results[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
@@ -337,6 +343,48 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	return _cast_motion(p_parameters, p_closest_safe, p_closest_unsafe, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	// Every part of the batch culls into its own buffers, so the parts can run on
+	// worker threads without locking the broadphase. Like any direct space state
+	// query, this can't run while the space steps, so the broadphase doesn't change.
+	LocalVector<GodotSpace2D::QueryBuffers> buffers;
+	GodotSpace2D::make_query_buffers(p_count, buffers);
+	auto intersect_part = [&](uint32_t p_begin, uint32_t p_end, GodotSpace2D::QueryBuffers &r_buffers) {
+		RayParameters parameters = p_parameters;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			parameters.from = p_from[i];
+			parameters.to = p_to[i];
+			r_hits[i] = _intersect_ray(parameters, r_results[i], r_buffers.results.ptr(), r_buffers.subindex_results.ptr(), &r_buffers.cull_hits);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, p_count, buffers, intersect_part, SNAME("Physics2DIntersectRays"));
+}
+
+void GodotPhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND(space->locked);
+
+	// Split like intersect_rays().
+	LocalVector<GodotSpace2D::QueryBuffers> buffers;
+	GodotSpace2D::make_query_buffers(p_count, buffers);
+	auto cast_part = [&](uint32_t p_begin, uint32_t p_end, GodotSpace2D::QueryBuffers &r_buffers) {
+		ShapeParameters parameters = p_parameters;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			parameters.transform = p_transforms[i];
+			parameters.motion = p_motions[i];
+			r_closest_safe[i] = 1.0;
+			r_closest_unsafe[i] = 1.0;
+			_cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i], r_buffers.results.ptr(), r_buffers.subindex_results.ptr(), &r_buffers.cull_hits);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, p_count, buffers, cast_part, SNAME("Physics2DCastMotions"));
+}
+
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1009,6 +1057,11 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 	return collided;
 }
 
+void GodotSpace2D::make_query_buffers(int p_count, LocalVector<QueryBuffers> &r_buffers) {
+	const int max_parts = WorkerThreadPool::get_singleton()->get_thread_count() + 1;
+	r_buffers.resize(CLAMP((p_count + QUERY_BATCH_MIN_PART_SIZE - 1) / QUERY_BATCH_MIN_PART_SIZE, 1, max_parts));
+}
+
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self) {
 	GodotCollisionObject2D::Type type_A = A->get_type();
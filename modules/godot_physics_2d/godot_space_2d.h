@@ -43,6 +43,11 @@ class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 public:
 	GodotSpace2D *space = nullptr;
 
+private:
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject2D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	bool _cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits = nullptr);
+
+public:
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
@@ -50,6 +55,9 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState2D() {}
 };
 
@@ -126,6 +134,22 @@ private:
 	friend class GodotPhysicsDirectSpaceState2D;
 
 public:
+	// Broadphase result storage for queries running off the physics thread,
+	// which can't share the space's own buffers.
+	struct QueryBuffers {
+		LocalVector<GodotCollisionObject2D *> results;
+		LocalVector<int> subindex_results;
+		LocalVector<uint32_t> cull_hits;
+
+		QueryBuffers() {
+			results.resize(INTERSECTION_QUERY_MAX);
+			subindex_results.resize(INTERSECTION_QUERY_MAX);
+		}
+	};
+
+	// Sizes r_buffers for splitting p_count queries over the WorkerThreadPool.
+	static void make_query_buffers(int p_count, LocalVector<QueryBuffers> &r_buffers);
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
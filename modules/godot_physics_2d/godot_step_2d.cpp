@@ -102,30 +102,52 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_test_suspend(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	// Every body is tested, since the test also advances its sleep timer.
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const GodotSpace2D *p_space) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_space->get_active_body_list().first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -143,16 +165,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(p_space);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Each body only touches its own state here. The broadphase is updated afterwards, in order.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_forces_finish();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(int(active_bodies.size()));
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -193,7 +216,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody2D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -241,7 +264,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -272,17 +295,25 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Pre-solving can wake up bodies, so gather them again.
+	_gather_active_bodies(p_space);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Updates the broadphase and may deactivate bodies, so it runs in order.
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_velocities_finish();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_test_suspend, nullptr, body_island_count, -1, true, SNAME("Physics2DTestSuspend"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
@@ -44,11 +44,19 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
+	// Active bodies in list order, so the per-body stages can run in parallel.
+	LocalVector<GodotBody2D *> active_bodies;
+	LocalVector<uint8_t> body_island_can_sleep;
+
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _test_suspend(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const;
+	void _gather_active_bodies(const GodotSpace2D *p_space);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
@@ -132,6 +132,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 	Vector<Contact> contacts; //no contacts by default
 	int contact_count = 0;
 
+	// Motion left by integrate_forces() for integrate_forces_finish().
+	Vector3 integrated_motion;
+	bool integrated_motion_pending = false;
+
 	Callable body_state_callback;
 
 	struct ForceIntegrationCallbackData {
@@ -316,8 +320,13 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// integrate_forces() and integrate_velocities() only change this body, so they can run
+	// for all active bodies in parallel. The matching *_finish() calls update the broadphase
+	// and the space lists, and must run afterwards on one thread, in active list order.
 	void integrate_forces(real_t p_step);
+	void integrate_forces_finish();
 	void integrate_velocities(real_t p_step);
+	void integrate_velocities_finish();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -32,6 +32,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -60,6 +61,11 @@ public:
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
+	// Versions of cull_segment() and cull_aabb() that can run on several threads at once, each with
+	// its own r_hits buffer, as long as the broadphase isn't modified meanwhile.
+	virtual int cull_segment_hits(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, LocalVector<uint32_t> &r_hits, int *p_result_indices = nullptr) = 0;
+	virtual int cull_aabb_hits(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, LocalVector<uint32_t> &r_hits, int *p_result_indices = nullptr) = 0;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -948,6 +949,45 @@ bool GodotPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &
 	return body->get_space()->test_body_motion(body, p_parameters, r_result);
 }
 
+struct GodotSlideBodyData3D {
+	GodotBody3D *body = nullptr;
+	GodotSpace3D::QueryBuffers *buffers = nullptr;
+};
+
+static bool _slide_test_body_motion(void *p_userdata, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	const GodotSlideBodyData3D *data = static_cast<const GodotSlideBodyData3D *>(p_userdata);
+	return data->body->get_space()->test_body_motion(data->body, p_parameters, r_result, *data->buffers);
+}
+
+bool GodotPhysicsServer3D::body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) {
+	LocalVector<GodotBody3D *> bodies;
+	bodies.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_FAIL_NULL_V(body, false);
+		ERR_FAIL_NULL_V(body->get_space(), false);
+		ERR_FAIL_COND_V(body->get_space()->is_locked(), false);
+		bodies[i] = body;
+	}
+
+	_update_shapes();
+
+	// Nothing is moved until the whole batch is solved, so the bodies can be
+	// tested in parallel, each part culling into its own buffers.
+	LocalVector<GodotSpace3D::QueryBuffers> buffers;
+	GodotSpace3D::make_query_buffers(p_count, buffers);
+	auto solve_part = [&](uint32_t p_begin, uint32_t p_end, GodotSpace3D::QueryBuffers &r_buffers) {
+		GodotSlideBodyData3D data;
+		data.buffers = &r_buffers;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			data.body = bodies[i];
+			solve_slide(p_parameters, p_delta, r_states[i], _slide_test_body_motion, &data);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, p_count, buffers, solve_part, SNAME("Physics3DSolveSlides"));
+	return true;
+}
+
 PhysicsDirectBodyState3D *GodotPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1675,6 +1715,8 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
+
 	_update_shapes();
 
 	island_count = 0;
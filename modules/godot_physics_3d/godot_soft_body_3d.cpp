@@ -1079,10 +1079,8 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
-
-	// Node tree update.
+	// Node tree update. The bounds are updated afterwards with update_bounds(),
+	// which touches the broadphase and can't run on multiple soft bodies at once.
 	for (const Node &node : nodes) {
 		AABB node_aabb(node.x, Vector3());
 		node_aabb.expand_to(node.x + node.v * p_delta);
@@ -207,7 +207,11 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// predict_motion() and solve_constraints() only change this soft body, so they can run
+	// for all active soft bodies in parallel. update_bounds() updates the broadphase, and must
+	// follow predict_motion() on one thread.
 	void predict_motion(real_t p_delta);
+	void update_bounds();
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -225,7 +229,6 @@ protected:
 
 private:
 	void update_normals_and_centroids();
-	void update_bounds();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
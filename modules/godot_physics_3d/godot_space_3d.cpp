@@ -34,10 +34,12 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
+#define QUERY_BATCH_MIN_PART_SIZE 32
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -107,7 +109,7 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits) {
 	ERR_FAIL_COND_V(space->locked, false);
 
 	Vector3 begin, end;
@@ -116,7 +118,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_segment_hits(begin, end, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, *r_cull_hits, r_query_subindex_results) : space->broadphase->cull_segment(begin, end, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +130,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_query_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +209,10 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	return _intersect_ray(p_parameters, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -262,7 +268,7 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+bool GodotPhysicsDirectSpaceState3D::_cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -270,7 +276,7 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_hits(aabb, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, *r_cull_hits, r_query_subindex_results) : space->broadphase->cull_aabb(aabb, r_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
@@ -287,16 +293,16 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_query_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_query_results[i];
+		int shape_idx = r_query_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
@@ -381,6 +387,48 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	return _cast_motion(p_parameters, p_closest_safe, p_closest_unsafe, r_info, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	// Every part of the batch culls into its own buffers, so the parts can run on
+	// worker threads without locking the broadphase. Like any direct space state
+	// query, this can't run while the space steps, so the broadphase doesn't change.
+	LocalVector<GodotSpace3D::QueryBuffers> buffers;
+	GodotSpace3D::make_query_buffers(p_count, buffers);
+	auto intersect_part = [&](uint32_t p_begin, uint32_t p_end, GodotSpace3D::QueryBuffers &r_buffers) {
+		RayParameters parameters = p_parameters;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			parameters.from = p_from[i];
+			parameters.to = p_to[i];
+			r_hits[i] = _intersect_ray(parameters, r_results[i], r_buffers.results.ptr(), r_buffers.subindex_results.ptr(), &r_buffers.cull_hits);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, p_count, buffers, intersect_part, SNAME("Physics3DIntersectRays"));
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND(space->locked);
+
+	// Split like intersect_rays().
+	LocalVector<GodotSpace3D::QueryBuffers> buffers;
+	GodotSpace3D::make_query_buffers(p_count, buffers);
+	auto cast_part = [&](uint32_t p_begin, uint32_t p_end, GodotSpace3D::QueryBuffers &r_buffers) {
+		ShapeParameters parameters = p_parameters;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			parameters.transform = p_transforms[i];
+			parameters.motion = p_motions[i];
+			r_closest_safe[i] = 1.0;
+			r_closest_unsafe[i] = 1.0;
+			_cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i], nullptr, r_buffers.results.ptr(), r_buffers.subindex_results.ptr(), &r_buffers.cull_hits);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for_with_scratch(0, p_count, buffers, cast_part, SNAME("Physics3DCastMotions"));
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -617,28 +665,28 @@ GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results) {
+	int amount = broadphase->cull_aabb(p_aabb, r_query_results, INTERSECTION_QUERY_MAX, r_query_subindex_results);
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
 
-		if (intersection_query_results[i] == p_body) {
+		if (r_query_results[i] == p_body) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
+		} else if (r_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		} else if (r_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
 			keep = false;
-		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(intersection_query_results[i]))) {
+		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(r_query_results[i]))) {
 			keep = false;
-		} else if (static_cast<GodotBody3D *>(intersection_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query_results[i]->get_self())) {
+		} else if (static_cast<GodotBody3D *>(r_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(r_query_results[i]->get_self())) {
 			keep = false;
 		}
 
 		if (!keep) {
 			if (i < amount - 1) {
-				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
-				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+				SWAP(r_query_results[i], r_query_results[amount - 1]);
+				SWAP(r_query_subindex_results[i], r_query_subindex_results[amount - 1]);
 			}
 
 			amount--;
@@ -649,7 +697,7 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
-bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+bool GodotSpace3D::_test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results) {
 	//give me back regular physics engine logic
 	//this is madness
 	//and most people using this function will think
@@ -722,7 +770,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(p_body, body_aabb, r_query_results, r_query_subindex_results);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -733,7 +781,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+					const GodotCollisionObject3D *col_obj = r_query_results[i];
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -741,7 +789,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
+					int shape_idx = r_query_subindex_results[i];
 
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
 						collided = cbk.amount > 0;
@@ -806,7 +854,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = _cull_aabb_for_body(p_body, motion_aabb, r_query_results, r_query_subindex_results);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -837,7 +885,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_query_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -845,7 +893,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_query_subindex_results[i];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -946,7 +994,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 		body_aabb.position += p_parameters.motion * unsafe;
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		int amount = _cull_aabb_for_body(p_body, body_aabb, r_query_results, r_query_subindex_results);
 
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
@@ -960,7 +1008,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			GodotShape3D *body_shape = p_body->get_shape(j);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_query_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -968,7 +1016,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_query_subindex_results[i];
 
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
@@ -1030,6 +1078,19 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 	return collided;
 }
 
+bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	return _test_body_motion(p_body, p_parameters, r_result, intersection_query_results, intersection_query_subindex_results);
+}
+
+bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, QueryBuffers &r_buffers) {
+	return _test_body_motion(p_body, p_parameters, r_result, r_buffers.results.ptr(), r_buffers.subindex_results.ptr());
+}
+
+void GodotSpace3D::make_query_buffers(int p_count, LocalVector<QueryBuffers> &r_buffers) {
+	const int max_parts = WorkerThreadPool::get_singleton()->get_thread_count() + 1;
+	r_buffers.resize(CLAMP((p_count + QUERY_BATCH_MIN_PART_SIZE - 1) / QUERY_BATCH_MIN_PART_SIZE, 1, max_parts));
+}
+
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self) {
 	GodotCollisionObject3D::Type type_A = A->get_type();
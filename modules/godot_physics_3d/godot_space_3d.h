@@ -44,6 +44,11 @@ class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 public:
 	GodotSpace3D *space = nullptr;
 
+private:
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	bool _cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results, LocalVector<uint32_t> *r_cull_hits = nullptr);
+
+public:
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
@@ -52,6 +57,9 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -121,9 +129,26 @@ private:
 
 	friend class GodotPhysicsDirectSpaceState3D;
 
-	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results);
+	bool _test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_query_results, int *r_query_subindex_results);
 
 public:
+	// Broadphase result storage for queries running off the physics thread,
+	// which can't share the space's own buffers.
+	struct QueryBuffers {
+		LocalVector<GodotCollisionObject3D *> results;
+		LocalVector<int> subindex_results;
+		LocalVector<uint32_t> cull_hits;
+
+		QueryBuffers() {
+			results.resize(INTERSECTION_QUERY_MAX);
+			subindex_results.resize(INTERSECTION_QUERY_MAX);
+		}
+	};
+
+	// Sizes r_buffers for splitting p_count queries over the WorkerThreadPool.
+	static void make_query_buffers(int p_count, LocalVector<QueryBuffers> &r_buffers);
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -205,6 +230,7 @@ public:
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
+	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, QueryBuffers &r_buffers);
 
 	GodotSpace3D();
 	~GodotSpace3D();
@@ -112,7 +112,7 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
+void GodotStep3D::_setup_constraint(uint32_t p_constraint_index) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
 }
@@ -130,7 +130,7 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+void GodotStep3D::_solve_island(uint32_t p_island_index) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
 	int current_priority = 1;
@@ -158,9 +158,10 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+bool GodotStep3D::_test_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
+	// Every body is tested, since the test also advances its sleep timer.
 	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
@@ -170,18 +171,35 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 		}
 	}
 
+	return can_sleep;
+}
+
+void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const GodotSpace3D *p_space) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody3D> *b = p_space->get_active_body_list().first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+
+	active_soft_bodies.clear();
+	for (const SelfList<GodotSoftBody3D> *sb = p_space->get_active_soft_body_list().first(); sb; sb = sb->next()) {
+		active_soft_bodies.push_back(sb->self());
+	}
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -201,25 +219,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(p_space);
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Each body only touches its own state here. The broadphase is updated afterwards, in order.
+	auto integrate_forces = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t body_index = p_from; body_index < p_to; ++body_index) {
+			active_bodies[body_index]->integrate_forces(delta);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, active_bodies.size(), 0, integrate_forces, SNAME("Physics3DIntegrateForces"));
+
+	for (GodotBody3D *body : active_bodies) {
+		body->integrate_forces_finish();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
-	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->predict_motion(p_delta);
-		sb = sb->next();
-		active_count++;
+	// Soft bodies are few but expensive, so hand them out one by one.
+	auto predict_motion = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t soft_body_index = p_from; soft_body_index < p_to; ++soft_body_index) {
+			active_soft_bodies[soft_body_index]->predict_motion(delta);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, active_soft_bodies.size(), 1, predict_motion, SNAME("Physics3DSoftBodyPredictMotion"));
+
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->update_bounds();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(int(active_bodies.size() + active_soft_bodies.size()));
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -260,7 +288,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -299,7 +327,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
-	sb = soft_body_list->first();
+	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
 		GodotSoftBody3D *soft_body = sb->self();
 
@@ -344,8 +372,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	auto setup_constraints = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t constraint_index = p_from; constraint_index < p_to; ++constraint_index) {
+			_setup_constraint(constraint_index);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, total_constraint_count, 0, setup_constraints, SNAME("Physics3DConstraintSetup"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +396,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	// Island sizes vary a lot, so hand them out one by one to balance the load.
+	auto solve_islands = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t island_index = p_from; island_index < p_to; ++island_index) {
+			_solve_island(island_index);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, island_count, 1, solve_islands, SNAME("Physics3DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,26 +412,43 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Pre-solving can wake up bodies, so gather them again.
+	_gather_active_bodies(p_space);
+
+	auto integrate_velocities = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t body_index = p_from; body_index < p_to; ++body_index) {
+			active_bodies[body_index]->integrate_velocities(delta);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, active_bodies.size(), 0, integrate_velocities, SNAME("Physics3DIntegrateVelocities"));
+
+	// Updates the broadphase and may deactivate bodies, so it runs in order.
+	for (GodotBody3D *body : active_bodies) {
+		body->integrate_velocities_finish();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	auto test_suspend = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t island_index = p_from; island_index < p_to; ++island_index) {
+			body_island_can_sleep[island_index] = _test_suspend(body_islands[island_index]);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, body_island_count, 0, test_suspend, SNAME("Physics3DTestSuspend"));
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
-	}
+	auto solve_soft_body_constraints = [this](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t soft_body_index = p_from; soft_body_index < p_to; ++soft_body_index) {
+			active_soft_bodies[soft_body_index]->solve_constraints(delta);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, active_soft_bodies.size(), 1, solve_soft_body_constraints, SNAME("Physics3DSoftBodySolveConstraints"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
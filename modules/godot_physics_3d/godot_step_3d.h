@@ -44,12 +44,19 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Active bodies in list order, so the per-body stages can run in parallel.
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
+	LocalVector<uint8_t> body_island_can_sleep;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _setup_constraint(uint32_t p_constraint_index);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _solve_island(uint32_t p_island_index);
+	bool _test_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const;
+	void _gather_active_bodies(const GodotSpace3D *p_space);
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
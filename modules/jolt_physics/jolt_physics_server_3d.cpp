@@ -30,6 +30,7 @@
 
 #include "jolt_physics_server_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "joints/jolt_cone_twist_joint_3d.h"
 #include "joints/jolt_generic_6dof_joint_3d.h"
 #include "joints/jolt_hinge_joint_3d.h"
@@ -965,6 +966,45 @@ bool JoltPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &p
 	return space->get_direct_state()->body_test_motion(*body, p_parameters, r_result);
 }
 
+static bool _slide_test_body_motion(void *p_userdata, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	const JoltBody3D *body = static_cast<const JoltBody3D *>(p_userdata);
+	return body->get_space()->get_direct_state()->body_test_motion(*body, p_parameters, r_result);
+}
+
+bool JoltPhysicsServer3D::body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) {
+	LocalVector<JoltBody3D *> bodies;
+	bodies.resize(p_count);
+	LocalVector<JoltSpace3D *> spaces;
+	for (int i = 0; i < p_count; i++) {
+		JoltBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_FAIL_NULL_V(body, false);
+
+		JoltSpace3D *space = body->get_space();
+		ERR_FAIL_NULL_V(space, false);
+		ERR_FAIL_COND_V(space->is_stepping(), false);
+
+		if (!spaces.has(space)) {
+			spaces.push_back(space);
+		}
+		bodies[i] = body;
+	}
+
+	// Flushing adds bodies to the broadphase, so it must happen here rather than in
+	// the motion tests below, which then only read from the spaces.
+	for (JoltSpace3D *space : spaces) {
+		space->get_direct_state();
+		space->flush_pending_objects();
+	}
+
+	auto solve_bodies = [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			solve_slide(p_parameters, p_delta, r_states[i], _slide_test_body_motion, bodies[i]);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, p_count, 0, solve_bodies, SNAME("JoltSolveSlides"));
+	return true;
+}
+
 PhysicsDirectBodyState3D *JoltPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((on_separate_thread && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1648,9 +1688,7 @@ void JoltPhysicsServer3D::flush_queries() {
 
 	flushing_queries = false;
 
-#ifdef DEBUG_ENABLED
 	job_system->flush_timings();
-#endif
 }
 
 bool JoltPhysicsServer3D::is_flushing_queries() const {
@@ -295,6 +295,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result) override;
+	virtual bool body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) override;
 
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
 
@@ -36,37 +36,36 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
+#include "main/performance.h"
 
 #include "Jolt/Physics/PhysicsSettings.h"
 
 void JoltJobSystem::Job::_execute(void *p_user_data) {
 	Job *job = static_cast<Job *>(p_user_data);
 
-#ifdef DEBUG_ENABLED
+	if (!timings_enabled.load(std::memory_order_relaxed)) {
+		job->Execute();
+		job->Release();
+		return;
+	}
+
 	const uint64_t time_start = Time::get_singleton()->get_ticks_usec();
-#endif
 
 	job->Execute();
 
-#ifdef DEBUG_ENABLED
 	const uint64_t time_end = Time::get_singleton()->get_ticks_usec();
 	const uint64_t time_elapsed = time_end - time_start;
 
 	timings_lock.lock();
 	timings_by_job[job->name] += time_elapsed;
 	timings_lock.unlock();
-#endif
 
 	job->Release();
 }
 
 JoltJobSystem::Job::Job(const char *p_name, JPH::ColorArg p_color, JPH::JobSystem *p_job_system, const JPH::JobSystem::JobFunction &p_job_function, JPH::uint32 p_dependency_count) :
-		JPH::JobSystem::Job(p_name, p_color, p_job_system, p_job_function, p_dependency_count)
-#ifdef DEBUG_ENABLED
-		,
-		name(p_name)
-#endif
-{
+		JPH::JobSystem::Job(p_name, p_color, p_job_system, p_job_function, p_dependency_count),
+		name(p_name) {
 }
 
 JoltJobSystem::Job::~Job() {
@@ -165,22 +164,43 @@ JoltJobSystem::JoltJobSystem() :
 	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
 }
 
+JoltJobSystem::~JoltJobSystem() {
+	// The monitors would otherwise outlive the physics server. Clearing the timings lets a new
+	// job system add them again once its jobs run.
+	Performance *performance = Performance::get_singleton();
+
+	if (performance != nullptr) {
+		for (const KeyValue<String, double> &E : monitored_timings) {
+			const StringName monitor_name("Jolt Physics/" + E.key);
+
+			if (performance->has_custom_monitor(monitor_name)) {
+				performance->remove_custom_monitor(monitor_name);
+			}
+		}
+	}
+
+	monitored_timings.clear();
+}
+
 void JoltJobSystem::pre_step() {
-	// Nothing to do.
+	static const StringName profiler_name("servers");
+
+	timings_enabled.store(JoltProjectSettings::job_time_monitors || EngineDebugger::is_profiling(profiler_name), std::memory_order_relaxed);
 }
 
 void JoltJobSystem::post_step() {
 	_reclaim_jobs();
 }
 
-#ifdef DEBUG_ENABLED
+double JoltJobSystem::_get_monitored_timing(const String &p_job_name) {
+	const double *timing = monitored_timings.getptr(p_job_name);
+	return timing != nullptr ? *timing : 0.0;
+}
 
 void JoltJobSystem::flush_timings() {
 	static const StringName profiler_name("servers");
 
-	EngineDebugger *engine_debugger = EngineDebugger::get_singleton();
-
-	if (engine_debugger->is_profiling(profiler_name)) {
+	if (EngineDebugger::is_profiling(profiler_name)) {
 		Array timings;
 
 		for (const KeyValue<const void *, uint64_t> &E : timings_by_job) {
@@ -190,12 +210,26 @@ void JoltJobSystem::flush_timings() {
 
 		timings.push_front("physics_3d");
 
-		engine_debugger->profiler_add_frame_data(profiler_name, timings);
+		EngineDebugger::profiler_add_frame_data(profiler_name, timings);
+	}
+
+	Performance *performance = Performance::get_singleton();
+
+	if (JoltProjectSettings::job_time_monitors && performance != nullptr) {
+		for (const KeyValue<const void *, uint64_t> &E : timings_by_job) {
+			const String job_name = static_cast<const char *>(E.key);
+
+			if (!monitored_timings.has(job_name)) {
+				// Monitors are added as new job names show up, since Jolt only runs some jobs
+				// when there is work for them.
+				performance->add_custom_monitor(StringName("Jolt Physics/" + job_name), callable_mp_static(&JoltJobSystem::_get_monitored_timing), varray(job_name));
+			}
+
+			monitored_timings[job_name] = USEC_TO_SEC(E.value) * 1000.0;
+		}
 	}
 
 	for (KeyValue<const void *, uint64_t> &E : timings_by_job) {
 		E.value = 0;
 	}
 }
-
-#endif
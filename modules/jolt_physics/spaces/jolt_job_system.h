@@ -44,9 +44,7 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	class Job : public JPH::JobSystem::Job {
 		inline static std::atomic<Job *> completed_head = nullptr;
 
-#ifdef DEBUG_ENABLED
 		const char *name = nullptr;
-#endif
 
 		int64_t task_id = -1;
 
@@ -69,14 +67,22 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 		Job &operator=(Job &&p_other) = delete;
 	};
 
-#ifdef DEBUG_ENABLED
 	// We use `const void*` here to avoid the cost of hashing the actual string, since the job names
 	// are always literals and as such will point to the same address every time.
 	inline static HashMap<const void *, uint64_t> timings_by_job;
 
 	// TODO: Check whether the usage of SpinLock is justified or if this should be a mutex instead.
 	inline static SpinLock timings_lock;
-#endif
+
+	// Jobs are only timed while someone looks at the results, i.e. the "servers" profiler
+	// or the `Performance` monitors enabled through the project settings.
+	inline static std::atomic<bool> timings_enabled = false;
+
+	// Time spent in every job during the last flushed frame, in milliseconds, as read by
+	// the `Performance` monitors. Only accessed from the main thread.
+	inline static HashMap<String, double> monitored_timings;
+
+	static double _get_monitored_timing(const String &p_job_name);
 
 	JPH::FixedSizeFreeList<Job> jobs;
 
@@ -93,11 +99,10 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 
 public:
 	JoltJobSystem();
+	~JoltJobSystem();
 
 	void pre_step();
 	void post_step();
 
-#ifdef DEBUG_ENABLED
 	void flush_timings();
-#endif
 };
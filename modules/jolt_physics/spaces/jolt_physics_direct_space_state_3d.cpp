@@ -44,6 +44,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Geometry/GJKClosestPoint.h"
 #include "Jolt/Physics/Body/Body.h"
 #include "Jolt/Physics/Body/BodyFilter.h"
@@ -55,6 +57,80 @@
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const JoltQueryFilter3D &p_query_filter, RayResult &r_result) const {
+	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
+	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+	const JPH::Vec3 vector = JPH::Vec3(to - from);
+	const JPH::RRayCast ray(from, vector);
+
+	const JPH::EBackFaceMode back_face_mode = p_parameters.hit_back_faces ? JPH::EBackFaceMode::CollideWithBackFaces : JPH::EBackFaceMode::IgnoreBackFaces;
+
+	JPH::RayCastSettings settings;
+	settings.mTreatConvexAsSolid = p_parameters.hit_from_inside;
+	settings.mBackFaceModeTriangles = back_face_mode;
+
+	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
+	space->get_narrow_phase_query().CastRay(ray, settings, collector, p_query_filter, p_query_filter, p_query_filter);
+
+	if (!collector.had_hit()) {
+		return false;
+	}
+
+	const JPH::RayCastResult &hit = collector.get_hit();
+
+	const JPH::BodyID &body_id = hit.mBodyID;
+	const JPH::SubShapeID &sub_shape_id = hit.mSubShapeID2;
+
+	const JoltObject3D *object = space->try_get_object(body_id);
+	ERR_FAIL_NULL_V(object, false);
+
+	const JPH::RVec3 position = ray.GetPointOnRay(hit.mFraction);
+
+	JPH::Vec3 normal = JPH::Vec3::sZero();
+
+	if (!p_parameters.hit_from_inside || hit.mFraction > 0.0f) {
+		normal = object->get_jolt_body()->GetWorldSpaceSurfaceNormal(sub_shape_id, position);
+
+		// If we got a back-face normal we need to flip it.
+		if (normal.Dot(vector) > 0) {
+			normal = -normal;
+		}
+	}
+
+	r_result.position = to_godot(position);
+	r_result.normal = to_godot(normal);
+	r_result.rid = object->get_rid();
+	r_result.collider_id = object->get_instance_id();
+	r_result.collider = object->get_instance();
+	r_result.shape = 0;
+
+	if (const JoltShapedObject3D *shaped_object = object->as_shaped()) {
+		const int shape_index = shaped_object->find_shape_index(sub_shape_id);
+		ERR_FAIL_COND_V(shape_index == -1, false);
+		r_result.shape = shape_index;
+		r_result.face_index = _try_get_face_index(*object->get_jolt_body(), sub_shape_id);
+	}
+
+	return true;
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motion(const JPH::Shape &p_jolt_shape, const ShapeParameters &p_parameters, const JoltQueryFilter3D &p_query_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
+	Transform3D transform = p_parameters.transform;
+	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+
+	Vector3 scale;
+	JoltMath::decompose(transform, scale);
+	JOLT_ENSURE_SCALE_VALID(&p_jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+
+	const Vector3 com_scaled = to_godot(p_jolt_shape.GetCenterOfMass());
+	Transform3D transform_com = transform.translated_local(com_scaled);
+
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = (float)p_parameters.margin;
+
+	_cast_motion_impl(p_jolt_shape, transform_com, scale, p_parameters.motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, p_query_filter, p_query_filter, p_query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
+}
+
 bool JoltPhysicsDirectSpaceState3D::_cast_motion_impl(const JPH::Shape &p_jolt_shape, const Transform3D &p_transform_com, const Vector3 &p_scale, const Vector3 &p_motion, bool p_use_edge_removal, bool p_ignore_overlaps, const JPH::CollideShapeSettings &p_settings, const JPH::BroadPhaseLayerFilter &p_broad_phase_layer_filter, const JPH::ObjectLayerFilter &p_object_layer_filter, const JPH::BodyFilter &p_body_filter, const JPH::ShapeFilter &p_shape_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
 	r_closest_safe = 1.0f;
 	r_closest_unsafe = 1.0f;
@@ -392,7 +468,7 @@ bool JoltPhysicsDirectSpaceState3D::_body_motion_collide(const JoltBody3D &p_bod
 	return count > 0;
 }
 
-int JoltPhysicsDirectSpaceState3D::_try_get_face_index(const JPH::Body &p_body, const JPH::SubShapeID &p_sub_shape_id) {
+int JoltPhysicsDirectSpaceState3D::_try_get_face_index(const JPH::Body &p_body, const JPH::SubShapeID &p_sub_shape_id) const {
 	if (!JoltProjectSettings::enable_ray_cast_face_index) {
 		return -1;
 	}
@@ -467,61 +543,7 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	space->flush_pending_objects();
 
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
-
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
-	const JPH::Vec3 vector = JPH::Vec3(to - from);
-	const JPH::RRayCast ray(from, vector);
-
-	const JPH::EBackFaceMode back_face_mode = p_parameters.hit_back_faces ? JPH::EBackFaceMode::CollideWithBackFaces : JPH::EBackFaceMode::IgnoreBackFaces;
-
-	JPH::RayCastSettings settings;
-	settings.mTreatConvexAsSolid = p_parameters.hit_from_inside;
-	settings.mBackFaceModeTriangles = back_face_mode;
-
-	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
-	space->get_narrow_phase_query().CastRay(ray, settings, collector, query_filter, query_filter, query_filter);
-
-	if (!collector.had_hit()) {
-		return false;
-	}
-
-	const JPH::RayCastResult &hit = collector.get_hit();
-
-	const JPH::BodyID &body_id = hit.mBodyID;
-	const JPH::SubShapeID &sub_shape_id = hit.mSubShapeID2;
-
-	const JoltObject3D *object = space->try_get_object(body_id);
-	ERR_FAIL_NULL_V(object, false);
-
-	const JPH::RVec3 position = ray.GetPointOnRay(hit.mFraction);
-
-	JPH::Vec3 normal = JPH::Vec3::sZero();
-
-	if (!p_parameters.hit_from_inside || hit.mFraction > 0.0f) {
-		normal = object->get_jolt_body()->GetWorldSpaceSurfaceNormal(sub_shape_id, position);
-
-		// If we got a back-face normal we need to flip it.
-		if (normal.Dot(vector) > 0) {
-			normal = -normal;
-		}
-	}
-
-	r_result.position = to_godot(position);
-	r_result.normal = to_godot(normal);
-	r_result.rid = object->get_rid();
-	r_result.collider_id = object->get_instance_id();
-	r_result.collider = object->get_instance();
-	r_result.shape = 0;
-
-	if (const JoltShapedObject3D *shaped_object = object->as_shaped()) {
-		const int shape_index = shaped_object->find_shape_index(sub_shape_id);
-		ERR_FAIL_COND_V(shape_index == -1, false);
-		r_result.shape = shape_index;
-		r_result.face_index = _try_get_face_index(*object->get_jolt_body(), sub_shape_id);
-	}
-
-	return true;
+	return _intersect_ray(p_parameters, query_filter, r_result);
 }
 
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
@@ -631,23 +653,55 @@ bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_paramet
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_V(jolt_shape, false);
 
-	Transform3D transform = p_parameters.transform;
-	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+	_cast_motion(*jolt_shape, p_parameters, query_filter, r_closest_safe, r_closest_unsafe);
 
-	Vector3 scale;
-	JoltMath::decompose(transform, scale);
-	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+	return true;
+}
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
-	Transform3D transform_com = transform.translated_local(com_scaled);
+void JoltPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_rays must not be called while the physics space is being stepped.");
 
-	JPH::CollideShapeSettings settings;
-	settings.mMaxSeparationDistance = (float)p_parameters.margin;
+	// Flushing adds bodies to the broadphase, so it must happen here. The narrow phase
+	// queries below only take shared body locks, so the rays can be cast in parallel.
+	space->flush_pending_objects();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	auto intersect_part = [&](uint32_t p_from_index, uint32_t p_to_index) {
+		RayParameters parameters = p_parameters;
+		for (uint32_t i = p_from_index; i < p_to_index; i++) {
+			parameters.from = p_from[i];
+			parameters.to = p_to[i];
+			r_hits[i] = _intersect_ray(parameters, query_filter, r_results[i]);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, p_count, 0, intersect_part, SNAME("JoltIntersectRays"));
+}
+
+void JoltPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "cast_motions must not be called while the physics space is being stepped.");
+
+	// Same as intersect_rays(). Building the shape isn't thread-safe either, so it's built once up front.
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL(jolt_shape);
 
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
-	_cast_motion_impl(*jolt_shape, transform_com, scale, p_parameters.motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, query_filter, query_filter, query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
 
-	return true;
+	auto cast_part = [&](uint32_t p_from, uint32_t p_to) {
+		ShapeParameters parameters = p_parameters;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			parameters.transform = p_transforms[i];
+			parameters.motion = p_motions[i];
+			_cast_motion(*jolt_shape, parameters, query_filter, r_closest_safe[i], r_closest_unsafe[i]);
+		}
+	};
+	WorkerThreadPool::get_singleton()->parallel_for(0, p_count, 0, cast_part, SNAME("JoltCastMotions"));
 }
 
 bool JoltPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
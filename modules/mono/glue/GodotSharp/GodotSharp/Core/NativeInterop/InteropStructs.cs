@@ -758,16 +758,16 @@ namespace Godot.NativeInterop
         {
             private uint _safeRefCount;
 
-            public VariantVector _arrayVector;
-
             private unsafe godot_variant* _readOnly;
 
+            public VariantSmallVector _array;
+
             // There are more fields here, but we don't care as we never store this in C#
 
             public readonly int Size
             {
                 [MethodImpl(MethodImplOptions.AggressiveInlining)]
-                get => _arrayVector.Size;
+                get => _array.Size;
             }
 
             public readonly unsafe bool IsReadOnly
@@ -790,10 +790,34 @@ namespace Godot.NativeInterop
             }
         }
 
+        // SmallVector<Variant, 4>: the elements are inline until there are more than 4, then in the Vector.
+        [StructLayout(LayoutKind.Sequential)]
+        private struct VariantSmallVector
+        {
+            private IntPtr _writeProxy;
+            public VariantVector _heap;
+            private uint _inlineSize;
+
+            // Start of the inline elements, as many as _inlineSize.
+            private ulong _inlineData;
+
+            public readonly unsafe godot_variant* Elements
+            {
+                [MethodImpl(MethodImplOptions.AggressiveInlining)]
+                get => _heap._ptr != null ? _heap._ptr : (godot_variant*)Unsafe.AsPointer(ref Unsafe.AsRef(in _inlineData));
+            }
+
+            public readonly int Size
+            {
+                [MethodImpl(MethodImplOptions.AggressiveInlining)]
+                get => _heap._ptr != null ? _heap.Size : (int)_inlineSize;
+            }
+        }
+
         public readonly unsafe godot_variant* Elements
         {
             [MethodImpl(MethodImplOptions.AggressiveInlining)]
-            get => _p->_arrayVector._ptr;
+            get => _p->_array.Elements;
         }
 
         public readonly unsafe bool IsAllocated
@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_2d.h"
 
+#include "core/object/frame_task_graph.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 #include <cstdint>
@@ -409,6 +410,49 @@ real_t GodotNavigationServer2D::map_get_link_connection_radius(RID p_map) const
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer2D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	const NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_hierarchical_pathfinding_chunk_size, RID, p_map, real_t, p_chunk_size) {
+	NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_hierarchical_pathfinding_chunk_size(p_chunk_size);
+}
+
+real_t GodotNavigationServer2D::map_get_hierarchical_pathfinding_chunk_size(RID p_map) const {
+	const NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, 0);
+
+	return map->get_hierarchical_pathfinding_chunk_size();
+}
+
+COMMAND_2(map_set_path_cache_size, RID, p_map, int, p_path_cache_size) {
+	NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_path_cache_size < 0);
+
+	map->set_path_cache_size(p_path_cache_size);
+}
+
+int GodotNavigationServer2D::map_get_path_cache_size(RID p_map) const {
+	const NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, 0);
+
+	return map->get_path_cache_size();
+}
+
 Vector<Vector2> GodotNavigationServer2D::map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers) {
 	const NavMap2D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector2>());
@@ -1306,14 +1350,7 @@ void GodotNavigationServer2D::process(double p_delta_time) {
 	sync();
 }
 
-void GodotNavigationServer2D::physics_process(double p_delta_time) {
-	// Called for each physics process step AFTER node and user script physics_process() and BEFORE PhysicsServer sync.
-	// Will NOT run reliably every rendered frame. If there is no physics step this function will not run.
-	// Use for physics or step depending calculations and updates where the result affects the next step calculation.
-	// E.g. anything physics sync related, avoidance simulations, physics space state queries, ...
-	// If physics process needs to play catchup this function will be called multiple times per frame so it should not hold
-	// costly updates that are not important outside the stepped calculations to avoid causing a physics performance death spiral.
-
+void GodotNavigationServer2D::_physics_process_sync() {
 	flush_queries();
 
 	if (!active) {
@@ -1333,8 +1370,6 @@ void GodotNavigationServer2D::physics_process(double p_delta_time) {
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
 		active_maps[i]->sync();
-		active_maps[i]->step(p_delta_time);
-		active_maps[i]->dispatch_callbacks();
 
 		_new_pm_region_count += active_maps[i]->get_pm_region_count();
 		_new_pm_agent_count += active_maps[i]->get_pm_agent_count();
@@ -1358,6 +1393,52 @@ void GodotNavigationServer2D::physics_process(double p_delta_time) {
 	pm_obstacle_count = _new_pm_obstacle_count;
 }
 
+void GodotNavigationServer2D::_physics_process_avoidance(double p_delta_time) {
+	MutexLock lock(operations_mutex);
+	if (!active) {
+		return;
+	}
+
+	for (NavMap2D *map : active_maps) {
+		map->step(p_delta_time);
+	}
+}
+
+void GodotNavigationServer2D::_physics_process_step(double p_delta_time) {
+	_physics_process_sync();
+	_physics_process_avoidance(p_delta_time);
+}
+
+void GodotNavigationServer2D::_physics_process_dispatch_callbacks() {
+	MutexLock lock(operations_mutex);
+	if (!active) {
+		return;
+	}
+
+	for (NavMap2D *map : active_maps) {
+		map->dispatch_callbacks();
+	}
+}
+
+void GodotNavigationServer2D::physics_process(double p_delta_time) {
+	// Called for each physics process step AFTER node and user script physics_process() and BEFORE PhysicsServer sync.
+	// Will NOT run reliably every rendered frame. If there is no physics step this function will not run.
+	// Use for physics or step depending calculations and updates where the result affects the next step calculation.
+	// E.g. anything physics sync related, avoidance simulations, physics space state queries, ...
+	// If physics process needs to play catchup this function will be called multiple times per frame so it should not hold
+	// costly updates that are not important outside the stepped calculations to avoid causing a physics performance death spiral.
+
+	_physics_process_step(p_delta_time);
+	_physics_process_dispatch_callbacks();
+}
+
+void GodotNavigationServer2D::add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time) {
+	// Syncing and avoidance only touch navigation data, so they can overlap other servers. Callbacks can run user code.
+	r_graph.add_stage(SNAME("Navigation 2D sync"), callable_mp(this, &GodotNavigationServer2D::_physics_process_sync), {}, { SNAME("navigation_2d") });
+	r_graph.add_stage(SNAME("Navigation 2D avoidance"), callable_mp(this, &GodotNavigationServer2D::_physics_process_avoidance).bind(p_delta_time), { SNAME("navigation_2d") }, { SNAME("navigation_2d_avoidance") });
+	r_graph.add_stage(SNAME("Navigation 2D callbacks"), callable_mp(this, &GodotNavigationServer2D::_physics_process_dispatch_callbacks), { SNAME("navigation_2d_avoidance") }, {}, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD | FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+}
+
 void GodotNavigationServer2D::set_active(bool p_active) {
 	MutexLock lock(operations_mutex);
 
@@ -1374,6 +1455,39 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries2D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer2D::query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) {
+	ERR_FAIL_COND(p_query_parameters.size() != p_query_results.size());
+
+	// Split the batch per map, each map runs its part on a single path query slot.
+	LocalVector<NavMap2D *> maps;
+	LocalVector<LocalVector<Ref<NavigationPathQueryParameters2D>>> map_query_parameters;
+	LocalVector<LocalVector<Ref<NavigationPathQueryResult2D>>> map_query_results;
+
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		NavMap2D *map = map_owner.get_or_null(query_parameters->get_map());
+		ERR_CONTINUE(map == nullptr);
+
+		int64_t map_index = maps.find(map);
+		if (map_index == -1) {
+			map_index = maps.size();
+			maps.push_back(map);
+			map_query_parameters.push_back(LocalVector<Ref<NavigationPathQueryParameters2D>>());
+			map_query_results.push_back(LocalVector<Ref<NavigationPathQueryResult2D>>());
+		}
+		map_query_parameters[map_index].push_back(query_parameters);
+		map_query_results[map_index].push_back(query_result);
+	}
+
+	for (uint32_t i = 0; i < maps.size(); i++) {
+		NavMeshQueries2D::map_query_paths(maps[i], map_query_parameters[i], map_query_results[i]);
+	}
+}
+
 RID GodotNavigationServer2D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -69,6 +69,8 @@ void NavMapBuilder2D::build_navmap_iteration(NavMapIterationBuild2D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_cluster_graph(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -386,6 +388,186 @@ void NavMapBuilder2D::_build_step_navlink_connections(NavMapIterationBuild2D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder2D::_build_step_cluster_graph(NavMapIterationBuild2D &r_build) {
+	NavMapIteration2D *map_iteration = r_build.map_iteration;
+	HashMap<const NavBaseIteration2D *, NavMapIterationBuild2D::RegionClusters> &region_clusters_cache = r_build.region_clusters_cache;
+
+	ClusterGraph &cluster_graph = map_iteration->cluster_graph;
+	cluster_graph.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		region_clusters_cache.clear();
+		return;
+	}
+
+	const real_t chunk_size = MAX(r_build.hierarchical_pathfinding_chunk_size, (real_t)CMP_EPSILON);
+
+	// Drop regions that are gone or were rebuilt since the last iteration.
+	HashSet<const NavBaseIteration2D *> current_regions;
+	for (const Ref<NavRegionIteration2D> &region : map_iteration->region_iterations) {
+		current_regions.insert(region.ptr());
+	}
+	LocalVector<const NavBaseIteration2D *> stale_regions;
+	for (const KeyValue<const NavBaseIteration2D *, NavMapIterationBuild2D::RegionClusters> &E : region_clusters_cache) {
+		if (!current_regions.has(E.key) || E.value.chunk_size != chunk_size) {
+			stale_regions.push_back(E.key);
+		}
+	}
+	for (const NavBaseIteration2D *stale_region : stale_regions) {
+		region_clusters_cache.erase(stale_region);
+	}
+
+	// Chunk the new regions by polygon center and collect the connections that cross chunks.
+	for (const Ref<NavRegionIteration2D> &region : map_iteration->region_iterations) {
+		if (region_clusters_cache.has(region.ptr())) {
+			continue;
+		}
+
+		NavMapIterationBuild2D::RegionClusters &region_clusters = region_clusters_cache[region.ptr()];
+		region_clusters.region = region;
+		region_clusters.chunk_size = chunk_size;
+
+		const LocalVector<Polygon> &polygons = region->get_navmesh_polygons();
+		region_clusters.polygon_chunks.resize(polygons.size());
+
+		HashMap<Vector2i, uint32_t> chunk_ids;
+		for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+			const Polygon &polygon = polygons[polygon_index];
+			Vector2 center;
+			for (const Vector2 &vertex : polygon.vertices) {
+				center += vertex;
+			}
+			if (!polygon.vertices.is_empty()) {
+				center /= polygon.vertices.size();
+			}
+
+			const Vector2i chunk_key = Vector2i((center / chunk_size).floor());
+			HashMap<Vector2i, uint32_t>::Iterator chunk_it = chunk_ids.find(chunk_key);
+			if (!chunk_it) {
+				chunk_it = chunk_ids.insert(chunk_key, chunk_ids.size());
+			}
+			region_clusters.polygon_chunks[polygon_index] = chunk_it->value;
+		}
+		region_clusters.chunk_count = chunk_ids.size();
+
+		HashMap<uint64_t, uint32_t> chunk_portal_ids;
+		LocalVector<uint32_t> chunk_portal_connection_counts;
+		const LocalVector<LocalVector<Connection>> &internal_connections = region->get_internal_connections();
+		for (uint32_t polygon_index = 0; polygon_index < internal_connections.size(); polygon_index++) {
+			const uint32_t from_chunk = region_clusters.polygon_chunks[polygon_index];
+			for (const Connection &connection : internal_connections[polygon_index]) {
+				const uint32_t to_chunk = region_clusters.polygon_chunks[connection.polygon->id];
+				if (from_chunk == to_chunk) {
+					continue;
+				}
+
+				const uint64_t portal_key = ((uint64_t)from_chunk << 32) | to_chunk;
+				HashMap<uint64_t, uint32_t>::Iterator portal_it = chunk_portal_ids.find(portal_key);
+				if (!portal_it) {
+					portal_it = chunk_portal_ids.insert(portal_key, region_clusters.chunk_portals.size());
+					ClusterPortal new_portal;
+					new_portal.from_cluster = from_chunk;
+					new_portal.to_cluster = to_chunk;
+					region_clusters.chunk_portals.push_back(new_portal);
+					chunk_portal_connection_counts.push_back(0);
+				}
+				region_clusters.chunk_portals[portal_it->value].position += (connection.pathway_start + connection.pathway_end) * 0.5;
+				chunk_portal_connection_counts[portal_it->value] += 1;
+			}
+		}
+		for (uint32_t portal_index = 0; portal_index < region_clusters.chunk_portals.size(); portal_index++) {
+			region_clusters.chunk_portals[portal_index].position /= chunk_portal_connection_counts[portal_index];
+		}
+	}
+
+	// Lay out the clusters in the same order as the polygon ids of the path query slots,
+	// region polygons first and link polygons last.
+	HashMap<const NavBaseIteration2D *, uint32_t> navbase_first_cluster;
+	cluster_graph.polygon_clusters.resize(r_build.polygon_count);
+	uint32_t polygon_id = 0;
+
+	for (const Ref<NavRegionIteration2D> &region : map_iteration->region_iterations) {
+		const NavMapIterationBuild2D::RegionClusters &region_clusters = region_clusters_cache[region.ptr()];
+		const uint32_t first_cluster = cluster_graph.clusters.size();
+		navbase_first_cluster[region.ptr()] = first_cluster;
+
+		cluster_graph.clusters.resize(first_cluster + region_clusters.chunk_count);
+		for (uint32_t chunk = 0; chunk < region_clusters.chunk_count; chunk++) {
+			cluster_graph.clusters[first_cluster + chunk].owner = region.ptr();
+		}
+		for (uint32_t polygon_chunk : region_clusters.polygon_chunks) {
+			cluster_graph.polygon_clusters[polygon_id++] = first_cluster + polygon_chunk;
+		}
+		for (const ClusterPortal &chunk_portal : region_clusters.chunk_portals) {
+			ClusterPortal new_portal = chunk_portal;
+			new_portal.from_cluster += first_cluster;
+			new_portal.to_cluster += first_cluster;
+			cluster_graph.portals.push_back(new_portal);
+		}
+	}
+
+	for (const Polygon &link_polygon : map_iteration->navlink_polygons) {
+		const uint32_t link_cluster = cluster_graph.clusters.size();
+		navbase_first_cluster[link_polygon.owner] = link_cluster;
+
+		Cluster new_cluster;
+		new_cluster.owner = link_polygon.owner;
+		cluster_graph.clusters.push_back(new_cluster);
+		cluster_graph.polygon_clusters[polygon_id++] = link_cluster;
+	}
+
+	auto get_polygon_cluster = [&](const Polygon *p_polygon) -> uint32_t {
+		const uint32_t first_cluster = navbase_first_cluster[p_polygon->owner];
+		const NavMapIterationBuild2D::RegionClusters *region_clusters = region_clusters_cache.getptr(p_polygon->owner);
+		return region_clusters ? first_cluster + region_clusters->polygon_chunks[p_polygon->id] : first_cluster;
+	};
+
+	// Portals between navbases from edge merges, edge connection margins and links.
+	HashMap<uint64_t, uint32_t> external_portal_ids;
+	LocalVector<uint32_t> external_portal_connection_counts;
+	const uint32_t first_external_portal = cluster_graph.portals.size();
+
+	for (const KeyValue<const NavBaseIteration2D *, LocalVector<LocalVector<Connection>>> &E : map_iteration->navbases_polygons_external_connections) {
+		const NavMapIterationBuild2D::RegionClusters *region_clusters = region_clusters_cache.getptr(E.key);
+		const uint32_t first_cluster = navbase_first_cluster[E.key];
+
+		for (uint32_t polygon_index = 0; polygon_index < E.value.size(); polygon_index++) {
+			const uint32_t from_cluster = region_clusters ? first_cluster + region_clusters->polygon_chunks[polygon_index] : first_cluster;
+
+			for (const Connection &connection : E.value[polygon_index]) {
+				const uint32_t to_cluster = get_polygon_cluster(connection.polygon);
+				if (from_cluster == to_cluster) {
+					continue;
+				}
+
+				const uint64_t portal_key = ((uint64_t)from_cluster << 32) | to_cluster;
+				HashMap<uint64_t, uint32_t>::Iterator portal_it = external_portal_ids.find(portal_key);
+				if (!portal_it) {
+					portal_it = external_portal_ids.insert(portal_key, cluster_graph.portals.size());
+					ClusterPortal new_portal;
+					new_portal.from_cluster = from_cluster;
+					new_portal.to_cluster = to_cluster;
+					cluster_graph.portals.push_back(new_portal);
+					external_portal_connection_counts.push_back(0);
+				}
+				cluster_graph.portals[portal_it->value].position += (connection.pathway_start + connection.pathway_end) * 0.5;
+				external_portal_connection_counts[portal_it->value - first_external_portal] += 1;
+			}
+		}
+	}
+	for (uint32_t portal_index = first_external_portal; portal_index < cluster_graph.portals.size(); portal_index++) {
+		cluster_graph.portals[portal_index].position /= external_portal_connection_counts[portal_index - first_external_portal];
+	}
+
+	for (uint32_t portal_index = 0; portal_index < cluster_graph.portals.size(); portal_index++) {
+		cluster_graph.clusters[cluster_graph.portals[portal_index].from_cluster].exit_portals.push_back(portal_index);
+	}
+
+	for (const Cluster &cluster : cluster_graph.clusters) {
+		cluster_graph.min_travel_cost = MIN(cluster_graph.min_travel_cost, cluster.owner->get_travel_cost());
+	}
+}
+
 void NavMapBuilder2D::_build_update_map_iteration(NavMapIterationBuild2D &r_build) {
 	NavMapIteration2D *map_iteration = r_build.map_iteration;
 
@@ -419,6 +601,18 @@ void NavMapBuilder2D::_build_update_map_iteration(NavMapIterationBuild2D &r_buil
 		}
 
 		DEV_ASSERT(p_path_query_slot.path_corridor.size() == p_path_query_slot.poly_to_id.size());
+
+		// Queries only reset the entries they touched, so every entry starts out reset.
+		p_path_query_slot.cluster_portal_nodes.clear();
+		p_path_query_slot.cluster_portal_nodes.resize(map_iteration->cluster_graph.portals.size());
+		p_path_query_slot.touched_cluster_portals.clear();
+		p_path_query_slot.open_cluster_portals.clear();
+		p_path_query_slot.clusters_in_corridor.clear();
+		p_path_query_slot.clusters_in_corridor.resize_initialized(map_iteration->cluster_graph.clusters.size());
+		p_path_query_slot.corridor_clusters.clear();
+
+		p_path_query_slot.flow_field.resize(total_polygon_count);
+		p_path_query_slot.open_flow_field_polys.clear();
 	}
 
 	map_iteration->path_query_slots_mutex.unlock();
@@ -47,6 +47,8 @@ struct NavMapIterationBuild2D {
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_pathfinding_chunk_size = 512.0;
 	Nav2D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -58,6 +60,17 @@ struct NavMapIterationBuild2D {
 
 	int navmesh_polygon_count = 0;
 
+	// Chunking of a region into clusters only depends on its own polygons.
+	// Kept across builds so that only changed regions get chunked again.
+	struct RegionClusters {
+		Ref<NavRegionIteration2D> region; // Keeps the key pointer from being reused.
+		real_t chunk_size = 0.0;
+		uint32_t chunk_count = 0;
+		LocalVector<uint32_t> polygon_chunks;
+		LocalVector<Nav2D::ClusterPortal> chunk_portals;
+	};
+	HashMap<const NavBaseIteration2D *, RegionClusters> region_clusters_cache;
+
 	void reset() {
 		performance_data.reset();
 
@@ -85,12 +98,20 @@ struct NavMapIteration2D {
 
 	LocalVector<Nav2D::Polygon> navlink_polygons;
 
+	Nav2D::ClusterGraph cluster_graph;
+
 	HashMap<NavRegion2D *, Ref<NavRegionIteration2D>> region_ptr_to_region_iteration;
 
 	LocalVector<NavMeshQueries2D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
 
+	// Path corridors found by earlier queries on this iteration, dropped with it.
+	mutable Nav2D::PathCache path_cache;
+
+	// Connections grouped by the polygon they lead to, built on first use by batched path queries.
+	mutable Nav2D::FlowField::ReverseConnections reverse_connections;
+
 	void clear() {
 		navmesh_polygon_count = 0;
 
@@ -99,7 +120,11 @@ struct NavMapIteration2D {
 		external_region_connections.clear();
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
+		cluster_graph.clear();
 		region_ptr_to_region_iteration.clear();
+
+		path_cache.clear();
+		reverse_connections.clear();
 	}
 };
 
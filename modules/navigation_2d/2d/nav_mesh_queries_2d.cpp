@@ -146,18 +146,12 @@ void NavMeshQueries2D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(p_map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries2D::_query_task_set_parameters(NavMeshPathQueryTask2D &p_query_task, const Ref<NavigationPathQueryParameters2D> &p_query_parameters) {
 	using namespace NavigationUtilities;
 
-	NavMeshQueries2D::NavMeshPathQueryTask2D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	p_query_task.start_position = p_query_parameters->get_start_position();
+	p_query_task.target_position = p_query_parameters->get_target_position();
+	p_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -165,57 +159,67 @@ void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQ
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	p_query_task.exclude_regions = _excluded_region_count > 0;
+	p_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (p_query_task.exclude_regions) {
+		p_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			p_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (p_query_task.include_regions) {
+		p_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			p_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters2D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			p_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			p_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			p_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_STARTED;
+	p_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	p_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	p_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	p_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	p_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	p_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	p_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	p_query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(p_map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries2D::NavMeshPathQueryTask2D query_task;
+	_query_task_set_parameters(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	p_map->query_path(query_task);
 
@@ -235,6 +239,29 @@ void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQ
 	}
 }
 
+void NavMeshQueries2D::map_query_paths(NavMap2D *p_map, const LocalVector<Ref<NavigationPathQueryParameters2D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult2D>> &p_query_results) {
+	ERR_FAIL_NULL(p_map);
+	ERR_FAIL_COND(p_query_parameters.size() != p_query_results.size());
+
+	LocalVector<NavMeshPathQueryTask2D> query_tasks;
+	query_tasks.resize(p_query_parameters.size());
+	for (uint32_t i = 0; i < p_query_parameters.size(); i++) {
+		_query_task_set_parameters(query_tasks[i], p_query_parameters[i]);
+	}
+
+	p_map->query_paths(query_tasks);
+
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		const NavMeshPathQueryTask2D &query_task = query_tasks[i];
+		p_query_results[i]->set_data(
+				query_task.path_points,
+				query_task.path_meta_point_types,
+				query_task.path_meta_point_rids,
+				query_task.path_meta_point_owners);
+		p_query_results[i]->set_path_length(query_task.path_length);
+	}
+}
+
 void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
@@ -285,6 +312,11 @@ void NavMeshQueries2D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 		return;
 	}
 
+	const uint32_t neighbor_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+	if (p_query_task.use_cluster_corridor && !p_query_task.path_query_slot->clusters_in_corridor[p_query_task.cluster_graph->polygon_clusters[neighbor_id]]) {
+		return;
+	}
+
 	Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer>
 			&traversable_polys = p_query_task.path_query_slot->traversable_polys;
 	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
@@ -295,7 +327,7 @@ void NavMeshQueries2D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -317,6 +349,127 @@ void NavMeshQueries2D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	}
 }
 
+void NavMeshQueries2D::_query_task_build_cluster_corridor(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
+	p_query_task.cluster_graph = nullptr;
+	p_query_task.use_cluster_corridor = false;
+
+	const ClusterGraph &cluster_graph = p_map_iteration.cluster_graph;
+	if (cluster_graph.is_empty()) {
+		return;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+	const uint32_t begin_cluster = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster == end_cluster) {
+		// Short query, the polygon search stays local anyway.
+		return;
+	}
+
+	const Vector2 begin_point = p_query_task.begin_position;
+	const Vector2 end_point = p_query_task.end_position;
+
+	LocalVector<ClusterPortalNode> &portal_nodes = path_query_slot->cluster_portal_nodes;
+	LocalVector<uint32_t> &touched_portals = path_query_slot->touched_cluster_portals;
+	for (uint32_t portal_id : touched_portals) {
+		portal_nodes[portal_id].reset();
+	}
+	touched_portals.clear();
+
+	LocalVector<uint8_t> &clusters_in_corridor = path_query_slot->clusters_in_corridor;
+	LocalVector<uint32_t> &corridor_clusters = path_query_slot->corridor_clusters;
+	for (uint32_t cluster : corridor_clusters) {
+		clusters_in_corridor[cluster] = 0;
+	}
+	corridor_clusters.clear();
+
+	Heap<ClusterPortalNode *, ClusterPortalTravelCostGreaterThan, ClusterPortalHeapIndexer> &open_portals = path_query_slot->open_cluster_portals;
+	open_portals.clear();
+
+	// This is the A* algorithm over the portals, crossing a cluster costs the straight distance scaled by its travel cost.
+	// The remaining distance is only scaled by the lowest travel cost of the map, so it never overestimates.
+	auto open_portal = [&](uint32_t p_portal_id, int p_back_portal_id, const Vector2 &p_from_position, real_t p_traveled_distance) {
+		const ClusterPortal &portal = cluster_graph.portals[p_portal_id];
+		const NavBaseIteration2D *from_owner = cluster_graph.clusters[portal.from_cluster].owner;
+		const NavBaseIteration2D *to_owner = cluster_graph.clusters[portal.to_cluster].owner;
+		if (!_query_task_is_connection_owner_usable(p_query_task, to_owner)) {
+			return;
+		}
+
+		real_t traveled_distance = p_traveled_distance + p_from_position.distance_to(portal.position) * from_owner->get_travel_cost();
+		if (to_owner != from_owner) {
+			traveled_distance += to_owner->get_enter_cost();
+		}
+
+		ClusterPortalNode &portal_node = portal_nodes[p_portal_id];
+		if (traveled_distance >= portal_node.traveled_distance) {
+			return;
+		}
+		if (portal_node.traveled_distance == FLT_MAX) {
+			touched_portals.push_back(p_portal_id);
+		}
+		portal_node.back_portal_id = p_back_portal_id;
+		portal_node.traveled_distance = traveled_distance;
+		portal_node.distance_to_destination = portal.position.distance_to(end_point) * cluster_graph.min_travel_cost;
+
+		if (portal_node.open_portal_index != open_portals.INVALID_INDEX) {
+			open_portals.shift(portal_node.open_portal_index);
+		} else {
+			open_portals.push(&portal_node);
+		}
+	};
+
+	for (uint32_t portal_id : cluster_graph.clusters[begin_cluster].exit_portals) {
+		open_portal(portal_id, -1, begin_point, 0.0);
+	}
+
+	int end_portal_id = -1;
+	while (!open_portals.is_empty()) {
+		const ClusterPortalNode *portal_node = open_portals.pop();
+		const uint32_t portal_id = portal_node - portal_nodes.ptr();
+		const ClusterPortal &portal = cluster_graph.portals[portal_id];
+		if (portal.to_cluster == end_cluster) {
+			end_portal_id = portal_id;
+			break;
+		}
+
+		for (uint32_t next_portal_id : cluster_graph.clusters[portal.to_cluster].exit_portals) {
+			open_portal(next_portal_id, portal_id, portal.position, portal_node->traveled_distance);
+		}
+	}
+	open_portals.clear();
+
+	if (end_portal_id < 0) {
+		// No route between the clusters, leave finding the closest reachable point to the full search.
+		return;
+	}
+
+	// Allow the clusters along the route and their neighbors, the polygon path may cut corners through them.
+	// The polygon search then finds the shortest path inside this corridor. That path can be longer than the
+	// shortest path on the whole map when the portal positions misjudge a cluster crossing. Only a corridor
+	// that doesn't connect the end polygon at all falls back to the full search.
+	auto mark_cluster = [&](uint32_t p_cluster) {
+		if (!clusters_in_corridor[p_cluster]) {
+			clusters_in_corridor[p_cluster] = 1;
+			corridor_clusters.push_back(p_cluster);
+		}
+	};
+	auto add_cluster_to_corridor = [&](uint32_t p_cluster) {
+		mark_cluster(p_cluster);
+		for (uint32_t exit_portal_id : cluster_graph.clusters[p_cluster].exit_portals) {
+			mark_cluster(cluster_graph.portals[exit_portal_id].to_cluster);
+		}
+	};
+
+	add_cluster_to_corridor(begin_cluster);
+	for (int portal_id = end_portal_id; portal_id >= 0; portal_id = portal_nodes[portal_id].back_portal_id) {
+		add_cluster_to_corridor(cluster_graph.portals[portal_id].to_cluster);
+	}
+
+	p_query_task.cluster_graph = &cluster_graph;
+	p_query_task.use_cluster_corridor = true;
+}
+
 void NavMeshQueries2D::_query_task_build_path_corridor(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
 	const Vector2 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
@@ -401,6 +554,26 @@ void NavMeshQueries2D::_query_task_build_path_corridor(NavMeshPathQueryTask2D &p
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (p_query_task.use_cluster_corridor && !path_search_max_reached) {
+				// The cluster corridor was too narrow for the polygon connections, search the whole map instead.
+				p_query_task.use_cluster_corridor = false;
+
+				for (NavigationPoly &nav_poly : navigation_polys) {
+					nav_poly.reset();
+				}
+				least_cost_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
+				navigation_polys[least_cost_id].poly = begin_poly;
+				navigation_polys[least_cost_id].entry = begin_point;
+				navigation_polys[least_cost_id].back_navigation_edge_pathway_start = begin_point;
+				navigation_polys[least_cost_id].back_navigation_edge_pathway_end = begin_point;
+				navigation_polys[least_cost_id].traveled_distance = 0.f;
+
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+				processed_polygon_count = 0;
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -517,6 +690,62 @@ void NavMeshQueries2D::query_task_map_iteration_get_path(NavMeshPathQueryTask2D
 
 	_query_task_find_start_end_positions(p_query_task, p_map_iteration);
 
+	_query_task_build_path(p_query_task, p_map_iteration);
+}
+
+void NavMeshQueries2D::query_tasks_map_iteration_get_paths(LocalVector<NavMeshPathQueryTask2D> &p_query_tasks, const NavMapIteration2D &p_map_iteration) {
+	// Group the queries that share a destination, each group is served by a single reverse search.
+	LocalVector<LocalVector<NavMeshPathQueryTask2D *>> destination_groups;
+
+	for (NavMeshPathQueryTask2D &query_task : p_query_tasks) {
+		query_task.path_clear();
+
+		_query_task_find_start_end_positions(query_task, p_map_iteration);
+
+		if (!query_task.begin_polygon || !query_task.end_polygon || query_task.begin_polygon == query_task.end_polygon || query_task.path_search_max_distance > 0.0) {
+			// Trivial, or limited by the distance to the begin position which a shared search can't honor.
+			_query_task_build_path(query_task, p_map_iteration);
+			continue;
+		}
+
+		bool grouped = false;
+		for (LocalVector<NavMeshPathQueryTask2D *> &destination_group : destination_groups) {
+			if (_query_tasks_share_destination(*destination_group[0], query_task)) {
+				destination_group.push_back(&query_task);
+				grouped = true;
+				break;
+			}
+		}
+		if (!grouped) {
+			destination_groups.push_back(LocalVector<NavMeshPathQueryTask2D *>());
+			destination_groups[destination_groups.size() - 1].push_back(&query_task);
+		}
+	}
+
+	for (const LocalVector<NavMeshPathQueryTask2D *> &destination_group : destination_groups) {
+		if (destination_group.size() == 1) {
+			_query_task_build_path(*destination_group[0], p_map_iteration);
+			continue;
+		}
+
+		_query_tasks_build_flow_field(destination_group, p_map_iteration);
+
+		PathQuerySlot *path_query_slot = destination_group[0]->path_query_slot;
+		for (NavMeshPathQueryTask2D *query_task : destination_group) {
+			const uint32_t begin_poly_id = path_query_slot->poly_to_id[query_task->begin_polygon];
+			if (path_query_slot->flow_field[begin_poly_id].distance_to_destination == FLT_MAX) {
+				// Not connected to the destination, the single query finds the closest reachable point.
+				_query_task_build_path(*query_task, p_map_iteration);
+				continue;
+			}
+
+			query_task->least_cost_id = FlowField::build_path_corridor(path_query_slot->flow_field, path_query_slot->path_corridor, query_task->begin_polygon, begin_poly_id, query_task->begin_position);
+			_query_task_post_process_path(*query_task);
+		}
+	}
+}
+
+void NavMeshQueries2D::_query_task_build_path(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
 	// Check for trivial cases.
 	if (!p_query_task.begin_polygon || !p_query_task.end_polygon) {
 		p_query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_FINISHED;
@@ -531,6 +760,15 @@ void NavMeshQueries2D::query_task_map_iteration_get_path(NavMeshPathQueryTask2D
 		return;
 	}
 
+	if (_query_task_load_cached_path_corridor(p_query_task, p_map_iteration)) {
+		_query_task_post_process_path(p_query_task);
+		return;
+	}
+
+	const Polygon *requested_end_polygon = p_query_task.end_polygon;
+
+	_query_task_build_cluster_corridor(p_query_task, p_map_iteration);
+
 	_query_task_build_path_corridor(p_query_task, p_map_iteration);
 
 	if (p_query_task.status == NavMeshPathQueryTask2D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask2D::TaskStatus::QUERY_FAILED) {
@@ -538,6 +776,15 @@ void NavMeshQueries2D::query_task_map_iteration_get_path(NavMeshPathQueryTask2D
 		return;
 	}
 
+	// Corridors that only lead to the closest reachable polygon are not worth keeping.
+	if (p_query_task.end_polygon == requested_end_polygon) {
+		_query_task_store_path_corridor(p_query_task, p_map_iteration);
+	}
+
+	_query_task_post_process_path(p_query_task);
+}
+
+void NavMeshQueries2D::_query_task_post_process_path(NavMeshPathQueryTask2D &p_query_task) {
 	// Post-Process path.
 	switch (p_query_task.path_postprocessing) {
 		case PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
@@ -581,6 +828,97 @@ void NavMeshQueries2D::query_task_map_iteration_get_path(NavMeshPathQueryTask2D
 	p_query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_FINISHED;
 }
 
+bool NavMeshQueries2D::_query_task_get_path_cache_key(NavMeshPathQueryTask2D &p_query_task, NavPathCacheKey &r_key) {
+	if (p_query_task.path_search_max_distance > 0.0) {
+		// The search limit depends on the begin position, not only on the begin polygon.
+		return false;
+	}
+
+	r_key.begin_polygon_id = p_query_task.path_query_slot->poly_to_id[p_query_task.begin_polygon];
+	r_key.end_polygon_id = p_query_task.path_query_slot->poly_to_id[p_query_task.end_polygon];
+	r_key.navigation_layers = p_query_task.navigation_layers;
+	r_key.path_search_max_polygons = p_query_task.path_search_max_polygons;
+	if (p_query_task.exclude_regions) {
+		r_key.excluded_regions = p_query_task.excluded_regions;
+	}
+	if (p_query_task.include_regions) {
+		r_key.included_regions = p_query_task.included_regions;
+	}
+	return true;
+}
+
+bool NavMeshQueries2D::_query_task_load_cached_path_corridor(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
+	if (p_map_iteration.path_cache.get_size() == 0) {
+		return false;
+	}
+
+	NavPathCacheKey path_cache_key;
+	if (!_query_task_get_path_cache_key(p_query_task, path_cache_key)) {
+		return false;
+	}
+
+	// The corridor may have been found from another position on the begin polygon, the entry points follow the new one.
+	const int end_poly_id = p_map_iteration.path_cache.load<Geometry2D>(path_cache_key, p_query_task.begin_position, p_query_task.path_query_slot->path_corridor);
+	if (end_poly_id < 0) {
+		return false;
+	}
+
+	p_query_task.least_cost_id = end_poly_id;
+	return true;
+}
+
+void NavMeshQueries2D::_query_task_store_path_corridor(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
+	if (p_map_iteration.path_cache.get_size() == 0) {
+		return;
+	}
+
+	NavPathCacheKey path_cache_key;
+	if (!_query_task_get_path_cache_key(p_query_task, path_cache_key)) {
+		return;
+	}
+
+	p_map_iteration.path_cache.store(path_cache_key, p_query_task.path_query_slot->path_corridor, p_query_task.least_cost_id);
+}
+
+bool NavMeshQueries2D::_query_tasks_share_destination(const NavMeshPathQueryTask2D &p_query_task_a, const NavMeshPathQueryTask2D &p_query_task_b) {
+	if (p_query_task_a.end_polygon != p_query_task_b.end_polygon || p_query_task_a.end_position != p_query_task_b.end_position) {
+		return false;
+	}
+	if (p_query_task_a.navigation_layers != p_query_task_b.navigation_layers) {
+		return false;
+	}
+	if (p_query_task_a.exclude_regions != p_query_task_b.exclude_regions || p_query_task_a.include_regions != p_query_task_b.include_regions) {
+		return false;
+	}
+
+	if (p_query_task_a.exclude_regions && !NavPathCacheKey::regions_equal(p_query_task_a.excluded_regions, p_query_task_b.excluded_regions)) {
+		return false;
+	}
+	if (p_query_task_a.include_regions && !NavPathCacheKey::regions_equal(p_query_task_a.included_regions, p_query_task_b.included_regions)) {
+		return false;
+	}
+	return true;
+}
+
+void NavMeshQueries2D::_query_tasks_build_flow_field(const LocalVector<NavMeshPathQueryTask2D *> &p_query_tasks, const NavMapIteration2D &p_map_iteration) {
+	const NavMeshPathQueryTask2D &destination_task = *p_query_tasks[0];
+	PathQuerySlot *path_query_slot = destination_task.path_query_slot;
+
+	p_map_iteration.reverse_connections.build(p_map_iteration, path_query_slot->poly_to_id);
+
+	// The search can stop once every begin polygon has its final cost.
+	HashSet<uint32_t> pending_begin_poly_ids;
+	for (const NavMeshPathQueryTask2D *query_task : p_query_tasks) {
+		pending_begin_poly_ids.insert(path_query_slot->poly_to_id[query_task->begin_polygon]);
+	}
+
+	FlowField::search<Geometry2D>(path_query_slot->flow_field, path_query_slot->open_flow_field_polys, p_map_iteration.reverse_connections,
+			destination_task.end_polygon, path_query_slot->poly_to_id[destination_task.end_polygon], destination_task.end_position, pending_begin_poly_ids,
+			[&destination_task](const NavBaseIteration2D *p_owner) {
+				return _query_task_is_connection_owner_usable(destination_task, p_owner);
+			});
+}
+
 float NavMeshQueries2D::_calculate_path_length(const LocalVector<Vector2> &p_path, uint32_t p_start_index, uint32_t p_end_index) {
 	const uint32_t path_size = p_path.size();
 	if (path_size < 2) {
@@ -109,6 +109,30 @@ void NavMap2D::set_link_connection_radius(real_t p_link_connection_radius) {
 	iteration_dirty = true;
 }
 
+void NavMap2D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap2D::set_hierarchical_pathfinding_chunk_size(real_t p_chunk_size) {
+	if (hierarchical_pathfinding_chunk_size == p_chunk_size) {
+		return;
+	}
+	hierarchical_pathfinding_chunk_size = p_chunk_size;
+	iteration_dirty = true;
+}
+
+void NavMap2D::set_path_cache_size(uint32_t p_path_cache_size) {
+	path_cache_size = p_path_cache_size;
+	// The corridors stay valid, so this doesn't need a new iteration.
+	for (NavMapIteration2D &iteration_slot : iteration_slots) {
+		iteration_slot.path_cache.set_size(path_cache_size);
+	}
+}
+
 const Vector2 &NavMap2D::get_merge_rasterizer_cell_size() const {
 	return merge_rasterizer_cell_size;
 }
@@ -159,6 +183,49 @@ void NavMap2D::query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task
 	map_iteration.path_query_slots_semaphore.post();
 }
 
+void NavMap2D::query_paths(LocalVector<NavMeshQueries2D::NavMeshPathQueryTask2D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
+
+	map_iteration.path_query_slots_semaphore.wait();
+
+	// All queries of the batch run one after another on the same slot, so they don't wait on each other for slots.
+	NavMeshQueries2D::PathQuerySlot *path_query_slot = nullptr;
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries2D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+		if (!p_path_query_slot.in_use) {
+			p_path_query_slot.in_use = true;
+			path_query_slot = &p_path_query_slot;
+			break;
+		}
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_MSG(path_query_slot, "No unused NavMap2D path query slot found! This should never happen :(.");
+	}
+
+	for (NavMeshQueries2D::NavMeshPathQueryTask2D &query_task : p_query_tasks) {
+		query_task.path_query_slot = path_query_slot;
+	}
+
+	NavMeshQueries2D::query_tasks_map_iteration_get_paths(p_query_tasks, map_iteration);
+
+	map_iteration.path_query_slots_mutex.lock();
+	map_iteration.path_query_slots[path_query_slot->slot_index].in_use = false;
+	for (NavMeshQueries2D::NavMeshPathQueryTask2D &query_task : p_query_tasks) {
+		query_task.path_query_slot = nullptr;
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	map_iteration.path_query_slots_semaphore.post();
+}
+
 Vector2 NavMap2D::get_closest_point(const Vector2 &p_point) const {
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -314,6 +381,8 @@ void NavMap2D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = use_hierarchical_pathfinding;
+	iteration_build.hierarchical_pathfinding_chunk_size = hierarchical_pathfinding_chunk_size;
 
 	next_map_iteration.clear();
 
@@ -767,6 +836,11 @@ NavMap2D::NavMap2D() {
 		path_query_slots_max = 1;
 	}
 
+	path_cache_size = MAX(0, (int)GLOBAL_GET("navigation/pathfinding/path_cache_size"));
+
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/2d/use_hierarchical_pathfinding");
+	hierarchical_pathfinding_chunk_size = GLOBAL_GET("navigation/2d/hierarchical_pathfinding_chunk_size");
+
 	iteration_slots.resize(2);
 
 	for (NavMapIteration2D &iteration_slot : iteration_slots) {
@@ -775,6 +849,7 @@ NavMap2D::NavMap2D() {
 			iteration_slot.path_query_slots[i].slot_index = i;
 		}
 		iteration_slot.path_query_slots_semaphore.post(path_query_slots_max);
+		iteration_slot.path_cache.set_size(path_cache_size);
 	}
 
 #ifdef THREADS_ENABLED
@@ -129,6 +129,11 @@ class NavMap2D : public NavRid2D {
 
 	int path_query_slots_max = 4;
 
+	uint32_t path_cache_size = 0;
+
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_pathfinding_chunk_size = 512.0;
+
 	bool use_async_iterations = true;
 
 	uint32_t iteration_slot_index = 0;
@@ -177,10 +182,27 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_pathfinding_chunk_size(real_t p_chunk_size);
+	real_t get_hierarchical_pathfinding_chunk_size() const {
+		return hierarchical_pathfinding_chunk_size;
+	}
+
+	void set_path_cache_size(uint32_t p_path_cache_size);
+	uint32_t get_path_cache_size() const {
+		return path_cache_size;
+	}
+
 	Nav2D::PointKey get_point_key(const Vector2 &p_pos) const;
 	const Vector2 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task);
+	// Runs all queries on the calling thread, one after another on a single path query slot.
+	void query_paths(LocalVector<NavMeshQueries2D::NavMeshPathQueryTask2D> &p_query_tasks);
 
 	Vector2 get_closest_point(const Vector2 &p_point) const;
 	Nav2D::ClosestPointQueryResult get_closest_point_info(const Vector2 &p_point) const;
@@ -34,7 +34,9 @@
 #include "core/object/ref_counted.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
+#include "servers/navigation/nav_flow_field.h"
 #include "servers/navigation/nav_heap.h"
+#include "servers/navigation/nav_path_cache.h"
 #include "servers/navigation/navigation_utilities.h"
 
 class NavBaseIteration2D;
@@ -170,6 +172,81 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+/// A chunk of a navigation region, or a whole navigation link, in the hierarchical pathfinding graph.
+struct Cluster {
+	/// Navigation region or link that contains the polygons of this cluster.
+	const NavBaseIteration2D *owner = nullptr;
+
+	/// Portals leading out of this cluster, as indices in ClusterGraph::portals.
+	LocalVector<uint32_t> exit_portals;
+};
+
+/// One-way crossing between two clusters, merged from all polygon connections between them.
+struct ClusterPortal {
+	uint32_t from_cluster = 0;
+	uint32_t to_cluster = 0;
+
+	/// Average of the pathway midpoints of the merged connections.
+	Vector2 position;
+};
+
+struct ClusterGraph {
+	LocalVector<Cluster> clusters;
+	LocalVector<ClusterPortal> portals;
+
+	/// Cluster of each polygon, indexed by the polygon ids of PathQuerySlot::poly_to_id.
+	LocalVector<uint32_t> polygon_clusters;
+
+	/// Lowest travel cost of all cluster owners. Scaling the remaining distance by it keeps the portal search heuristic from overestimating.
+	real_t min_travel_cost = 1.0;
+
+	bool is_empty() const { return clusters.is_empty(); }
+
+	void clear() {
+		clusters.clear();
+		portals.clear();
+		polygon_clusters.clear();
+		min_travel_cost = 1.0;
+	}
+};
+
+struct ClusterPortalNode {
+	/// Index in the heap of open portals.
+	uint32_t open_portal_index = UINT32_MAX;
+
+	/// Portal this one was reached from, -1 for portals leaving the begin cluster.
+	int back_portal_id = -1;
+
+	real_t traveled_distance = FLT_MAX;
+	real_t distance_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+
+	void reset() {
+		open_portal_index = UINT32_MAX;
+		back_portal_id = -1;
+		traveled_distance = FLT_MAX;
+		distance_to_destination = 0.0;
+	}
+};
+
+struct ClusterPortalTravelCostGreaterThan {
+	bool operator()(const ClusterPortalNode *p_node_a, const ClusterPortalNode *p_node_b) const {
+		return p_node_a->total_travel_cost() > p_node_b->total_travel_cost();
+	}
+};
+
+struct ClusterPortalHeapIndexer {
+	void operator()(ClusterPortalNode *p_node, uint32_t p_heap_index) const {
+		p_node->open_portal_index = p_heap_index;
+	}
+};
+
+typedef NavFlowField<Polygon, Connection, Vector2> FlowField;
+typedef NavPathCache<Polygon, Vector2> PathCache;
+
 struct ClosestPointQueryResult {
 	Vector2 point;
 	RID owner;
@@ -126,6 +126,15 @@ public:
 	COMMAND_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius);
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
+	COMMAND_2(map_set_hierarchical_pathfinding_chunk_size, RID, p_map, real_t, p_chunk_size);
+	virtual real_t map_get_hierarchical_pathfinding_chunk_size(RID p_map) const override;
+
+	COMMAND_2(map_set_path_cache_size, RID, p_map, int, p_path_cache_size);
+	virtual int map_get_path_cache_size(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
@@ -288,17 +297,24 @@ public:
 
 	virtual void process(double p_delta_time) override;
 	virtual void physics_process(double p_delta_time) override;
+	virtual void add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time) override;
 	virtual void init() override;
 	virtual void sync() override;
 	virtual void finish() override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	void _physics_process_sync();
+	void _physics_process_avoidance(double p_delta_time);
+	void _physics_process_step(double p_delta_time);
+	void _physics_process_dispatch_callbacks();
 };
 
 #undef COMMAND_1
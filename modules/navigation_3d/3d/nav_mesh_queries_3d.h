@@ -52,6 +52,18 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Hierarchical pathfinding scratch, sized to the cluster graph of the map iteration.
+		// The touched entries are listed so the next query only resets those.
+		LocalVector<Nav3D::ClusterPortalNode> cluster_portal_nodes;
+		LocalVector<uint32_t> touched_cluster_portals;
+		Heap<Nav3D::ClusterPortalNode *, Nav3D::ClusterPortalTravelCostGreaterThan, Nav3D::ClusterPortalHeapIndexer> open_cluster_portals;
+		LocalVector<uint8_t> clusters_in_corridor;
+		LocalVector<uint32_t> corridor_clusters;
+
+		// Reverse search scratch for batched queries that share a destination.
+		LocalVector<Nav3D::FlowField::Poly> flow_field;
+		Nav3D::FlowField::OpenPolys open_flow_field_polys;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -90,6 +102,10 @@ public:
 		const Nav3D::Polygon *end_polygon = nullptr;
 		uint32_t least_cost_id = 0;
 
+		// When set, the polygon search only expands into the clusters marked in PathQuerySlot::clusters_in_corridor.
+		const Nav3D::ClusterGraph *cluster_graph = nullptr;
+		bool use_cluster_corridor = false;
+
 		// Map.
 		Vector3 map_up;
 		NavMap3D *map = nullptr;
@@ -140,10 +156,21 @@ public:
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_paths(NavMap3D *p_map, const LocalVector<Ref<NavigationPathQueryParameters3D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult3D>> &p_query_results);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void query_tasks_map_iteration_get_paths(LocalVector<NavMeshPathQueryTask3D> &p_query_tasks, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_set_parameters(NavMeshPathQueryTask3D &p_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void _query_task_build_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_post_process_path(NavMeshPathQueryTask3D &p_query_task);
+	static bool _query_task_get_path_cache_key(NavMeshPathQueryTask3D &p_query_task, NavPathCacheKey &r_key);
+	static bool _query_task_load_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_store_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_tasks_share_destination(const NavMeshPathQueryTask3D &p_query_task_a, const NavMeshPathQueryTask3D &p_query_task_b);
+	static void _query_tasks_build_flow_field(const LocalVector<NavMeshPathQueryTask3D *> &p_query_tasks, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
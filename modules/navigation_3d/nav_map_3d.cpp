@@ -126,6 +126,30 @@ void NavMap3D::set_link_connection_radius(real_t p_link_connection_radius) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_hierarchical_pathfinding_chunk_size(real_t p_chunk_size) {
+	if (hierarchical_pathfinding_chunk_size == p_chunk_size) {
+		return;
+	}
+	hierarchical_pathfinding_chunk_size = p_chunk_size;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_path_cache_size(uint32_t p_path_cache_size) {
+	path_cache_size = p_path_cache_size;
+	// The corridors stay valid, so this doesn't need a new iteration.
+	for (NavMapIteration3D &iteration_slot : iteration_slots) {
+		iteration_slot.path_cache.set_size(path_cache_size);
+	}
+}
+
 const Vector3 &NavMap3D::get_merge_rasterizer_cell_size() const {
 	return merge_rasterizer_cell_size;
 }
@@ -180,6 +204,50 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 	map_iteration.path_query_slots_semaphore.post();
 }
 
+void NavMap3D::query_paths(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
+
+	map_iteration.path_query_slots_semaphore.wait();
+
+	// All queries of the batch run one after another on the same slot, so they don't wait on each other for slots.
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = nullptr;
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+		if (!p_path_query_slot.in_use) {
+			p_path_query_slot.in_use = true;
+			path_query_slot = &p_path_query_slot;
+			break;
+		}
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_MSG(path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	for (NavMeshQueries3D::NavMeshPathQueryTask3D &query_task : p_query_tasks) {
+		query_task.path_query_slot = path_query_slot;
+		query_task.map_up = map_iteration.map_up;
+	}
+
+	NavMeshQueries3D::query_tasks_map_iteration_get_paths(p_query_tasks, map_iteration);
+
+	map_iteration.path_query_slots_mutex.lock();
+	map_iteration.path_query_slots[path_query_slot->slot_index].in_use = false;
+	for (NavMeshQueries3D::NavMeshPathQueryTask3D &query_task : p_query_tasks) {
+		query_task.path_query_slot = nullptr;
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	map_iteration.path_query_slots_semaphore.post();
+}
+
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -368,6 +436,8 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = use_hierarchical_pathfinding;
+	iteration_build.hierarchical_pathfinding_chunk_size = hierarchical_pathfinding_chunk_size;
 
 	next_map_iteration.clear();
 
@@ -612,8 +682,13 @@ void NavMap3D::step(double p_delta_time) {
 
 	if (active_2d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			NavAgent3D **agents = active_2d_avoidance_agents.ptr();
+			auto compute_avoidance_steps = [this, agents](uint32_t p_from, uint32_t p_to) {
+				for (uint32_t i = p_from; i < p_to; i++) {
+					compute_single_avoidance_step_2d(i, agents);
+				}
+			};
+			WorkerThreadPool::get_singleton()->parallel_for(0, active_2d_avoidance_agents.size(), 0, compute_avoidance_steps, SNAME("RVOAvoidanceAgents2D"));
 		} else {
 			for (NavAgent3D *agent : active_2d_avoidance_agents) {
 				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
@@ -626,8 +701,13 @@ void NavMap3D::step(double p_delta_time) {
 
 	if (active_3d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			NavAgent3D **agents = active_3d_avoidance_agents.ptr();
+			auto compute_avoidance_steps = [this, agents](uint32_t p_from, uint32_t p_to) {
+				for (uint32_t i = p_from; i < p_to; i++) {
+					compute_single_avoidance_step_3d(i, agents);
+				}
+			};
+			WorkerThreadPool::get_singleton()->parallel_for(0, active_3d_avoidance_agents.size(), 0, compute_avoidance_steps, SNAME("RVOAvoidanceAgents3D"));
 		} else {
 			for (NavAgent3D *agent : active_3d_avoidance_agents) {
 				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
@@ -869,6 +949,11 @@ NavMap3D::NavMap3D() {
 		path_query_slots_max = 1;
 	}
 
+	path_cache_size = MAX(0, (int)GLOBAL_GET("navigation/pathfinding/path_cache_size"));
+
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/3d/use_hierarchical_pathfinding");
+	hierarchical_pathfinding_chunk_size = GLOBAL_GET("navigation/3d/hierarchical_pathfinding_chunk_size");
+
 	iteration_slots.resize(2);
 
 	for (NavMapIteration3D &iteration_slot : iteration_slots) {
@@ -877,6 +962,7 @@ NavMap3D::NavMap3D() {
 			iteration_slot.path_query_slots[i].slot_index = i;
 		}
 		iteration_slot.path_query_slots_semaphore.post(path_query_slots_max);
+		iteration_slot.path_cache.set_size(path_cache_size);
 	}
 
 #ifdef THREADS_ENABLED
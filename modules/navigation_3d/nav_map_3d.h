@@ -137,6 +137,11 @@ class NavMap3D : public NavRid3D {
 
 	int path_query_slots_max = 4;
 
+	uint32_t path_cache_size = 0;
+
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_pathfinding_chunk_size = 32.0;
+
 	bool use_async_iterations = true;
 
 	uint32_t iteration_slot_index = 0;
@@ -193,10 +198,27 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_pathfinding_chunk_size(real_t p_chunk_size);
+	real_t get_hierarchical_pathfinding_chunk_size() const {
+		return hierarchical_pathfinding_chunk_size;
+	}
+
+	void set_path_cache_size(uint32_t p_path_cache_size);
+	uint32_t get_path_cache_size() const {
+		return path_cache_size;
+	}
+
 	Nav3D::PointKey get_point_key(const Vector3 &p_pos) const;
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	// Runs all queries on the calling thread, one after another on a single path query slot.
+	void query_paths(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
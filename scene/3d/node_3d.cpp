@@ -83,12 +83,6 @@ void Node3D::_notify_dirty() {
 	}
 }
 
-void Node3D::_update_local_transform() const {
-	// This function is called when the local transform (data.local_transform) is dirty and the right value is contained in the Euler rotation and scale.
-	data.local_transform.basis.set_euler_scale(data.euler_rotation, data.scale, data.euler_rotation_order);
-	_clear_dirty_bits(DIRTY_LOCAL_TRANSFORM);
-}
-
 void Node3D::_update_rotation_and_scale() const {
 	// This function is called when the Euler rotation (data.euler_rotation) is dirty and the right value is contained in the local transform
 
@@ -108,6 +102,10 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
+	if (p_origin == this) {
+		get_tree()->get_transform_hierarchy().node_3d_notify_changed(*this);
+	}
+
 	for (Node3D *&E : data.children) {
 		if (E->data.top_level) {
 			continue; //don't propagate to a top_level
@@ -166,6 +164,8 @@ void Node3D::_notification(int p_what) {
 
 			_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM | DIRTY_GLOBAL_INTERPOLATED_TRANSFORM); // Global is always dirty upon entering a scene.
 			_notify_dirty();
+			get_tree()->get_transform_hierarchy().node_3d_notify_tree_changed();
+			get_tree()->get_transform_hierarchy().node_3d_notify_changed(*this);
 
 			notification(NOTIFICATION_ENTER_WORLD);
 			_update_visibility_parent(true);
@@ -196,6 +196,7 @@ void Node3D::_notification(int p_what) {
 
 			if (is_inside_tree()) {
 				get_tree()->get_scene_tree_fti().node_3d_notify_delete(this);
+				get_tree()->get_transform_hierarchy().node_3d_notify_delete(this);
 			}
 
 			notification(NOTIFICATION_EXIT_WORLD, true);
@@ -1559,5 +1560,6 @@ Node3D::~Node3D() {
 
 	if (is_inside_tree()) {
 		get_tree()->get_scene_tree_fti().node_3d_notify_delete(this);
+		get_tree()->get_transform_hierarchy().node_3d_notify_delete(this);
 	}
 }
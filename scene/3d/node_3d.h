@@ -52,6 +52,7 @@ class Node3D : public Node {
 
 	friend class SceneTreeFTI;
 	friend class SceneTreeFTITests;
+	friend class SceneTreeTransformHierarchy;
 
 public:
 	// Edit mode for the rotation.
@@ -147,6 +148,10 @@ private:
 		bool fti_is_identity_xform : 1;
 		bool fti_processed : 1;
 
+		// Batched transform updates. Positions in the flattened hierarchy and in its dirty list, UINT32_MAX when not there.
+		uint32_t transform_hierarchy_index = UINT32_MAX;
+		uint32_t transform_hierarchy_dirty_index = UINT32_MAX;
+
 		RID visibility_parent;
 
 		Node3D *parent = nullptr;
@@ -186,7 +191,11 @@ private:
 protected:
 	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
 
-	_FORCE_INLINE_ void _update_local_transform() const;
+	_FORCE_INLINE_ void _update_local_transform() const {
+		// This function is called when the local transform (data.local_transform) is dirty and the right value is contained in the Euler rotation and scale.
+		data.local_transform.basis.set_euler_scale(data.euler_rotation, data.scale, data.euler_rotation_order);
+		_clear_dirty_bits(DIRTY_LOCAL_TRANSFORM);
+	}
 	_FORCE_INLINE_ void _update_rotation_and_scale() const;
 
 	void _set_vi_visible(bool p_visible) { data.vi_visible = p_visible; }
@@ -51,7 +51,8 @@ void VisualInstance3D::_update_visibility() {
 	if (visible && !already_visible) {
 		if (!_is_using_identity_transform()) {
 			Transform3D gt = get_global_transform();
-			RS::get_singleton()->instance_set_transform(instance, gt);
+			// Through the tree, so a transform batched earlier in the same flush can't overwrite it.
+			get_tree()->submit_instance_transform(instance, gt);
 		}
 	}
 
@@ -65,17 +66,17 @@ void VisualInstance3D::set_instance_use_identity_transform(bool p_enable) {
 	if (is_inside_tree()) {
 		if (p_enable) {
 			// Want to make sure instance is using identity transform.
-			RS::get_singleton()->instance_set_transform(instance, Transform3D());
+			get_tree()->submit_instance_transform(instance, Transform3D());
 		} else {
 			// Want to make sure instance is up to date.
-			RS::get_singleton()->instance_set_transform(instance, get_global_transform());
+			get_tree()->submit_instance_transform(instance, get_global_transform());
 		}
 	}
 }
 
 void VisualInstance3D::fti_update_servers_xform() {
 	if (!_is_using_identity_transform()) {
-		RS::get_singleton()->instance_set_transform(get_instance(), _get_cached_global_transform_interpolated());
+		get_tree()->submit_instance_transform(get_instance(), _get_cached_global_transform_interpolated());
 	}
 }
 
@@ -89,9 +90,10 @@ void VisualInstance3D::_notification(int p_what) {
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			// ToDo : Can we turn off notify transform for physics interpolated cases?
-			if (_is_vi_visible() && !(is_inside_tree() && get_tree()->is_physics_interpolation_enabled()) && !_is_using_identity_transform()) {
+			// With batched transform updates, the transform was already sent before the notification.
+			if (_is_vi_visible() && !(is_inside_tree() && (get_tree()->is_physics_interpolation_enabled() || get_tree()->get_transform_hierarchy().is_enabled())) && !_is_using_identity_transform()) {
 				// Physics interpolation global off, always send.
-				RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+				get_tree()->submit_instance_transform(instance, get_global_transform());
 			}
 		} break;
 
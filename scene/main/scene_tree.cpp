@@ -192,6 +192,11 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+	_begin_instance_transform_batch();
+
+	// Update all dirty global transforms at once, so the notifications find them ready.
+	transform_hierarchy.update(get_root(), !is_physics_interpolation_enabled());
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -200,6 +205,34 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	_end_instance_transform_batch();
+}
+
+void SceneTree::_begin_instance_transform_batch() {
+	instance_transform_batch.depth++;
+}
+
+void SceneTree::_end_instance_transform_batch() {
+	ERR_FAIL_COND(instance_transform_batch.depth <= 0);
+	if (--instance_transform_batch.depth > 0 || instance_transform_batch.instances.is_empty()) {
+		return;
+	}
+
+	RS::get_singleton()->instances_set_transforms(instance_transform_batch.instances, instance_transform_batch.transforms);
+	instance_transform_batch.instances.clear();
+	instance_transform_batch.transforms.clear();
+}
+
+void SceneTree::submit_instance_transform(RID p_instance, const Transform3D &p_transform) {
+	// Notifications from threaded process groups are not covered by the batch.
+	if (instance_transform_batch.depth == 0 || !Thread::is_main_thread()) {
+		RS::get_singleton()->instance_set_transform(p_instance, p_transform);
+		return;
+	}
+
+	instance_transform_batch.instances.push_back(p_instance);
+	instance_transform_batch.transforms.push_back(p_transform);
 }
 
 bool SceneTree::is_accessibility_enabled() const {
@@ -672,7 +705,9 @@ bool SceneTree::process(double p_time) {
 		// If this is not done, we can end up with a deferred `set_transform()`
 		// overwriting the interpolated xform in the server.
 		flush_transform_notifications();
+		_begin_instance_transform_batch();
 		get_scene_tree_fti().frame_update(get_root(), true);
+		_end_instance_transform_batch();
 	}
 
 	if (MainLoop::process(p_time)) {
@@ -759,7 +794,9 @@ bool SceneTree::process(double p_time) {
 	// Second pass of scene tree fixed timestep interpolation.
 	// ToDo: Possibly needs another flush_transform_notifications here
 	// depending on whether there are side effects to _call_idle_callbacks().
+	_begin_instance_transform_batch();
 	get_scene_tree_fti().frame_update(get_root(), false);
+	_end_instance_transform_batch();
 
 	if (_physics_interpolation_enabled) {
 		RenderingServer::get_singleton()->pre_draw(true);
@@ -2042,6 +2079,10 @@ SceneTree::SceneTree() {
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
 
+#ifndef _3D_DISABLED
+	transform_hierarchy.set_enabled(GLOBAL_DEF("rendering/3d/batched_transform_updates", false) && !Engine::get_singleton()->is_editor_hint());
+#endif // _3D_DISABLED
+
 	// Always disable jitter fix if physics interpolation is enabled -
 	// Jitter fix will interfere with interpolation, and is not necessary
 	// when interpolation is active.
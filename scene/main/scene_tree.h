@@ -35,6 +35,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/self_list.h"
 #include "scene/main/scene_tree_fti.h"
+#include "scene/main/scene_tree_transform_hierarchy.h"
 #include "scene/resources/mesh.h"
 
 #undef Window
@@ -155,6 +156,18 @@ private:
 	static bool _physics_interpolation_enabled_in_project;
 
 	SceneTreeFTI scene_tree_fti;
+	SceneTreeTransformHierarchy transform_hierarchy;
+
+	// Instance transforms sent while a batch is open are collected and
+	// submitted to the RenderingServer as a single command.
+	struct InstanceTransformBatch {
+		int depth = 0;
+		Vector<RID> instances;
+		Vector<Transform3D> transforms;
+	} instance_transform_batch;
+
+	void _begin_instance_transform_batch();
+	void _end_instance_transform_batch();
 
 	StringName tree_changed_name = "tree_changed";
 	StringName node_added_name = "node_added";
@@ -330,6 +343,9 @@ public:
 	}
 
 	void flush_transform_notifications();
+	// Sets the transform of a RenderingServer instance, batched if a batch is open. Any instance whose
+	// transform may be batched must always go through here, so the last transform set is the one that sticks.
+	void submit_instance_transform(RID p_instance, const Transform3D &p_transform);
 
 	bool is_accessibility_enabled() const;
 	bool is_accessibility_supported() const;
@@ -465,6 +481,7 @@ public:
 #endif
 
 	SceneTreeFTI &get_scene_tree_fti() { return scene_tree_fti; }
+	SceneTreeTransformHierarchy &get_transform_hierarchy() { return transform_hierarchy; }
 
 	SceneTree();
 	~SceneTree();
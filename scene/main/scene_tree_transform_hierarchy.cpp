@@ -0,0 +1,310 @@
+/**************************************************************************/
+/*  scene_tree_transform_hierarchy.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef _3D_DISABLED
+
+#include "scene_tree_transform_hierarchy.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/3d/visual_instance_3d.h"
+#include "servers/rendering_server.h"
+
+void SceneTreeTransformHierarchy::_node_3d_notify_changed(Node3D &r_node) {
+	if (r_node.data.transform_hierarchy_dirty_index == UINT32_MAX) {
+		r_node.data.transform_hierarchy_dirty_index = data.dirty_nodes.size();
+		data.dirty_nodes.push_back(&r_node);
+	}
+}
+
+void SceneTreeTransformHierarchy::node_3d_notify_delete(Node3D *p_node) {
+	if (!data.enabled) {
+		return; // Nothing is tracked, set_enabled() resets the nodes.
+	}
+
+	MutexLock lock(data.mutex);
+	data.structure_dirty = true;
+	p_node->data.transform_hierarchy_index = UINT32_MAX;
+
+	uint32_t dirty_index = p_node->data.transform_hierarchy_dirty_index;
+	if (dirty_index != UINT32_MAX) {
+		DEV_ASSERT(data.dirty_nodes[dirty_index] == p_node);
+		Node3D *last = data.dirty_nodes[data.dirty_nodes.size() - 1];
+		data.dirty_nodes[dirty_index] = last;
+		last->data.transform_hierarchy_dirty_index = dirty_index;
+		data.dirty_nodes.resize(data.dirty_nodes.size() - 1);
+		p_node->data.transform_hierarchy_dirty_index = UINT32_MAX;
+	}
+}
+
+void SceneTreeTransformHierarchy::_rebuild(Node *p_root) {
+	data.nodes.clear();
+	data.parents.clear();
+	data.instances.clear();
+
+	// Both traversals use explicit stacks, as hierarchies can be very deep.
+	LocalVector<Node *> node_stack;
+	LocalVector<Node3D *> node_3d_stack;
+	LocalVector<uint32_t> parent_stack;
+
+	node_stack.push_back(p_root);
+	while (!node_stack.is_empty()) {
+		Node *node = node_stack[node_stack.size() - 1];
+		node_stack.remove_at(node_stack.size() - 1);
+
+		for (int i = node->get_child_count(true) - 1; i >= 0; i--) {
+			node_stack.push_back(node->get_child(i, true));
+		}
+
+		Node3D *root = Object::cast_to<Node3D>(node);
+		if (!root || root->data.parent) {
+			continue;
+		}
+
+		// Only Node3Ds without a Node3D parent start a hierarchy.
+		node_3d_stack.push_back(root);
+		parent_stack.push_back(NO_PARENT);
+		while (!node_3d_stack.is_empty()) {
+			Node3D *node_3d = node_3d_stack[node_3d_stack.size() - 1];
+			uint32_t parent = parent_stack[parent_stack.size() - 1];
+			node_3d_stack.remove_at(node_3d_stack.size() - 1);
+			parent_stack.remove_at(parent_stack.size() - 1);
+
+			uint32_t index = data.nodes.size();
+			node_3d->data.transform_hierarchy_index = index;
+			data.nodes.push_back(node_3d);
+			data.parents.push_back(parent);
+
+			VisualInstance3D *vi = Object::cast_to<VisualInstance3D>(node_3d);
+			data.instances.push_back(vi ? vi->get_instance() : RID());
+
+			// Pushed in reverse, so children keep their order.
+			for (List<Node3D *>::Element *E = node_3d->data.children.back(); E; E = E->prev()) {
+				node_3d_stack.push_back(E->get());
+				parent_stack.push_back(index);
+			}
+		}
+	}
+
+	uint32_t count = data.nodes.size();
+	data.subtree_ends.resize(count);
+	data.local_transforms.resize(count);
+	data.global_transforms.resize(count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		data.subtree_ends[i] = i + 1;
+	}
+	// Children come after their parents, so a backwards pass sees every subtree complete.
+	for (uint32_t i = count; i-- > 0;) {
+		uint32_t parent = data.parents[i];
+		if (parent != NO_PARENT) {
+			data.subtree_ends[parent] = MAX(data.subtree_ends[parent], data.subtree_ends[i]);
+		}
+	}
+}
+
+void SceneTreeTransformHierarchy::_update_node(uint32_t p_index) {
+	Node3D *node = data.nodes[p_index];
+
+	// Same as Node3D::get_global_transform(), but without the thread guards, as this runs on the pool.
+	if (node->_test_dirty_bits(Node3D::DIRTY_LOCAL_TRANSFORM)) {
+		node->_update_local_transform();
+	}
+	const Transform3D &local = node->data.local_transform;
+	data.local_transforms[p_index] = local;
+
+	uint32_t parent = data.parents[p_index];
+	Transform3D global;
+	if (parent != NO_PARENT && !node->data.top_level) {
+		global = data.global_transforms[parent] * local;
+	} else {
+		global = local;
+	}
+
+	if (node->data.disable_scale) {
+		global.basis.orthonormalize();
+	}
+
+	data.global_transforms[p_index] = global;
+	node->data.global_transform = global;
+	node->_clear_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM);
+}
+
+void SceneTreeTransformHierarchy::_update_ranges(uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const Range &range = data.ranges[i];
+		for (uint32_t j = range.begin; j < range.end; j++) {
+			_update_node(j);
+		}
+	}
+}
+
+void SceneTreeTransformHierarchy::_add_range(uint32_t p_begin, uint32_t p_end) {
+	// Any contiguous range is valid, as parents precede their children, so merge small neighbours.
+	if (!data.ranges.is_empty()) {
+		Range &last = data.ranges[data.ranges.size() - 1];
+		if (last.end == p_begin && p_end - last.begin <= RANGE_MIN_NODES) {
+			last.end = p_end;
+			return;
+		}
+	}
+
+	Range range;
+	range.begin = p_begin;
+	range.end = p_end;
+	data.ranges.push_back(range);
+}
+
+void SceneTreeTransformHierarchy::update(Node *p_root, bool p_update_servers) {
+	if (!data.enabled) {
+		return;
+	}
+
+	{
+		MutexLock lock(data.mutex);
+
+		if (data.dirty_nodes.is_empty()) {
+			return;
+		}
+
+		if (data.structure_dirty) {
+			_rebuild(p_root);
+			data.structure_dirty = false;
+		}
+
+		data.dirty_indices.clear();
+		for (Node3D *node : data.dirty_nodes) {
+			node->data.transform_hierarchy_dirty_index = UINT32_MAX;
+			uint32_t index = node->data.transform_hierarchy_index;
+			if (index < data.nodes.size() && data.nodes[index] == node) {
+				data.dirty_indices.push_back(index);
+			}
+		}
+		data.dirty_nodes.clear();
+	}
+
+	data.dirty_indices.sort();
+	data.ranges.clear();
+
+	uint32_t covered_end = 0;
+	for (uint32_t index : data.dirty_indices) {
+		if (index < covered_end) {
+			continue; // Already part of a dirty subtree.
+		}
+		covered_end = data.subtree_ends[index];
+
+		// Nothing above a dirty subtree root has changed, so the node itself is authoritative for its parent.
+		uint32_t parent = data.parents[index];
+		if (parent != NO_PARENT) {
+			data.global_transforms[parent] = data.nodes[parent]->get_global_transform();
+		}
+
+		// Large subtrees are split below their root, so wide hierarchies spread over the pool.
+		// The roots of split subtrees are updated here, before their children are.
+		data.split_stack.push_back(index);
+		while (!data.split_stack.is_empty()) {
+			uint32_t node = data.split_stack[data.split_stack.size() - 1];
+			data.split_stack.remove_at(data.split_stack.size() - 1);
+
+			uint32_t end = data.subtree_ends[node];
+			if (end - node <= RANGE_MIN_NODES) {
+				_add_range(node, end);
+				continue;
+			}
+
+			_update_node(node);
+
+			uint32_t first_child = data.split_stack.size();
+			for (uint32_t child = node + 1; child < end; child = data.subtree_ends[child]) {
+				data.split_stack.push_back(child);
+			}
+			// Reverse them so they are popped in order, which lets neighbouring small subtrees merge.
+			for (uint32_t a = first_child, b = data.split_stack.size() - 1; a < b; a++, b--) {
+				SWAP(data.split_stack[a], data.split_stack[b]);
+			}
+		}
+	}
+
+	WorkerThreadPool::get_singleton()->parallel_for(0, data.ranges.size(), 1, [this](uint32_t p_from, uint32_t p_to) {
+		_update_ranges(p_from, p_to);
+	});
+
+	if (!p_update_servers) {
+		return;
+	}
+
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	covered_end = 0;
+	for (uint32_t index : data.dirty_indices) {
+		if (index < covered_end) {
+			continue;
+		}
+		covered_end = data.subtree_ends[index];
+
+		for (uint32_t i = index; i < covered_end; i++) {
+			if (data.instances[i].is_null()) {
+				continue;
+			}
+			// Same conditions VisualInstance3D uses when it gets NOTIFICATION_TRANSFORM_CHANGED.
+			const Node3D *node = data.nodes[i];
+			if (node->data.vi_visible && !node->_is_using_identity_transform()) {
+				instances.push_back(data.instances[i]);
+				transforms.push_back(data.global_transforms[i]);
+			}
+		}
+	}
+
+	if (!instances.is_empty()) {
+		RenderingServer::get_singleton()->instances_set_transforms(instances, transforms);
+	}
+}
+
+void SceneTreeTransformHierarchy::set_enabled(bool p_enabled) {
+	if (data.enabled == p_enabled) {
+		return;
+	}
+
+	MutexLock lock(data.mutex);
+	data.enabled = p_enabled;
+	data.structure_dirty = true;
+
+	for (Node3D *node : data.dirty_nodes) {
+		node->data.transform_hierarchy_dirty_index = UINT32_MAX;
+	}
+	data.dirty_nodes.clear();
+	data.nodes.clear();
+	data.parents.clear();
+	data.subtree_ends.clear();
+	data.instances.clear();
+	data.local_transforms.clear();
+	data.global_transforms.clear();
+}
+
+#endif // ndef _3D_DISABLED
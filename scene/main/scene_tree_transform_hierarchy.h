@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  scene_tree_transform_hierarchy.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/transform_3d.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid.h"
+
+class Node3D;
+class Node;
+
+#ifdef _3D_DISABLED
+// Stubs
+class SceneTreeTransformHierarchy {
+public:
+	void update(Node *p_root, bool p_update_servers) {}
+	void set_enabled(bool p_enabled) {}
+	bool is_enabled() const { return false; }
+
+	void node_3d_notify_changed(Node3D &r_node) {}
+	void node_3d_notify_tree_changed() {}
+	void node_3d_notify_delete(Node3D *p_node) {}
+};
+#else
+
+// Optional batched replacement for the lazy, per node, global transform update of Node3Ds.
+//
+// The Node3Ds of the tree are flattened in depth-first order into structure-of-arrays storage,
+// so every subtree is a contiguous range and parents always come before their children.
+// Nodes whose transform was set are collected as they change. Before transform notifications
+// are sent, the dirty subtrees are recomputed in one pass, split into independent ranges that
+// run on the WorkerThreadPool, and the results are written back to the nodes and sent to the
+// RenderingServer. Visual instances then don't need to update anything on the notification.
+//
+// The flattened order is rebuilt lazily after nodes enter or exit the tree, which is O(n),
+// so this is meant for large hierarchies whose structure changes less often than their transforms.
+
+// Like SceneTreeFTI, this keeps raw pointers to nodes, so it must be notified on deletion.
+
+class SceneTreeTransformHierarchy {
+	static const uint32_t NO_PARENT = UINT32_MAX;
+
+	// Subtrees smaller than this are not split further, and neighbouring ones are merged up to it.
+	static const uint32_t RANGE_MIN_NODES = 256;
+
+	struct Range {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	struct Data {
+		// Depth-first order.
+		LocalVector<Node3D *> nodes;
+		LocalVector<uint32_t> parents;
+		LocalVector<uint32_t> subtree_ends;
+		LocalVector<RID> instances;
+		LocalVector<Transform3D> local_transforms;
+		LocalVector<Transform3D> global_transforms;
+
+		// Nodes whose own transform changed since the last update.
+		// Each one stores its position here, so it can be removed in constant time when deleted.
+		LocalVector<Node3D *> dirty_nodes;
+
+		// Scratch.
+		LocalVector<uint32_t> dirty_indices;
+		LocalVector<uint32_t> split_stack;
+		LocalVector<Range> ranges;
+
+		bool enabled = false;
+		bool structure_dirty = true;
+
+		Mutex mutex;
+	} data;
+
+	void _node_3d_notify_changed(Node3D &r_node);
+	void _rebuild(Node *p_root);
+	void _update_node(uint32_t p_index);
+	void _update_ranges(uint32_t p_from, uint32_t p_to);
+	void _add_range(uint32_t p_begin, uint32_t p_end);
+
+public:
+	void node_3d_notify_changed(Node3D &r_node) {
+		if (!data.enabled) {
+			return;
+		}
+		MutexLock lock(data.mutex);
+		_node_3d_notify_changed(r_node);
+	}
+
+	void node_3d_notify_tree_changed() {
+		if (!data.enabled) {
+			return;
+		}
+		MutexLock lock(data.mutex);
+		data.structure_dirty = true;
+	}
+
+	void node_3d_notify_delete(Node3D *p_node);
+
+	// Recomputes the global transforms of the dirty subtrees, and sends them to the RenderingServer
+	// if p_update_servers is set. Must be called from the main thread.
+	void update(Node *p_root, bool p_update_servers);
+
+	void set_enabled(bool p_enabled);
+	bool is_enabled() const { return data.enabled; }
+
+	uint32_t get_node_count() const { return data.nodes.size(); }
+};
+
+#endif // ndef _3D_DISABLED
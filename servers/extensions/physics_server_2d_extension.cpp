@@ -30,6 +30,8 @@
 
 #include "physics_server_2d_extension.h"
 
+#include "core/object/frame_task_graph.h"
+
 bool PhysicsDirectSpaceState2DExtension::is_body_excluded_from_query(const RID &p_body) const {
 	return exclude && exclude->has(p_body);
 }
@@ -344,6 +346,11 @@ void PhysicsServer2DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_get_process_info, "process_info");
 }
 
+void PhysicsServer2DExtension::add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) {
+	// Extensions don't tell whether they can step outside the main thread.
+	r_graph.add_stage(SNAME("Physics 2D step"), callable_mp(this, &PhysicsServer2DExtension::step).bind(p_step), {}, { SNAME("physics_2d") }, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD);
+}
+
 PhysicsServer2DExtension::PhysicsServer2DExtension() {
 }
 
@@ -30,6 +30,8 @@
 
 #include "physics_server_3d_extension.h"
 
+#include "core/object/frame_task_graph.h"
+
 bool PhysicsDirectSpaceState3DExtension::is_body_excluded_from_query(const RID &p_body) const {
 	return exclude && exclude->has(p_body);
 }
@@ -432,6 +434,11 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_get_process_info, "process_info");
 }
 
+void PhysicsServer3DExtension::add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) {
+	// Extensions don't tell whether they can step outside the main thread.
+	r_graph.add_stage(SNAME("Physics 3D step"), callable_mp(this, &PhysicsServer3DExtension::step).bind(p_step), {}, { SNAME("physics_3d") }, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD);
+}
+
 PhysicsServer3DExtension::PhysicsServer3DExtension() {
 }
 
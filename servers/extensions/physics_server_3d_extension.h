@@ -543,6 +543,8 @@ public:
 	EXBIND0RC(bool, is_flushing_queries)
 	EXBIND1R(int, get_process_info, ProcessInfo)
 
+	virtual void add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) override;
+
 	PhysicsServer3DExtension();
 	~PhysicsServer3DExtension();
 };
@@ -0,0 +1,277 @@
+/**************************************************************************/
+/*  nav_flow_field.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "servers/navigation/nav_heap.h"
+
+/**
+ * Reverse search from a destination shared by several path queries.
+ * The search follows the connections backwards, so each polygon ends up
+ * with the cheapest way towards the destination.
+ */
+template <typename TPolygon, typename TConnection, typename TVector>
+class NavFlowField {
+public:
+	struct Poly {
+		const TPolygon *poly = nullptr;
+
+		/// Index in the heap of open polygons.
+		uint32_t open_poly_index = UINT32_MAX;
+
+		/// Next polygon towards the destination, -1 for the destination polygon.
+		int next_poly_id = -1;
+		/// Connection from this polygon to the next one.
+		const TConnection *next_connection = nullptr;
+
+		/// The point where the path leaves this polygon.
+		TVector exit;
+		/// The travel cost from the exit to the destination.
+		real_t distance_to_destination = FLT_MAX;
+
+		void reset() {
+			poly = nullptr;
+			open_poly_index = UINT32_MAX;
+			next_poly_id = -1;
+			next_connection = nullptr;
+			distance_to_destination = FLT_MAX;
+		}
+	};
+
+	struct PolyCostGreaterThan {
+		bool operator()(const Poly *p_poly_a, const Poly *p_poly_b) const {
+			return p_poly_a->distance_to_destination > p_poly_b->distance_to_destination;
+		}
+	};
+
+	struct PolyHeapIndexer {
+		void operator()(Poly *p_poly, uint32_t p_heap_index) const {
+			p_poly->open_poly_index = p_heap_index;
+		}
+	};
+
+	typedef Heap<Poly *, PolyCostGreaterThan, PolyHeapIndexer> OpenPolys;
+
+	/// Connection seen from the polygon it leads to.
+	struct ReverseConnection {
+		/// Polygon the connection starts from, and its id in the path query slots.
+		const TPolygon *polygon = nullptr;
+		uint32_t polygon_id = 0;
+
+		const TConnection *connection = nullptr;
+	};
+
+	/// Connections of a map iteration grouped by the polygon they lead to, built on first use.
+	class ReverseConnections {
+		LocalVector<uint32_t> offsets;
+		LocalVector<ReverseConnection> connections;
+		bool built = false;
+		Mutex mutex;
+
+	public:
+		template <typename TMapIteration, typename TPolyToId>
+		void build(const TMapIteration &p_map_iteration, const TPolyToId &p_poly_to_id) {
+			MutexLock lock(mutex);
+			if (built) {
+				return;
+			}
+
+			// Gather all connections with their source polygon, then bucket them by the polygon they lead to.
+			LocalVector<ReverseConnection> unsorted_connections;
+			uint32_t polygon_id = 0;
+
+			auto gather_connections = [&](const TPolygon &p_polygon, const LocalVector<TConnection> &p_connections) {
+				for (const TConnection &connection : p_connections) {
+					ReverseConnection reverse_connection;
+					reverse_connection.polygon = &p_polygon;
+					reverse_connection.polygon_id = polygon_id;
+					reverse_connection.connection = &connection;
+					unsorted_connections.push_back(reverse_connection);
+				}
+			};
+
+			for (const auto &region : p_map_iteration.region_iterations) {
+				const LocalVector<LocalVector<TConnection>> &internal_connections = region->get_internal_connections();
+				const LocalVector<LocalVector<TConnection>> *external_connections = p_map_iteration.navbases_polygons_external_connections.getptr(region.ptr());
+
+				for (const TPolygon &polygon : region->get_navmesh_polygons()) {
+					if (polygon.id < internal_connections.size()) {
+						gather_connections(polygon, internal_connections[polygon.id]);
+					}
+					if (external_connections && polygon.id < external_connections->size()) {
+						gather_connections(polygon, (*external_connections)[polygon.id]);
+					}
+					polygon_id++;
+				}
+			}
+
+			for (const TPolygon &link_polygon : p_map_iteration.navlink_polygons) {
+				const LocalVector<LocalVector<TConnection>> *external_connections = p_map_iteration.navbases_polygons_external_connections.getptr(link_polygon.owner);
+				if (external_connections) {
+					for (const LocalVector<TConnection> &link_connections : *external_connections) {
+						gather_connections(link_polygon, link_connections);
+					}
+				}
+				polygon_id++;
+			}
+
+			offsets.resize_initialized(polygon_id + 1);
+
+			LocalVector<uint32_t> target_ids;
+			target_ids.resize(unsorted_connections.size());
+			for (uint32_t i = 0; i < unsorted_connections.size(); i++) {
+				target_ids[i] = p_poly_to_id[unsorted_connections[i].connection->polygon];
+				offsets[target_ids[i] + 1] += 1;
+			}
+			for (uint32_t i = 1; i < offsets.size(); i++) {
+				offsets[i] += offsets[i - 1];
+			}
+
+			LocalVector<uint32_t> bucket_fill;
+			bucket_fill.resize(polygon_id);
+			for (uint32_t i = 0; i < polygon_id; i++) {
+				bucket_fill[i] = offsets[i];
+			}
+
+			connections.resize(unsorted_connections.size());
+			for (uint32_t i = 0; i < unsorted_connections.size(); i++) {
+				connections[bucket_fill[target_ids[i]]++] = unsorted_connections[i];
+			}
+
+			built = true;
+		}
+
+		void clear() {
+			MutexLock lock(mutex);
+			built = false;
+			offsets.clear();
+			connections.clear();
+		}
+
+		// Only valid once built, the connections don't change afterwards.
+		const ReverseConnection *get_connections(uint32_t p_polygon_id, uint32_t &r_count) const {
+			r_count = offsets[p_polygon_id + 1] - offsets[p_polygon_id];
+			return connections.ptr() + offsets[p_polygon_id];
+		}
+	};
+
+	// This is Dijkstra's algorithm, following the connections backwards from the destination.
+	// The search stops once every polygon of `r_pending_poly_ids` has its final cost.
+	template <typename TGeometry, typename TIsUsable>
+	static void search(LocalVector<Poly> &r_polys, OpenPolys &r_open_polys, const ReverseConnections &p_reverse_connections, const TPolygon *p_end_polygon, uint32_t p_end_poly_id, const TVector &p_end_position, HashSet<uint32_t> &r_pending_poly_ids, const TIsUsable &p_is_usable) {
+		for (Poly &poly : r_polys) {
+			poly.reset();
+		}
+		r_open_polys.clear();
+
+		Poly &end_poly = r_polys[p_end_poly_id];
+		end_poly.poly = p_end_polygon;
+		end_poly.exit = p_end_position;
+		end_poly.distance_to_destination = 0.0;
+		r_open_polys.push(&end_poly);
+
+		while (!r_open_polys.is_empty() && !r_pending_poly_ids.is_empty()) {
+			const Poly *least_cost_poly = r_open_polys.pop();
+			const uint32_t least_cost_id = least_cost_poly - r_polys.ptr();
+			r_pending_poly_ids.erase(least_cost_id);
+
+			// The polygon is entered by every path through it, so it needs to be usable.
+			const auto *least_cost_owner = least_cost_poly->poly->owner;
+			if (!p_is_usable(least_cost_owner)) {
+				continue;
+			}
+
+			uint32_t reverse_connection_count = 0;
+			const ReverseConnection *reverse_connections = p_reverse_connections.get_connections(least_cost_id, reverse_connection_count);
+			for (uint32_t i = 0; i < reverse_connection_count; i++) {
+				const ReverseConnection &reverse_connection = reverse_connections[i];
+				const TConnection *connection = reverse_connection.connection;
+
+				const TVector new_exit = TGeometry::get_closest_point_to_segment(least_cost_poly->exit, connection->pathway_start, connection->pathway_end);
+				real_t new_distance = least_cost_poly->distance_to_destination + new_exit.distance_to(least_cost_poly->exit) * least_cost_owner->get_travel_cost();
+				if (reverse_connection.polygon->owner != least_cost_owner) {
+					new_distance += least_cost_owner->get_enter_cost();
+				}
+
+				Poly &poly = r_polys[reverse_connection.polygon_id];
+				if (new_distance < poly.distance_to_destination) {
+					poly.poly = reverse_connection.polygon;
+					poly.next_poly_id = least_cost_id;
+					poly.next_connection = connection;
+					poly.exit = new_exit;
+					poly.distance_to_destination = new_distance;
+
+					if (poly.open_poly_index != r_open_polys.INVALID_INDEX) {
+						r_open_polys.shift(poly.open_poly_index);
+					} else {
+						r_open_polys.push(&poly);
+					}
+				}
+			}
+		}
+
+		r_open_polys.clear();
+	}
+
+	// Lays out the same back links as the A* search so the post-processing can follow them.
+	// Returns the id of the end polygon.
+	template <typename TNavigationPoly>
+	static uint32_t build_path_corridor(const LocalVector<Poly> &p_polys, LocalVector<TNavigationPoly> &r_navigation_polys, const TPolygon *p_begin_polygon, uint32_t p_begin_poly_id, const TVector &p_begin_position) {
+		uint32_t poly_id = p_begin_poly_id;
+		TNavigationPoly &begin_navigation_poly = r_navigation_polys[poly_id];
+		begin_navigation_poly.reset();
+		begin_navigation_poly.poly = p_begin_polygon;
+		begin_navigation_poly.entry = p_begin_position;
+		begin_navigation_poly.back_navigation_edge_pathway_start = p_begin_position;
+		begin_navigation_poly.back_navigation_edge_pathway_end = p_begin_position;
+		begin_navigation_poly.traveled_distance = 0.0;
+
+		while (p_polys[poly_id].next_poly_id != -1) {
+			const Poly &poly = p_polys[poly_id];
+			const uint32_t next_poly_id = poly.next_poly_id;
+
+			TNavigationPoly &next_navigation_poly = r_navigation_polys[next_poly_id];
+			next_navigation_poly.reset();
+			next_navigation_poly.poly = p_polys[next_poly_id].poly;
+			next_navigation_poly.back_navigation_poly_id = poly_id;
+			next_navigation_poly.back_navigation_edge = poly.next_connection->edge;
+			next_navigation_poly.back_navigation_edge_pathway_start = poly.next_connection->pathway_start;
+			next_navigation_poly.back_navigation_edge_pathway_end = poly.next_connection->pathway_end;
+			next_navigation_poly.entry = poly.exit;
+
+			poly_id = next_poly_id;
+		}
+
+		return poly_id;
+	}
+};
@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  nav_path_cache.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/lru.h"
+#include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
+
+struct NavPathCacheKey {
+	uint32_t begin_polygon_id = 0;
+	uint32_t end_polygon_id = 0;
+	uint32_t navigation_layers = 0;
+	int path_search_max_polygons = 0;
+	LocalVector<RID> excluded_regions;
+	LocalVector<RID> included_regions;
+
+	static bool regions_equal(const LocalVector<RID> &p_regions_a, const LocalVector<RID> &p_regions_b) {
+		if (p_regions_a.size() != p_regions_b.size()) {
+			return false;
+		}
+		for (uint32_t i = 0; i < p_regions_a.size(); i++) {
+			if (p_regions_a[i] != p_regions_b[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static uint32_t hash(const NavPathCacheKey &p_key) {
+		uint32_t h = hash_murmur3_one_32(p_key.begin_polygon_id);
+		h = hash_murmur3_one_32(p_key.end_polygon_id, h);
+		h = hash_murmur3_one_32(p_key.navigation_layers, h);
+		h = hash_murmur3_one_32(p_key.path_search_max_polygons, h);
+		for (const RID &region : p_key.excluded_regions) {
+			h = hash_murmur3_one_64(region.get_id(), h);
+		}
+		h = hash_murmur3_one_32(p_key.excluded_regions.size(), h);
+		for (const RID &region : p_key.included_regions) {
+			h = hash_murmur3_one_64(region.get_id(), h);
+		}
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const NavPathCacheKey &p_key) const {
+		return begin_polygon_id == p_key.begin_polygon_id &&
+				end_polygon_id == p_key.end_polygon_id &&
+				navigation_layers == p_key.navigation_layers &&
+				path_search_max_polygons == p_key.path_search_max_polygons &&
+				regions_equal(excluded_regions, p_key.excluded_regions) &&
+				regions_equal(included_regions, p_key.included_regions);
+	}
+};
+
+/**
+ * Polygon corridors found by earlier path queries of a map iteration.
+ * Only the polygons and the edges between them are kept, the entry points
+ * are found again from the start position of the query that reuses them.
+ * When full, the least recently used corridor is dropped.
+ */
+template <typename TPolygon, typename TVector>
+class NavPathCache {
+	struct CorridorPoly {
+		const TPolygon *poly = nullptr;
+		uint32_t poly_id = 0;
+		int back_navigation_edge = -1;
+		TVector back_navigation_edge_pathway_start;
+		TVector back_navigation_edge_pathway_end;
+	};
+
+	LRUCache<NavPathCacheKey, LocalVector<CorridorPoly>, NavPathCacheKey> corridors;
+	SafeNumeric<uint32_t> size;
+	Mutex mutex;
+
+public:
+	void set_size(uint32_t p_size) {
+		MutexLock lock(mutex);
+		size.set(p_size);
+		if (p_size == 0) {
+			corridors.clear();
+		} else {
+			corridors.set_capacity(p_size);
+		}
+	}
+
+	uint32_t get_size() const {
+		return size.get();
+	}
+
+	void clear() {
+		MutexLock lock(mutex);
+		corridors.clear();
+	}
+
+	// Lays out the back links of the corridor in `r_navigation_polys`, like the A* search does.
+	// Returns the id of the end polygon, or -1 without a cached corridor.
+	template <typename TGeometry, typename TNavigationPoly>
+	int load(const NavPathCacheKey &p_key, const TVector &p_begin_position, LocalVector<TNavigationPoly> &r_navigation_polys) {
+		if (size.get() == 0) {
+			return -1;
+		}
+
+		MutexLock lock(mutex);
+
+		const LocalVector<CorridorPoly> *corridor = corridors.getptr(p_key);
+		if (!corridor) {
+			return -1;
+		}
+
+		int back_navigation_poly_id = -1;
+		TVector entry = p_begin_position;
+		for (const CorridorPoly &corridor_poly : *corridor) {
+			TNavigationPoly &navigation_poly = r_navigation_polys[corridor_poly.poly_id];
+			navigation_poly.reset();
+			navigation_poly.poly = corridor_poly.poly;
+			navigation_poly.back_navigation_poly_id = back_navigation_poly_id;
+			navigation_poly.back_navigation_edge = corridor_poly.back_navigation_edge;
+			if (back_navigation_poly_id == -1) {
+				// The begin polygon, entered at the start position.
+				navigation_poly.back_navigation_edge_pathway_start = p_begin_position;
+				navigation_poly.back_navigation_edge_pathway_end = p_begin_position;
+			} else {
+				navigation_poly.back_navigation_edge_pathway_start = corridor_poly.back_navigation_edge_pathway_start;
+				navigation_poly.back_navigation_edge_pathway_end = corridor_poly.back_navigation_edge_pathway_end;
+				entry = TGeometry::get_closest_point_to_segment(entry, corridor_poly.back_navigation_edge_pathway_start, corridor_poly.back_navigation_edge_pathway_end);
+			}
+			navigation_poly.entry = entry;
+			back_navigation_poly_id = corridor_poly.poly_id;
+		}
+		return back_navigation_poly_id;
+	}
+
+	// Follows the back links from `p_end_poly_id` and keeps the corridor.
+	template <typename TNavigationPoly>
+	void store(const NavPathCacheKey &p_key, const LocalVector<TNavigationPoly> &p_navigation_polys, int p_end_poly_id) {
+		if (size.get() == 0) {
+			return;
+		}
+
+		LocalVector<CorridorPoly> corridor;
+		for (int poly_id = p_end_poly_id; poly_id != -1; poly_id = p_navigation_polys[poly_id].back_navigation_poly_id) {
+			const TNavigationPoly &navigation_poly = p_navigation_polys[poly_id];
+			CorridorPoly corridor_poly;
+			corridor_poly.poly = navigation_poly.poly;
+			corridor_poly.poly_id = poly_id;
+			corridor_poly.back_navigation_edge = navigation_poly.back_navigation_edge;
+			corridor_poly.back_navigation_edge_pathway_start = navigation_poly.back_navigation_edge_pathway_start;
+			corridor_poly.back_navigation_edge_pathway_end = navigation_poly.back_navigation_edge_pathway_end;
+			corridor.push_back(corridor_poly);
+		}
+		corridor.reverse();
+
+		MutexLock lock(mutex);
+		corridors.insert(p_key, corridor);
+	}
+};
@@ -32,6 +32,7 @@
 #include "navigation_server_2d.compat.inc"
 
 #include "core/config/project_settings.h"
+#include "core/object/frame_task_graph.h"
 #include "scene/main/node.h"
 #include "servers/navigation/navigation_globals.h"
 #include "servers/navigation_server_2d_dummy.h"
@@ -58,6 +59,12 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer2D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer2D::map_set_link_connection_radius);
 	ClassDB::bind_method(D_METHOD("map_get_link_connection_radius", "map"), &NavigationServer2D::map_get_link_connection_radius);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer2D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer2D::map_get_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_set_hierarchical_pathfinding_chunk_size", "map", "chunk_size"), &NavigationServer2D::map_set_hierarchical_pathfinding_chunk_size);
+	ClassDB::bind_method(D_METHOD("map_get_hierarchical_pathfinding_chunk_size", "map"), &NavigationServer2D::map_get_hierarchical_pathfinding_chunk_size);
+	ClassDB::bind_method(D_METHOD("map_set_path_cache_size", "map", "size"), &NavigationServer2D::map_set_path_cache_size);
+	ClassDB::bind_method(D_METHOD("map_get_path_cache_size", "map"), &NavigationServer2D::map_get_path_cache_size);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer2D::map_get_path, DEFVAL(1));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer2D::map_get_closest_point);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_owner", "map", "to_point"), &NavigationServer2D::map_get_closest_point_owner);
@@ -75,6 +82,7 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer2D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result", "callback"), &NavigationServer2D::query_path, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer2D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer2D::region_create);
 	ClassDB::bind_method(D_METHOD("region_get_iteration_id", "region"), &NavigationServer2D::region_get_iteration_id);
@@ -218,6 +226,11 @@ NavigationServer2D *NavigationServer2D::get_singleton() {
 	return singleton;
 }
 
+void NavigationServer2D::add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time) {
+	// Implementations may call user callbacks from physics_process(), so it can't overlap anything else.
+	r_graph.add_stage(SNAME("Navigation 2D physics process"), callable_mp(this, &NavigationServer2D::physics_process).bind(p_delta_time), {}, { SNAME("navigation_2d") }, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD | FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+}
+
 NavigationServer2D::NavigationServer2D() {
 	ERR_FAIL_COND(singleton != nullptr);
 	singleton = this;
@@ -227,6 +240,8 @@ NavigationServer2D::NavigationServer2D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/2d/merge_rasterizer_cell_scale", PROPERTY_HINT_RANGE, "0.001,1,0.001,or_greater"), 1.0);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::FLOAT, "navigation/2d/default_edge_connection_margin", PROPERTY_HINT_RANGE, "0.01,10,0.001,or_greater"), NavigationDefaults2D::EDGE_CONNECTION_MARGIN);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::FLOAT, "navigation/2d/default_link_connection_radius", PROPERTY_HINT_RANGE, "0.01,10,0.001,or_greater"), NavigationDefaults2D::LINK_CONNECTION_RADIUS);
+	GLOBAL_DEF("navigation/2d/use_hierarchical_pathfinding", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/2d/hierarchical_pathfinding_chunk_size", PROPERTY_HINT_RANGE, "1,10000,1,or_greater,suffix:px"), 512.0);
 
 #ifdef DEBUG_ENABLED
 	debug_navigation_edge_connection_color = GLOBAL_DEF("debug/shapes/navigation/2d/edge_connection_color", Color(1.0, 0.0, 1.0, 1.0));
@@ -42,6 +42,8 @@
 class NavMeshGenerator2D;
 #endif // CLIPPER2_ENABLED
 
+class FrameTaskGraph;
+
 struct NavMeshGeometryParser2D {
 	RID self;
 	Callable callback;
@@ -82,6 +84,15 @@ public:
 	virtual void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) = 0;
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	virtual void map_set_hierarchical_pathfinding_chunk_size(RID p_map, real_t p_chunk_size) = 0;
+	virtual real_t map_get_hierarchical_pathfinding_chunk_size(RID p_map) const = 0;
+
+	virtual void map_set_path_cache_size(RID p_map, int p_path_cache_size) = 0;
+	virtual int map_get_path_cache_size(RID p_map) const = 0;
+
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) = 0;
 
 	virtual Vector2 map_get_closest_point(RID p_map, const Vector2 &p_point) const = 0;
@@ -251,6 +262,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -275,6 +287,8 @@ public:
 	virtual void set_active(bool p_active) = 0;
 	virtual void process(double p_delta_time) = 0;
 	virtual void physics_process(double p_delta_time) = 0;
+	// Adds the stage(s) doing physics_process() to a frame graph. The default runs it as a single main thread stage.
+	virtual void add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time);
 	virtual void init() = 0;
 	virtual void sync() = 0;
 	virtual void finish() = 0;
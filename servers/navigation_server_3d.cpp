@@ -32,6 +32,7 @@
 #include "navigation_server_3d.compat.inc"
 
 #include "core/config/project_settings.h"
+#include "core/object/frame_task_graph.h"
 #include "scene/main/node.h"
 #include "servers/navigation/navigation_globals.h"
 #include "servers/navigation_server_3d_dummy.h"
@@ -62,6 +63,12 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer3D::map_set_link_connection_radius);
 	ClassDB::bind_method(D_METHOD("map_get_link_connection_radius", "map"), &NavigationServer3D::map_get_link_connection_radius);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer3D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer3D::map_get_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_set_hierarchical_pathfinding_chunk_size", "map", "chunk_size"), &NavigationServer3D::map_set_hierarchical_pathfinding_chunk_size);
+	ClassDB::bind_method(D_METHOD("map_get_hierarchical_pathfinding_chunk_size", "map"), &NavigationServer3D::map_get_hierarchical_pathfinding_chunk_size);
+	ClassDB::bind_method(D_METHOD("map_set_path_cache_size", "map", "size"), &NavigationServer3D::map_set_path_cache_size);
+	ClassDB::bind_method(D_METHOD("map_get_path_cache_size", "map"), &NavigationServer3D::map_get_path_cache_size);
 	ClassDB::bind_method(D_METHOD("map_get_path", "map", "origin", "destination", "optimize", "navigation_layers"), &NavigationServer3D::map_get_path, DEFVAL(1));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_to_segment", "map", "start", "end", "use_collision"), &NavigationServer3D::map_get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer3D::map_get_closest_point);
@@ -81,6 +88,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result", "callback"), &NavigationServer3D::query_path, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("query_paths", "parameters", "results"), &NavigationServer3D::query_paths);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_get_iteration_id", "region"), &NavigationServer3D::region_get_iteration_id);
@@ -240,6 +248,11 @@ NavigationServer3D *NavigationServer3D::get_singleton() {
 	return singleton;
 }
 
+void NavigationServer3D::add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time) {
+	// Implementations may call user callbacks from physics_process(), so it can't overlap anything else.
+	r_graph.add_stage(SNAME("Navigation 3D physics process"), callable_mp(this, &NavigationServer3D::physics_process).bind(p_delta_time), {}, { SNAME("navigation_3d") }, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD | FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+}
+
 NavigationServer3D::NavigationServer3D() {
 	ERR_FAIL_COND(singleton != nullptr);
 	singleton = this;
@@ -251,6 +264,8 @@ NavigationServer3D::NavigationServer3D() {
 	GLOBAL_DEF("navigation/3d/use_edge_connections", true);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::FLOAT, "navigation/3d/default_edge_connection_margin", PROPERTY_HINT_RANGE, "0.01,10,0.001,or_greater"), NavigationDefaults3D::EDGE_CONNECTION_MARGIN);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::FLOAT, "navigation/3d/default_link_connection_radius", PROPERTY_HINT_RANGE, "0.01,10,0.001,or_greater"), NavigationDefaults3D::LINK_CONNECTION_RADIUS);
+	GLOBAL_DEF("navigation/3d/use_hierarchical_pathfinding", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "navigation/3d/hierarchical_pathfinding_chunk_size", PROPERTY_HINT_RANGE, "1,1000,0.1,or_greater,suffix:m"), 32.0);
 
 #ifdef DEBUG_ENABLED
 #ifndef DISABLE_DEPRECATED
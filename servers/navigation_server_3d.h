@@ -38,6 +38,8 @@
 #include "servers/navigation/navigation_path_query_parameters_3d.h"
 #include "servers/navigation/navigation_path_query_result_3d.h"
 
+class FrameTaskGraph;
+
 struct NavMeshGeometryParser3D {
 	RID self;
 	Callable callback;
@@ -84,6 +86,15 @@ public:
 	virtual void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) = 0;
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	virtual void map_set_hierarchical_pathfinding_chunk_size(RID p_map, real_t p_chunk_size) = 0;
+	virtual real_t map_get_hierarchical_pathfinding_chunk_size(RID p_map) const = 0;
+
+	virtual void map_set_path_cache_size(RID p_map, int p_path_cache_size) = 0;
+	virtual int map_get_path_cache_size(RID p_map) const = 0;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) = 0;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
@@ -278,6 +289,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -305,6 +317,8 @@ public:
 	virtual void set_active(bool p_active) = 0;
 	virtual void process(double p_delta_time) = 0;
 	virtual void physics_process(double p_delta_time) = 0;
+	// Adds the stage(s) doing physics_process() to a frame graph. The default runs it as a single main thread stage.
+	virtual void add_physics_process_frame_stages(FrameTaskGraph &r_graph, double p_delta_time);
 	virtual void init() = 0;
 	virtual void sync() = 0;
 	virtual void finish() = 0;
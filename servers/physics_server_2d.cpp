@@ -31,6 +31,7 @@
 #include "physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/frame_task_graph.h"
 #include "core/variant/typed_array.h"
 
 PhysicsServer2D *PhysicsServer2D::singleton = nullptr;
@@ -448,6 +449,106 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The ray origin and end arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr(), hits.ptr());
+
+	PackedByteArray hit;
+	hit.resize(count);
+	PackedVector2Array position;
+	position.resize(count);
+	PackedVector2Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+
+	uint8_t *hit_ptr = hit.ptrw();
+	Vector2 *position_ptr = position.ptrw();
+	Vector2 *normal_ptr = normal.ptrw();
+	int64_t *collider_id_ptr = collider_id.ptrw();
+	int32_t *shape_ptr = shape.ptrw();
+	for (int i = 0; i < count; i++) {
+		hit_ptr[i] = hits[i];
+		if (hits[i]) {
+			position_ptr[i] = results[i].position;
+			normal_ptr[i] = results[i].normal;
+			collider_id_ptr[i] = int64_t(results[i].collider_id);
+			shape_ptr[i] = results[i].shape;
+		} else {
+			position_ptr[i] = Vector2();
+			normal_ptr[i] = Vector2();
+			collider_id_ptr[i] = 0;
+			shape_ptr[i] = 0;
+		}
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	return d;
+}
+
+Vector<real_t> PhysicsDirectSpaceState2D::_cast_motions_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The shape origin and motion arrays must have the same size.");
+
+	const int count = p_origins.size();
+	const Transform2D &transform = p_shape_query->get_parameters().transform;
+	LocalVector<Transform2D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms[i] = transform;
+		transforms[i].set_origin(p_origins[i]);
+	}
+
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(count);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+	cast_motions(p_shape_query->get_parameters(), transforms.ptr(), p_motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptr = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptr[i * 2 + 0] = closest_safe[i];
+		ret_ptr[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+void PhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
@@ -458,6 +559,8 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_rays_batch);
+	ClassDB::bind_method(D_METHOD("cast_motions_batch", "parameters", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motions_batch);
 }
 
 ///////////////////////////////
@@ -890,6 +993,12 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
 }
 
+void PhysicsServer2D::add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) {
+	// Stepping doesn't call user code, state callbacks are only sent from flush_queries(). So the step can run on
+	// a pool thread, next to the stages of other servers.
+	r_graph.add_stage(SNAME("Physics 2D step"), callable_mp(this, &PhysicsServer2D::step).bind(p_step), {}, { SNAME("physics_2d") });
+}
+
 PhysicsServer2D::PhysicsServer2D() {
 	singleton = this;
 
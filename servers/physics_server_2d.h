@@ -36,6 +36,7 @@
 
 constexpr int MAX_CONTACTS_REPORTED_2D_MAX = 4096;
 
+class FrameTaskGraph;
 class PhysicsDirectSpaceState2D;
 template <typename T>
 class TypedArray;
@@ -124,6 +125,8 @@ class PhysicsDirectSpaceState2D : public Object {
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Vector<real_t> _cast_motions_batch(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -199,6 +202,12 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
+	// Batched queries, sharing everything in the parameters except the per-query
+	// positions, which are taken from the arrays. Servers may spread them across
+	// threads; these defaults run them one by one.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState2D();
 };
 
@@ -600,6 +609,9 @@ public:
 	virtual void end_sync() = 0;
 	virtual void finish() = 0;
 
+	// Adds the stage(s) doing step() to a frame graph. The default steps on the main thread.
+	virtual void add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step);
+
 	virtual bool is_flushing_queries() const = 0;
 
 	enum ProcessInfo {
@@ -30,6 +30,8 @@
 
 #include "physics_server_2d_wrap_mt.h"
 
+#include "core/object/frame_task_graph.h"
+
 void PhysicsServer2DWrapMT::_assign_mt_ids(WorkerThreadPool::TaskID p_pump_task_id) {
 	server_thread = Thread::get_caller_id();
 	server_task_id = p_pump_task_id;
@@ -56,6 +58,17 @@ void PhysicsServer2DWrapMT::step(real_t p_step) {
 	}
 }
 
+void PhysicsServer2DWrapMT::add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) {
+	if (create_thread) {
+		// Only pushes the step to the server thread, which is safe from any thread.
+		PhysicsServer2D::add_step_frame_stages(r_graph, p_step);
+	} else {
+		// The wrapped server is already able to step outside the main thread (see create_thread), and nothing else
+		// calls into it directly while the graph runs, since other threads go through the command queue.
+		r_graph.add_stage(SNAME("Physics 2D step"), callable_mp(physics_server_2d, &PhysicsServer2D::step).bind(p_step), {}, { SNAME("physics_2d") });
+	}
+}
+
 void PhysicsServer2DWrapMT::sync() {
 	if (create_thread) {
 		command_queue.sync();
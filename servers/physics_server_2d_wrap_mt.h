@@ -68,6 +68,7 @@ public:
 #define ServerNameWrapMT PhysicsServer2DWrapMT
 #define server_name physics_server_2d
 #define WRITE_ACTION
+#define MEMORY_TAG_SCOPE Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
 
 #include "servers/server_wrap_mt_common.h"
 
@@ -311,6 +312,7 @@ public:
 	virtual void end_sync() override;
 	virtual void flush_queries() override;
 	virtual void finish() override;
+	virtual void add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) override;
 
 	virtual bool is_flushing_queries() const override {
 		return physics_server_2d->is_flushing_queries();
@@ -327,6 +329,7 @@ public:
 #undef ServerName
 #undef server_name
 #undef WRITE_ACTION
+#undef MEMORY_TAG_SCOPE
 };
 
 #ifdef DEBUG_SYNC
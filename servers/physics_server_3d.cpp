@@ -33,6 +33,7 @@
 #include "physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/frame_task_graph.h"
 #include "core/variant/typed_array.h"
 
 void PhysicsServer3DRenderingServerHandler::set_vertex(int p_vertex_id, const Vector3 &p_vertex) {
@@ -475,6 +476,111 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The ray origin and end arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr(), hits.ptr());
+
+	PackedByteArray hit;
+	hit.resize(count);
+	PackedVector3Array position;
+	position.resize(count);
+	PackedVector3Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+	PackedInt32Array face_index;
+	face_index.resize(count);
+
+	uint8_t *hit_ptr = hit.ptrw();
+	Vector3 *position_ptr = position.ptrw();
+	Vector3 *normal_ptr = normal.ptrw();
+	int64_t *collider_id_ptr = collider_id.ptrw();
+	int32_t *shape_ptr = shape.ptrw();
+	int32_t *face_index_ptr = face_index.ptrw();
+	for (int i = 0; i < count; i++) {
+		hit_ptr[i] = hits[i];
+		if (hits[i]) {
+			position_ptr[i] = results[i].position;
+			normal_ptr[i] = results[i].normal;
+			collider_id_ptr[i] = int64_t(results[i].collider_id);
+			shape_ptr[i] = results[i].shape;
+			face_index_ptr[i] = results[i].face_index;
+		} else {
+			position_ptr[i] = Vector3();
+			normal_ptr[i] = Vector3();
+			collider_id_ptr[i] = 0;
+			shape_ptr[i] = 0;
+			face_index_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	d["face_index"] = face_index;
+	return d;
+}
+
+Vector<real_t> PhysicsDirectSpaceState3D::_cast_motions_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The shape origin and motion arrays must have the same size.");
+
+	const int count = p_origins.size();
+	const Transform3D &transform = p_shape_query->get_parameters().transform;
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		transforms[i] = Transform3D(transform.basis, p_origins[i]);
+	}
+
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(count);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+	cast_motions(p_shape_query->get_parameters(), transforms.ptr(), p_motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptr = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptr[i * 2 + 0] = closest_safe[i];
+		ret_ptr[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -485,6 +591,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays_batch);
+	ClassDB::bind_method(D_METHOD("cast_motions_batch", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motions_batch);
 }
 
 ///////////////////////////////
@@ -661,6 +769,186 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+// Same tolerance as CharacterBody3D, so batched bodies classify surfaces the same way.
+#define SLIDE_FLOOR_ANGLE_THRESHOLD 0.01
+
+void PhysicsServer3D::solve_slide(const SlideParameters &p_parameters, real_t p_delta, SlideState &r_state, SlideTestMotionCallback p_test_motion, void *p_userdata) {
+	Vector3 motion = r_state.velocity * p_delta;
+
+	r_state.floor_normal = Vector3();
+	r_state.wall_normal = Vector3();
+	r_state.on_floor = false;
+	r_state.on_wall = false;
+	r_state.on_ceiling = false;
+
+	for (int iteration = 0; iteration < p_parameters.max_slides; ++iteration) {
+		MotionParameters parameters(r_state.transform, motion, p_parameters.margin);
+		parameters.max_collisions = 6; // There can be 4 collisions between 2 walls + 2 more for the floor.
+		parameters.recovery_as_collision = true; // Also report collisions generated only from recovery.
+
+		MotionResult result;
+		bool collided = p_test_motion(p_userdata, parameters, &result);
+
+		r_state.transform.origin += result.travel;
+
+		if (!collided) {
+			break;
+		}
+
+		real_t floor_depth = -1.0;
+		real_t wall_depth = -1.0;
+		for (int i = 0; i < result.collision_count; i++) {
+			const MotionCollision &collision = result.collisions[i];
+
+			if (collision.get_angle(p_parameters.up_direction) <= p_parameters.floor_max_angle + SLIDE_FLOOR_ANGLE_THRESHOLD) {
+				r_state.on_floor = true;
+				if (collision.depth > floor_depth) {
+					floor_depth = collision.depth;
+					r_state.floor_normal = collision.normal;
+				}
+			} else if (collision.get_angle(-p_parameters.up_direction) <= p_parameters.floor_max_angle + SLIDE_FLOOR_ANGLE_THRESHOLD) {
+				r_state.on_ceiling = true;
+			} else {
+				r_state.on_wall = true;
+				if (collision.depth > wall_depth) {
+					wall_depth = collision.depth;
+					r_state.wall_normal = collision.normal;
+				}
+			}
+		}
+
+		if (r_state.on_floor && p_parameters.floor_stop_on_slope && (r_state.velocity.normalized() + p_parameters.up_direction).length() < 0.01) {
+			// Only gravity pushes the body down the slope, so it stays where it is.
+			if (result.travel.length() <= p_parameters.margin + CMP_EPSILON) {
+				r_state.transform.origin -= result.travel;
+			}
+			r_state.velocity = Vector3();
+			break;
+		}
+
+		if (result.remainder.is_zero_approx()) {
+			break;
+		}
+
+		motion = result.remainder;
+		for (int i = 0; i < result.collision_count; i++) {
+			const Vector3 &normal = result.collisions[i].normal;
+			if (motion.dot(normal) < 0.0) {
+				motion = motion.slide(normal);
+			}
+			if (r_state.velocity.dot(normal) < 0.0) {
+				r_state.velocity = r_state.velocity.slide(normal);
+			}
+		}
+
+		if (motion.is_zero_approx() || motion.dot(r_state.velocity) <= 0.0) {
+			break;
+		}
+	}
+}
+
+struct SlideBodyData {
+	PhysicsServer3D *server = nullptr;
+	RID body;
+};
+
+static bool _slide_test_body_motion(void *p_userdata, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	const SlideBodyData *data = static_cast<const SlideBodyData *>(p_userdata);
+	return data->server->body_test_motion(data->body, p_parameters, r_result);
+}
+
+bool PhysicsServer3D::body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) {
+	for (int i = 0; i < p_count; i++) {
+		ERR_FAIL_COND_V(!body_get_space(p_bodies[i]).is_valid(), false);
+	}
+
+	SlideBodyData data;
+	data.server = this;
+	for (int i = 0; i < p_count; i++) {
+		data.body = p_bodies[i];
+		solve_slide(p_parameters, p_delta, r_states[i], _slide_test_body_motion, &data);
+	}
+	return true;
+}
+
+bool PhysicsServer3D::body_move_and_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) {
+	if (!body_solve_slide_batch(p_bodies, r_states, p_count, p_parameters, p_delta)) {
+		return false;
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		body_set_state(p_bodies[i], BODY_STATE_TRANSFORM, r_states[i].transform);
+	}
+	return true;
+}
+
+Dictionary PhysicsServer3D::_body_move_and_slide_batch(const TypedArray<RID> &p_bodies, const TypedArray<Transform3D> &p_transforms, const PackedVector3Array &p_velocities, real_t p_delta, const Vector3 &p_up_direction, real_t p_floor_max_angle, int p_max_slides, real_t p_margin) {
+	ERR_FAIL_COND_V_MSG(p_bodies.size() != p_transforms.size() || p_bodies.size() != p_velocities.size(), Dictionary(), "The body, transform and velocity arrays must have the same size.");
+	ERR_FAIL_COND_V(p_max_slides < 1, Dictionary());
+
+	SlideParameters parameters;
+	parameters.up_direction = p_up_direction.normalized();
+	parameters.floor_max_angle = p_floor_max_angle;
+	parameters.max_slides = p_max_slides;
+	parameters.margin = p_margin;
+
+	const int count = p_bodies.size();
+	LocalVector<RID> bodies;
+	bodies.resize(count);
+	LocalVector<SlideState> states;
+	states.resize(count);
+	for (int i = 0; i < count; i++) {
+		bodies[i] = p_bodies[i];
+		states[i].transform = p_transforms[i];
+		states[i].velocity = p_velocities[i];
+	}
+
+	if (!body_move_and_slide_batch(bodies.ptr(), states.ptr(), count, parameters, p_delta)) {
+		return Dictionary();
+	}
+
+	TypedArray<Transform3D> transform;
+	transform.resize(count);
+	PackedVector3Array velocity;
+	velocity.resize(count);
+	PackedVector3Array floor_normal;
+	floor_normal.resize(count);
+	PackedVector3Array wall_normal;
+	wall_normal.resize(count);
+	PackedByteArray on_floor;
+	on_floor.resize(count);
+	PackedByteArray on_wall;
+	on_wall.resize(count);
+	PackedByteArray on_ceiling;
+	on_ceiling.resize(count);
+
+	Vector3 *velocity_ptr = velocity.ptrw();
+	Vector3 *floor_normal_ptr = floor_normal.ptrw();
+	Vector3 *wall_normal_ptr = wall_normal.ptrw();
+	uint8_t *on_floor_ptr = on_floor.ptrw();
+	uint8_t *on_wall_ptr = on_wall.ptrw();
+	uint8_t *on_ceiling_ptr = on_ceiling.ptrw();
+	for (int i = 0; i < count; i++) {
+		transform[i] = states[i].transform;
+		velocity_ptr[i] = states[i].velocity;
+		floor_normal_ptr[i] = states[i].floor_normal;
+		wall_normal_ptr[i] = states[i].wall_normal;
+		on_floor_ptr[i] = states[i].on_floor;
+		on_wall_ptr[i] = states[i].on_wall;
+		on_ceiling_ptr[i] = states[i].on_ceiling;
+	}
+
+	Dictionary d;
+	d["transform"] = transform;
+	d["velocity"] = velocity;
+	d["floor_normal"] = floor_normal;
+	d["wall_normal"] = wall_normal;
+	d["on_floor"] = on_floor;
+	d["on_wall"] = on_wall;
+	d["on_ceiling"] = on_ceiling;
+	return d;
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -835,6 +1123,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_ray_pickable", "body", "enable"), &PhysicsServer3D::body_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "parameters", "result"), &PhysicsServer3D::_body_test_motion, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_move_and_slide_batch", "bodies", "transforms", "velocities", "delta", "up_direction", "floor_max_angle", "max_slides", "margin"), &PhysicsServer3D::_body_move_and_slide_batch, DEFVAL(Vector3(0, 1, 0)), DEFVAL(Math::deg_to_rad((real_t)45.0)), DEFVAL(6), DEFVAL(0.001));
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer3D::body_get_direct_state);
 
@@ -1128,6 +1417,12 @@ void PhysicsServer3D::_bind_methods() {
 #endif
 }
 
+void PhysicsServer3D::add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) {
+	// Stepping doesn't call user code, state callbacks are only sent from flush_queries(). So the step can run on
+	// a pool thread, next to the stages of other servers.
+	r_graph.add_stage(SNAME("Physics 3D step"), callable_mp(this, &PhysicsServer3D::step).bind(p_step), {}, { SNAME("physics_3d") });
+}
+
 PhysicsServer3D::PhysicsServer3D() {
 	singleton = this;
 
@@ -1146,6 +1441,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/parallel_broadphase_threshold", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 512);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
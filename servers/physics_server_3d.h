@@ -37,6 +37,7 @@
 
 constexpr int MAX_CONTACTS_REPORTED_3D_MAX = 4096;
 
+class FrameTaskGraph;
 class PhysicsDirectSpaceState3D;
 template <typename T>
 class TypedArray;
@@ -128,6 +129,8 @@ private:
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Vector<real_t> _cast_motions_batch(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -206,6 +209,12 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched queries, sharing everything in the parameters except the per-query
+	// positions, which are taken from the arrays. Servers may spread them across
+	// threads; these defaults run them one by one.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState3D();
 };
 
@@ -235,6 +244,7 @@ class PhysicsServer3D : public Object {
 	static PhysicsServer3D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
+	Dictionary _body_move_and_slide_batch(const TypedArray<RID> &p_bodies, const TypedArray<Transform3D> &p_transforms, const PackedVector3Array &p_velocities, real_t p_delta, const Vector3 &p_up_direction, real_t p_floor_max_angle, int p_max_slides, real_t p_margin);
 
 protected:
 	static void _bind_methods();
@@ -568,6 +578,41 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	// Bulk character controller stepping. Every body is moved from its state's
+	// transform by velocity * delta, sliding along what it hits like
+	// CharacterBody3D in grounded mode, and gets its state updated.
+	struct SlideParameters {
+		Vector3 up_direction = Vector3(0, 1, 0);
+		real_t floor_max_angle = Math::deg_to_rad((real_t)45.0);
+		real_t margin = 0.001;
+		int max_slides = 6;
+		bool floor_stop_on_slope = true;
+	};
+
+	struct SlideState {
+		Transform3D transform;
+		Vector3 velocity;
+		Vector3 floor_normal;
+		Vector3 wall_normal;
+		bool on_floor = false;
+		bool on_wall = false;
+		bool on_ceiling = false;
+	};
+
+	typedef bool (*SlideTestMotionCallback)(void *p_userdata, const MotionParameters &p_parameters, MotionResult *r_result);
+
+	// Runs the slide iterations of a single body, testing every step with p_test_motion.
+	static void solve_slide(const SlideParameters &p_parameters, real_t p_delta, SlideState &r_state, SlideTestMotionCallback p_test_motion, void *p_userdata);
+
+	// Only computes the new states, without moving the bodies, so all of them
+	// see the others where they were before the batch. Servers may spread the
+	// bodies across threads; this default solves them one by one. All bodies are
+	// checked first, so if one of them isn't in a space, no state is written and
+	// false is returned.
+	virtual bool body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta);
+	// Solves the batch, then moves every body to its new transform.
+	bool body_move_and_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta);
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -809,6 +854,9 @@ public:
 	virtual void end_sync() = 0;
 	virtual void finish() = 0;
 
+	// Adds the stage(s) doing step() to a frame graph. The default steps on the main thread.
+	virtual void add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step);
+
 	virtual bool is_flushing_queries() const = 0;
 
 	enum ProcessInfo {
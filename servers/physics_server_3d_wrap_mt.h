@@ -70,6 +70,7 @@ public:
 #define ServerNameWrapMT PhysicsServer3DWrapMT
 #define server_name physics_server_3d
 #define WRITE_ACTION
+#define MEMORY_TAG_SCOPE Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
 
 #include "servers/server_wrap_mt_common.h"
 
@@ -268,6 +269,11 @@ public:
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	bool body_solve_slide_batch(const RID *p_bodies, SlideState *r_states, int p_count, const SlideParameters &p_parameters, real_t p_delta) override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), false);
+		return physics_server_3d->body_solve_slide_batch(p_bodies, r_states, p_count, p_parameters, p_delta);
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -395,6 +401,7 @@ public:
 	virtual void end_sync() override;
 	virtual void flush_queries() override;
 	virtual void finish() override;
+	virtual void add_step_frame_stages(FrameTaskGraph &r_graph, real_t p_step) override;
 
 	virtual bool is_flushing_queries() const override {
 		return physics_server_3d->is_flushing_queries();
@@ -411,6 +418,7 @@ public:
 #undef ServerName
 #undef server_name
 #undef WRITE_ACTION
+#undef MEMORY_TAG_SCOPE
 };
 
 #ifdef DEBUG_SYNC
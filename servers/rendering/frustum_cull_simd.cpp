@@ -0,0 +1,290 @@
+/**************************************************************************/
+/*  frustum_cull_simd.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frustum_cull_simd.h"
+
+#include "core/error/error_macros.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__x86_64__) || defined(_M_X64)
+#define FRUSTUM_CULL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FRUSTUM_CULL_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+// GCC and Clang need the instruction set enabled per function to use the
+// AVX intrinsics without building the whole engine for AVX. MSVC does not.
+#if defined(__GNUC__) || defined(__clang__)
+#define FRUSTUM_CULL_TARGET(m_target) __attribute__((target(m_target)))
+#else
+#define FRUSTUM_CULL_TARGET(m_target)
+#endif
+
+typedef FrustumCullSIMD::CullPlane CullPlane;
+
+// Same arithmetic, in the same order, as Plane::distance_to() in InstanceBounds::in_frustum(),
+// so every kernel gives the exact same result as the scalar one.
+static _FORCE_INLINE_ void _cull_scalar_range(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_begin, uint32_t p_end, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		const uint64_t index = p_from + i;
+		uint8_t inside = 1;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const CullPlane &plane = p_planes[j];
+			const real_t distance = plane.normal[0] * p_bounds[plane.signs[0]][index] + plane.normal[1] * p_bounds[plane.signs[1]][index] + plane.normal[2] * p_bounds[plane.signs[2]][index] - plane.d;
+			if (distance >= 0) {
+				inside = 0;
+				break;
+			}
+		}
+		r_inside[i] = inside;
+	}
+}
+
+static void _cull_scalar(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	_cull_scalar_range(p_bounds, p_from, 0, p_count, p_planes, p_plane_count, r_inside);
+}
+
+#ifdef FRUSTUM_CULL_X86
+
+static void _cull_sse2(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const uint32_t simd_end = p_count & ~3u;
+	const __m128 zero = _mm_setzero_ps();
+
+	for (uint32_t i = 0; i < simd_end; i += 4) {
+		const uint64_t index = p_from + i;
+		__m128 outside = zero;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const CullPlane &plane = p_planes[j];
+			__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.normal[0]), _mm_loadu_ps(p_bounds[plane.signs[0]] + index));
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal[1]), _mm_loadu_ps(p_bounds[plane.signs[1]] + index)));
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal[2]), _mm_loadu_ps(p_bounds[plane.signs[2]] + index)));
+			distance = _mm_sub_ps(distance, _mm_set1_ps(plane.d));
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(distance, zero));
+		}
+
+		const int mask = _mm_movemask_ps(outside);
+		for (uint32_t k = 0; k < 4; k++) {
+			r_inside[i + k] = ((mask >> k) & 1) ^ 1;
+		}
+	}
+
+	_cull_scalar_range(p_bounds, p_from, simd_end, p_count, p_planes, p_plane_count, r_inside);
+}
+
+FRUSTUM_CULL_TARGET("avx")
+static void _cull_avx(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const uint32_t simd_end = p_count & ~7u;
+	const __m256 zero = _mm256_setzero_ps();
+
+	for (uint32_t i = 0; i < simd_end; i += 8) {
+		const uint64_t index = p_from + i;
+		__m256 outside = zero;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const CullPlane &plane = p_planes[j];
+			__m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane.normal[0]), _mm256_loadu_ps(p_bounds[plane.signs[0]] + index));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal[1]), _mm256_loadu_ps(p_bounds[plane.signs[1]] + index)));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal[2]), _mm256_loadu_ps(p_bounds[plane.signs[2]] + index)));
+			distance = _mm256_sub_ps(distance, _mm256_set1_ps(plane.d));
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+		}
+
+		const int mask = _mm256_movemask_ps(outside);
+		for (uint32_t k = 0; k < 8; k++) {
+			r_inside[i + k] = ((mask >> k) & 1) ^ 1;
+		}
+	}
+
+	_cull_scalar_range(p_bounds, p_from, simd_end, p_count, p_planes, p_plane_count, r_inside);
+}
+
+// AVX-512F includes FMA, and GCC contracts a multiply followed by an add into one by default, which rounds
+// differently. The explicit rounding variants can't be contracted, so they're used for all the arithmetic.
+// The tail is handled with masked loads rather than the scalar loop for the same reason.
+#define FRUSTUM_CULL_AVX512_ROUNDING (_MM_FROUND_CUR_DIRECTION)
+
+FRUSTUM_CULL_TARGET("avx512f")
+static void _cull_avx512(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const __m512 zero = _mm512_setzero_ps();
+
+	for (uint32_t i = 0; i < p_count; i += 16) {
+		const uint64_t index = p_from + i;
+		const uint32_t lanes = MIN(16u, p_count - i);
+		const __mmask16 load_mask = lanes == 16 ? __mmask16(0xFFFF) : __mmask16((1u << lanes) - 1);
+		__mmask16 outside = 0;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const CullPlane &plane = p_planes[j];
+			__m512 distance = _mm512_mul_round_ps(_mm512_set1_ps(plane.normal[0]), _mm512_maskz_loadu_ps(load_mask, p_bounds[plane.signs[0]] + index), FRUSTUM_CULL_AVX512_ROUNDING);
+			distance = _mm512_add_round_ps(distance, _mm512_mul_round_ps(_mm512_set1_ps(plane.normal[1]), _mm512_maskz_loadu_ps(load_mask, p_bounds[plane.signs[1]] + index), FRUSTUM_CULL_AVX512_ROUNDING), FRUSTUM_CULL_AVX512_ROUNDING);
+			distance = _mm512_add_round_ps(distance, _mm512_mul_round_ps(_mm512_set1_ps(plane.normal[2]), _mm512_maskz_loadu_ps(load_mask, p_bounds[plane.signs[2]] + index), FRUSTUM_CULL_AVX512_ROUNDING), FRUSTUM_CULL_AVX512_ROUNDING);
+			distance = _mm512_sub_round_ps(distance, _mm512_set1_ps(plane.d), FRUSTUM_CULL_AVX512_ROUNDING);
+			outside |= _mm512_cmp_ps_mask(distance, zero, _CMP_GE_OQ);
+		}
+
+		for (uint32_t k = 0; k < lanes; k++) {
+			r_inside[i + k] = ((outside >> k) & 1) ^ 1;
+		}
+	}
+}
+
+#undef FRUSTUM_CULL_AVX512_ROUNDING
+
+#endif // FRUSTUM_CULL_X86
+
+#ifdef FRUSTUM_CULL_NEON
+
+static void _cull_neon(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const uint32_t simd_end = p_count & ~3u;
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+
+	for (uint32_t i = 0; i < simd_end; i += 4) {
+		const uint64_t index = p_from + i;
+		uint32x4_t outside = vdupq_n_u32(0);
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const CullPlane &plane = p_planes[j];
+			// Separate multiply and add (no vmlaq_f32) to round like the scalar kernel.
+			float32x4_t distance = vmulq_n_f32(vld1q_f32(p_bounds[plane.signs[0]] + index), plane.normal[0]);
+			distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(p_bounds[plane.signs[1]] + index), plane.normal[1]));
+			distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(p_bounds[plane.signs[2]] + index), plane.normal[2]));
+			distance = vsubq_f32(distance, vdupq_n_f32(plane.d));
+			outside = vorrq_u32(outside, vcgeq_f32(distance, zero));
+		}
+
+		r_inside[i + 0] = vgetq_lane_u32(outside, 0) ? 0 : 1;
+		r_inside[i + 1] = vgetq_lane_u32(outside, 1) ? 0 : 1;
+		r_inside[i + 2] = vgetq_lane_u32(outside, 2) ? 0 : 1;
+		r_inside[i + 3] = vgetq_lane_u32(outside, 3) ? 0 : 1;
+	}
+
+	_cull_scalar_range(p_bounds, p_from, simd_end, p_count, p_planes, p_plane_count, r_inside);
+}
+
+#endif // FRUSTUM_CULL_NEON
+
+FrustumCullSIMD::CullFunc FrustumCullSIMD::funcs[KERNEL_MAX] = {
+	_cull_scalar,
+#ifdef FRUSTUM_CULL_X86
+	_cull_sse2,
+	_cull_avx,
+	_cull_avx512,
+#else
+	_cull_scalar,
+	_cull_scalar,
+	_cull_scalar,
+#endif
+#ifdef FRUSTUM_CULL_NEON
+	_cull_neon,
+#else
+	_cull_scalar,
+#endif
+};
+
+FrustumCullSIMD::Kernel FrustumCullSIMD::_detect_kernel() {
+#if defined(FRUSTUM_CULL_X86)
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return KERNEL_AVX512;
+	}
+	if (__builtin_cpu_supports("avx")) {
+		return KERNEL_AVX;
+	}
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	const bool has_osxsave = info[2] & (1 << 27);
+	const bool has_avx = info[2] & (1 << 28);
+	if (has_osxsave && has_avx) {
+		// Also check that the OS saves the YMM (and ZMM) registers.
+		const uint64_t xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x6) == 0x6) {
+			__cpuidex(info, 7, 0);
+			const bool has_avx512f = info[1] & (1 << 16);
+			if (has_avx512f && (xcr0 & 0xE6) == 0xE6) {
+				return KERNEL_AVX512;
+			}
+			return KERNEL_AVX;
+		}
+	}
+#endif
+	return KERNEL_SSE2;
+#elif defined(FRUSTUM_CULL_NEON)
+	return KERNEL_NEON;
+#else
+	return KERNEL_SCALAR;
+#endif
+}
+
+FrustumCullSIMD::Kernel FrustumCullSIMD::best_kernel = FrustumCullSIMD::_detect_kernel();
+FrustumCullSIMD::Kernel FrustumCullSIMD::kernel = FrustumCullSIMD::best_kernel;
+
+void FrustumCullSIMD::cull_with_kernel(Kernel p_kernel, const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	ERR_FAIL_COND(!is_kernel_supported(p_kernel));
+	funcs[p_kernel](p_bounds, p_from, p_count, p_planes, p_plane_count, r_inside);
+}
+
+bool FrustumCullSIMD::is_kernel_supported(Kernel p_kernel) {
+	switch (p_kernel) {
+		case KERNEL_SCALAR:
+			return true;
+		case KERNEL_SSE2:
+			return best_kernel == KERNEL_SSE2 || best_kernel == KERNEL_AVX || best_kernel == KERNEL_AVX512;
+		case KERNEL_AVX:
+			return best_kernel == KERNEL_AVX || best_kernel == KERNEL_AVX512;
+		case KERNEL_AVX512:
+			return best_kernel == KERNEL_AVX512;
+		case KERNEL_NEON:
+			return best_kernel == KERNEL_NEON;
+		default:
+			return false;
+	}
+}
+
+const char *FrustumCullSIMD::get_kernel_name(Kernel p_kernel) {
+	static const char *names[KERNEL_MAX] = {
+		"Scalar",
+		"SSE2",
+		"AVX",
+		"AVX-512",
+		"NEON",
+	};
+	ERR_FAIL_INDEX_V(p_kernel, KERNEL_MAX, "");
+	return names[p_kernel];
+}
+
+void FrustumCullSIMD::set_kernel(Kernel p_kernel) {
+	ERR_FAIL_COND(!is_kernel_supported(p_kernel));
+	kernel = p_kernel;
+}
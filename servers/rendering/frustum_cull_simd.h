@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  frustum_cull_simd.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_defs.h"
+#include "core/typedefs.h"
+
+// Tests instance bounds against frustum planes several instances at a time.
+// Bounds are stored as six separate arrays (min x, y, z, then max x, y, z),
+// so each plane test loads 4, 8 or 16 consecutive instances per instruction.
+// The fastest kernel the CPU supports is picked once at runtime.
+class FrustumCullSIMD {
+public:
+	enum Kernel {
+		KERNEL_SCALAR,
+		KERNEL_SSE2,
+		KERNEL_AVX,
+		KERNEL_AVX512,
+		KERNEL_NEON,
+		KERNEL_MAX,
+	};
+
+	struct CullPlane {
+		real_t normal[3];
+		real_t d;
+		// Bounds array each axis reads from, 0-2 for min and 3-5 for max.
+		// Selects the corner with the smallest distance to the plane, as PlaneSign does.
+		uint32_t signs[3];
+	};
+
+	// Writes 1 to r_inside for each instance in [p_from, p_from + p_count) that is not
+	// fully outside any plane, and 0 otherwise. r_inside is indexed from 0.
+	// Like InstanceBounds::in_frustum(), this is not a full SAT test.
+	typedef void (*CullFunc)(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside);
+
+private:
+	static CullFunc funcs[KERNEL_MAX];
+	static Kernel best_kernel;
+	static Kernel kernel;
+
+	static Kernel _detect_kernel();
+
+public:
+	_FORCE_INLINE_ static void cull(const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+		funcs[kernel](p_bounds, p_from, p_count, p_planes, p_plane_count, r_inside);
+	}
+
+	static void cull_with_kernel(Kernel p_kernel, const real_t *const *p_bounds, uint64_t p_from, uint32_t p_count, const CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_inside);
+
+	static bool is_kernel_supported(Kernel p_kernel);
+	static const char *get_kernel_name(Kernel p_kernel);
+	static Kernel get_kernel() { return kernel; }
+	// Only meant for tests and benchmarks; not thread-safe against running culls.
+	static void set_kernel(Kernel p_kernel);
+};
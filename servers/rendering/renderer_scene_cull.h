@@ -39,6 +39,7 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/frustum_cull_simd.h"
 #include "servers/rendering/instance_uniforms.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
@@ -157,6 +158,8 @@ public:
 	struct Frustum {
 		Vector<Plane> planes;
 		Vector<PlaneSign> plane_signs;
+		// Same planes, laid out for FrustumCullSIMD.
+		LocalVector<FrustumCullSIMD::CullPlane> cull_planes;
 		const Plane *planes_ptr;
 		const PlaneSign *plane_signs_ptr;
 		uint32_t plane_count;
@@ -165,6 +168,7 @@ public:
 		_ALWAYS_INLINE_ Frustum(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
 			plane_signs = p_frustum.plane_signs;
+			cull_planes = p_frustum.cull_planes;
 
 			planes_ptr = planes.ptr();
 			plane_signs_ptr = plane_signs.ptr();
@@ -173,6 +177,7 @@ public:
 		_ALWAYS_INLINE_ void operator=(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
 			plane_signs = p_frustum.plane_signs;
+			cull_planes = p_frustum.cull_planes;
 
 			planes_ptr = planes.ptr();
 			plane_signs_ptr = plane_signs.ptr();
@@ -182,9 +187,17 @@ public:
 			planes = p_planes;
 			planes_ptr = planes.ptrw();
 			plane_count = planes.size();
+			cull_planes.resize(plane_count);
 			for (int i = 0; i < planes.size(); i++) {
 				PlaneSign ps(p_planes[i]);
 				plane_signs.push_back(ps);
+
+				FrustumCullSIMD::CullPlane &cull_plane = cull_planes[i];
+				for (uint32_t j = 0; j < 3; j++) {
+					cull_plane.normal[j] = p_planes[i].normal[j];
+					cull_plane.signs[j] = ps.signs[j];
+				}
+				cull_plane.d = p_planes[i].d;
 			}
 
 			plane_signs_ptr = plane_signs.ptr();
@@ -250,6 +263,39 @@ public:
 		}
 	};
 
+	struct InstanceBoundsSoA {
+		// The same bounds as the scenario's InstanceBounds array, with one
+		// array per component so FrustumCullSIMD can test several instances at once.
+
+		LocalVector<real_t> bounds[6];
+
+		_FORCE_INLINE_ void push_back(const InstanceBounds &p_bounds) {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i].push_back(p_bounds.bounds[i]);
+			}
+		}
+		_FORCE_INLINE_ void set(uint32_t p_index, const InstanceBounds &p_bounds) {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i][p_index] = p_bounds.bounds[i];
+			}
+		}
+		_FORCE_INLINE_ void copy(uint32_t p_to, uint32_t p_from) {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i][p_to] = bounds[i][p_from];
+			}
+		}
+		_FORCE_INLINE_ void pop_back() {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i].resize(bounds[i].size() - 1);
+			}
+		}
+		void reset() {
+			for (uint32_t i = 0; i < 6; i++) {
+				bounds[i].reset();
+			}
+		}
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -349,6 +395,7 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		InstanceBoundsSoA instance_bounds_soa;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
@@ -617,6 +664,7 @@ public:
 
 	mutable SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false) const;
+	void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
 
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
@@ -1025,6 +1073,7 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -1129,7 +1178,6 @@ public:
 		uint32_t cull_count;
 	};
 
-	void _visibility_cull_threaded(uint32_t p_thread, VisibilityCullData *cull_data);
 	void _visibility_cull(const VisibilityCullData &cull_data, uint64_t p_from, uint64_t p_to);
 	template <bool p_fade_check>
 	_FORCE_INLINE_ int _visibility_range_check(InstanceVisibilityData &r_vis_data, const Vector3 &p_camera_pos, uint64_t p_viewport_mask);
@@ -1146,7 +1194,6 @@ public:
 		uint64_t visibility_viewport_mask;
 	};
 
-	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
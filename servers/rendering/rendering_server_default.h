@@ -109,6 +109,8 @@ public:
 #endif
 
 #define WRITE_ACTION redraw_request();
+// Calls are charged to rendering memory, even when run right away on the calling thread.
+#define MEMORY_TAG_SCOPE Memory::TagScope memory_tag(Memory::TAG_RENDERING);
 
 #ifdef DEBUG_SYNC
 #define SYNC_DEBUG print_line("sync on: " + String(__FUNCTION__));
@@ -129,6 +131,7 @@ public:
 
 #define FUNCRIDTEX0(m_type)                                                                              \
 	virtual RID m_type##_create() override {                                                             \
+		MEMORY_TAG_SCOPE                                                                                 \
 		RID ret = RSG::texture_storage->texture_allocate();                                              \
 		if (Thread::get_caller_id() == server_thread || RSG::rasterizer->can_create_resources_async()) { \
 			RSG::texture_storage->m_type##_initialize(ret);                                              \
@@ -140,6 +143,7 @@ public:
 
 #define FUNCRIDTEX1(m_type, m_type1)                                                                         \
 	virtual RID m_type##_create(m_type1 p1) override {                                                       \
+		MEMORY_TAG_SCOPE                                                                                     \
 		RID ret = RSG::texture_storage->texture_allocate();                                                  \
 		if (Thread::get_caller_id() == server_thread || RSG::rasterizer->can_create_resources_async()) {     \
 			RSG::texture_storage->m_type##_initialize(ret, p1);                                              \
@@ -151,6 +155,7 @@ public:
 
 #define FUNCRIDTEX2(m_type, m_type1, m_type2)                                                                    \
 	virtual RID m_type##_create(m_type1 p1, m_type2 p2) override {                                               \
+		MEMORY_TAG_SCOPE                                                                                         \
 		RID ret = RSG::texture_storage->texture_allocate();                                                      \
 		if (Thread::get_caller_id() == server_thread || RSG::rasterizer->can_create_resources_async()) {         \
 			RSG::texture_storage->m_type##_initialize(ret, p1, p2);                                              \
@@ -162,6 +167,7 @@ public:
 
 #define FUNCRIDTEX3(m_type, m_type1, m_type2, m_type3)                                                               \
 	virtual RID m_type##_create(m_type1 p1, m_type2 p2, m_type3 p3) override {                                       \
+		MEMORY_TAG_SCOPE                                                                                             \
 		RID ret = RSG::texture_storage->texture_allocate();                                                          \
 		if (Thread::get_caller_id() == server_thread || RSG::rasterizer->can_create_resources_async()) {             \
 			RSG::texture_storage->m_type##_initialize(ret, p1, p2, p3);                                              \
@@ -173,6 +179,7 @@ public:
 
 #define FUNCRIDTEX6(m_type, m_type1, m_type2, m_type3, m_type4, m_type5, m_type6)                                                \
 	virtual RID m_type##_create(m_type1 p1, m_type2 p2, m_type3 p3, m_type4 p4, m_type5 p5, m_type6 p6) override {               \
+		MEMORY_TAG_SCOPE                                                                                                         \
 		RID ret = RSG::texture_storage->texture_allocate();                                                                      \
 		if (Thread::get_caller_id() == server_thread || RSG::rasterizer->can_create_resources_async()) {                         \
 			RSG::texture_storage->m_type##_initialize(ret, p1, p2, p3, p4, p5, p6);                                              \
@@ -191,6 +198,7 @@ public:
 
 	// Called directly, not through the command queue.
 	virtual RID texture_create_from_native_handle(TextureType p_type, Image::Format p_format, uint64_t p_native_handle, int p_width, int p_height, int p_depth, int p_layers = 1, TextureLayeredType p_layered_type = TEXTURE_LAYERED_2D_ARRAY) override {
+		MEMORY_TAG_SCOPE
 		return RSG::texture_storage->texture_create_from_native_handle(p_type, p_format, p_native_handle, p_width, p_height, p_depth, p_layers, p_layered_type);
 	}
 
@@ -242,6 +250,7 @@ public:
 #define server_name RSG::material_storage
 
 	virtual RID shader_create() override {
+		MEMORY_TAG_SCOPE
 		RID ret = RSG::material_storage->shader_allocate();
 		if (Thread::get_caller_id() == server_thread) {
 			RSG::material_storage->shader_initialize(ret, false);
@@ -252,6 +261,7 @@ public:
 	}
 
 	virtual RID shader_create_from_code(const String &p_code, const String &p_path_hint = String()) override {
+		MEMORY_TAG_SCOPE
 		RID shader = RSG::material_storage->shader_allocate();
 		bool using_server_thread = Thread::get_caller_id() == server_thread;
 		if (using_server_thread || RSG::rasterizer->can_create_resources_async()) {
@@ -288,6 +298,7 @@ public:
 	FUNCRIDSPLIT(material)
 
 	virtual RID material_create_from_shader(RID p_next_pass, int p_render_priority, RID p_shader) override {
+		MEMORY_TAG_SCOPE
 		RID material = RSG::material_storage->material_allocate();
 		bool using_server_thread = Thread::get_caller_id() == server_thread;
 		if (using_server_thread || RSG::rasterizer->can_create_resources_async()) {
@@ -327,6 +338,7 @@ public:
 #define server_name RSG::mesh_storage
 
 	virtual RID mesh_create_from_surfaces(const Vector<SurfaceData> &p_surfaces, int p_blend_shape_count = 0) override {
+		MEMORY_TAG_SCOPE
 		RID mesh = RSG::mesh_storage->mesh_allocate();
 
 		bool using_server_thread = Thread::get_caller_id() == server_thread;
@@ -891,6 +903,7 @@ public:
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC3(instance_set_pivot_data, RID, float, bool)
 	FUNC2(instance_set_transform, RID, const Transform3D &)
+	FUNC2(instances_set_transforms, const Vector<RID> &, const Vector<Transform3D> &)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
 	FUNC3(instance_set_blend_shape_weight, RID, int, float)
 	FUNC3(instance_set_surface_override_material, RID, int, RID)
@@ -966,6 +979,7 @@ public:
 	FUNC2(canvas_item_set_update_when_visible, RID, bool)
 
 	FUNC2(canvas_item_set_transform, RID, const Transform2D &)
+	FUNC2(canvas_items_set_transforms, const Vector<RID> &, const Vector<Transform2D> &)
 	FUNC2(canvas_item_set_clip, RID, bool)
 	FUNC2(canvas_item_set_distance_field_mode, RID, bool)
 	FUNC3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
@@ -1118,6 +1132,7 @@ public:
 #undef server_name
 #undef ServerName
 #undef WRITE_ACTION
+#undef MEMORY_TAG_SCOPE
 #undef SYNC_DEBUG
 #ifdef DEBUG_ENABLED
 #undef MAIN_THREAD_SYNC_WARN
@@ -1135,6 +1150,7 @@ public:
 	/* FREE */
 
 	virtual void free(RID p_rid) override {
+		Memory::TagScope memory_tag(Memory::TAG_RENDERING);
 		if (Thread::get_caller_id() == server_thread) {
 			command_queue.flush_if_pending();
 			_free(p_rid);
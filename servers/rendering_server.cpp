@@ -102,6 +102,54 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms) {
+	// Same layout as multimesh transforms: the basis rows, each followed by the matching origin component.
+	ERR_FAIL_COND(p_transforms.size() != p_instances.size() * 12);
+
+	int count = p_instances.size();
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(count);
+	transforms.resize(count);
+	RID *instances_ptrw = instances.ptrw();
+	Transform3D *transforms_ptrw = transforms.ptrw();
+	const float *r = p_transforms.ptr();
+	for (int i = 0; i < count; i++) {
+		instances_ptrw[i] = p_instances[i];
+		const float *src = &r[i * 12];
+		Transform3D &t = transforms_ptrw[i];
+		t.basis.rows[0] = Vector3(src[0], src[1], src[2]);
+		t.origin.x = src[3];
+		t.basis.rows[1] = Vector3(src[4], src[5], src[6]);
+		t.origin.y = src[7];
+		t.basis.rows[2] = Vector3(src[8], src[9], src[10]);
+		t.origin.z = src[11];
+	}
+
+	instances_set_transforms(instances, transforms);
+}
+
+void RenderingServer::_canvas_items_set_transforms_bind(const TypedArray<RID> &p_items, const PackedFloat32Array &p_transforms) {
+	// Row-major, like the 3D version: x.x, y.x, origin.x, x.y, y.y, origin.y.
+	ERR_FAIL_COND(p_transforms.size() != p_items.size() * 6);
+
+	int count = p_items.size();
+	Vector<RID> items;
+	Vector<Transform2D> transforms;
+	items.resize(count);
+	transforms.resize(count);
+	RID *items_ptrw = items.ptrw();
+	Transform2D *transforms_ptrw = transforms.ptrw();
+	const float *r = p_transforms.ptr();
+	for (int i = 0; i < count; i++) {
+		items_ptrw[i] = p_items[i];
+		const float *src = &r[i * 6];
+		transforms_ptrw[i] = Transform2D(src[0], src[3], src[1], src[4], src[2], src[5]);
+	}
+
+	canvas_items_set_transforms(items, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -3183,6 +3231,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
@@ -3287,6 +3336,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_set_light_mask", "item", "mask"), &RenderingServer::canvas_item_set_light_mask);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_visibility_layer", "item", "visibility_layer"), &RenderingServer::canvas_item_set_visibility_layer);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_transform", "item", "transform"), &RenderingServer::canvas_item_set_transform);
+	ClassDB::bind_method(D_METHOD("canvas_items_set_transforms", "items", "transforms"), &RenderingServer::_canvas_items_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_clip", "item", "clip"), &RenderingServer::canvas_item_set_clip);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_distance_field_mode", "item", "enabled"), &RenderingServer::canvas_item_set_distance_field_mode);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_custom_rect", "item", "use_custom_rect", "rect"), &RenderingServer::canvas_item_set_custom_rect, DEFVAL(Rect2()));
@@ -41,6 +41,7 @@
 
 #define FUNC0R(m_r, m_type)                                                     \
 	virtual m_r m_type() override {                                             \
+		MEMORY_TAG_SCOPE                                                        \
 		if (Thread::get_caller_id() != server_thread) {                         \
 			m_r ret;                                                            \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret); \
@@ -55,6 +56,7 @@
 
 #define FUNCRIDSPLIT(m_type)                                                        \
 	virtual RID m_type##_create() override {                                        \
+		MEMORY_TAG_SCOPE                                                            \
 		RID ret = server_name->m_type##_allocate();                                 \
 		if (Thread::get_caller_id() != server_thread) {                             \
 			command_queue.push(server_name, &ServerName::m_type##_initialize, ret); \
@@ -67,11 +69,13 @@
 //RID now returns directly, ensure thread safety yourself
 #define FUNCRID(m_type)                        \
 	virtual RID m_type##_create() override {   \
+		MEMORY_TAG_SCOPE                       \
 		return server_name->m_type##_create(); \
 	}
 
 #define FUNC0RC(m_r, m_type)                                                    \
 	virtual m_r m_type() const override {                                       \
+		MEMORY_TAG_SCOPE                                                        \
 		WRITE_ACTION                                                            \
 		if (Thread::get_caller_id() != server_thread) {                         \
 			m_r ret;                                                            \
@@ -87,6 +91,7 @@
 
 #define FUNC0(m_type)                                             \
 	virtual void m_type() override {                              \
+		MEMORY_TAG_SCOPE                                          \
 		WRITE_ACTION                                              \
 		if (Thread::get_caller_id() != server_thread) {           \
 			command_queue.push(server_name, &ServerName::m_type); \
@@ -98,6 +103,7 @@
 
 #define FUNC0C(m_type)                                            \
 	virtual void m_type() const override {                        \
+		MEMORY_TAG_SCOPE                                          \
 		if (Thread::get_caller_id() != server_thread) {           \
 			command_queue.push(server_name, &ServerName::m_type); \
 		} else {                                                  \
@@ -108,6 +114,7 @@
 
 #define FUNC0S(m_type)                                                     \
 	virtual void m_type() override {                                       \
+		MEMORY_TAG_SCOPE                                                   \
 		WRITE_ACTION                                                       \
 		if (Thread::get_caller_id() != server_thread) {                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type); \
@@ -121,6 +128,7 @@
 
 #define FUNC0SC(m_type)                                                    \
 	virtual void m_type() const override {                                 \
+		MEMORY_TAG_SCOPE                                                   \
 		if (Thread::get_caller_id() != server_thread) {                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type); \
 			SYNC_DEBUG                                                     \
@@ -135,6 +143,7 @@
 
 #define FUNC1R(m_r, m_type, m_arg1)                                                 \
 	virtual m_r m_type(m_arg1 p1) override {                                        \
+		MEMORY_TAG_SCOPE                                                            \
 		WRITE_ACTION                                                                \
 		if (Thread::get_caller_id() != server_thread) {                             \
 			m_r ret;                                                                \
@@ -150,6 +159,7 @@
 
 #define FUNC1RC(m_r, m_type, m_arg1)                                                \
 	virtual m_r m_type(m_arg1 p1) const override {                                  \
+		MEMORY_TAG_SCOPE                                                            \
 		if (Thread::get_caller_id() != server_thread) {                             \
 			m_r ret;                                                                \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1); \
@@ -164,6 +174,7 @@
 
 #define FUNC1S(m_type, m_arg1)                                                 \
 	virtual void m_type(m_arg1 p1) override {                                  \
+		MEMORY_TAG_SCOPE                                                       \
 		WRITE_ACTION                                                           \
 		if (Thread::get_caller_id() != server_thread) {                        \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1); \
@@ -177,6 +188,7 @@
 
 #define FUNC1SC(m_type, m_arg1)                                                \
 	virtual void m_type(m_arg1 p1) const override {                            \
+		MEMORY_TAG_SCOPE                                                       \
 		if (Thread::get_caller_id() != server_thread) {                        \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1); \
 			SYNC_DEBUG                                                         \
@@ -189,6 +201,7 @@
 
 #define FUNC1(m_type, m_arg1)                                         \
 	virtual void m_type(m_arg1 p1) override {                         \
+		MEMORY_TAG_SCOPE                                              \
 		WRITE_ACTION                                                  \
 		if (Thread::get_caller_id() != server_thread) {               \
 			command_queue.push(server_name, &ServerName::m_type, p1); \
@@ -200,6 +213,7 @@
 
 #define FUNC1C(m_type, m_arg1)                                        \
 	virtual void m_type(m_arg1 p1) const override {                   \
+		MEMORY_TAG_SCOPE                                              \
 		if (Thread::get_caller_id() != server_thread) {               \
 			command_queue.push(server_name, &ServerName::m_type, p1); \
 		} else {                                                      \
@@ -210,6 +224,7 @@
 
 #define FUNC2R(m_r, m_type, m_arg1, m_arg2)                                             \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2) override {                                 \
+		MEMORY_TAG_SCOPE                                                                \
 		WRITE_ACTION                                                                    \
 		if (Thread::get_caller_id() != server_thread) {                                 \
 			m_r ret;                                                                    \
@@ -225,6 +240,7 @@
 
 #define FUNC2RC(m_r, m_type, m_arg1, m_arg2)                                            \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2) const override {                           \
+		MEMORY_TAG_SCOPE                                                                \
 		if (Thread::get_caller_id() != server_thread) {                                 \
 			m_r ret;                                                                    \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2); \
@@ -239,6 +255,7 @@
 
 #define FUNC2S(m_type, m_arg1, m_arg2)                                             \
 	virtual void m_type(m_arg1 p1, m_arg2 p2) override {                           \
+		MEMORY_TAG_SCOPE                                                           \
 		WRITE_ACTION                                                               \
 		if (Thread::get_caller_id() != server_thread) {                            \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2); \
@@ -252,6 +269,7 @@
 
 #define FUNC2SC(m_type, m_arg1, m_arg2)                                            \
 	virtual void m_type(m_arg1 p1, m_arg2 p2) const override {                     \
+		MEMORY_TAG_SCOPE                                                           \
 		if (Thread::get_caller_id() != server_thread) {                            \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2); \
 			SYNC_DEBUG                                                             \
@@ -264,6 +282,7 @@
 
 #define FUNC2(m_type, m_arg1, m_arg2)                                     \
 	virtual void m_type(m_arg1 p1, m_arg2 p2) override {                  \
+		MEMORY_TAG_SCOPE                                                  \
 		WRITE_ACTION                                                      \
 		if (Thread::get_caller_id() != server_thread) {                   \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2); \
@@ -275,6 +294,7 @@
 
 #define FUNC2C(m_type, m_arg1, m_arg2)                                    \
 	virtual void m_type(m_arg1 p1, m_arg2 p2) const override {            \
+		MEMORY_TAG_SCOPE                                                  \
 		if (Thread::get_caller_id() != server_thread) {                   \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2); \
 		} else {                                                          \
@@ -285,6 +305,7 @@
 
 #define FUNC3R(m_r, m_type, m_arg1, m_arg2, m_arg3)                                         \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {                          \
+		MEMORY_TAG_SCOPE                                                                    \
 		WRITE_ACTION                                                                        \
 		if (Thread::get_caller_id() != server_thread) {                                     \
 			m_r ret;                                                                        \
@@ -300,6 +321,7 @@
 
 #define FUNC3RC(m_r, m_type, m_arg1, m_arg2, m_arg3)                                        \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) const override {                    \
+		MEMORY_TAG_SCOPE                                                                    \
 		if (Thread::get_caller_id() != server_thread) {                                     \
 			m_r ret;                                                                        \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3); \
@@ -314,6 +336,7 @@
 
 #define FUNC3S(m_type, m_arg1, m_arg2, m_arg3)                                         \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {                    \
+		MEMORY_TAG_SCOPE                                                               \
 		WRITE_ACTION                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3); \
@@ -327,6 +350,7 @@
 
 #define FUNC3SC(m_type, m_arg1, m_arg2, m_arg3)                                        \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) const override {              \
+		MEMORY_TAG_SCOPE                                                               \
 		if (Thread::get_caller_id() != server_thread) {                                \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3); \
 			SYNC_DEBUG                                                                 \
@@ -339,6 +363,7 @@
 
 #define FUNC3(m_type, m_arg1, m_arg2, m_arg3)                                 \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {           \
+		MEMORY_TAG_SCOPE                                                      \
 		WRITE_ACTION                                                          \
 		if (Thread::get_caller_id() != server_thread) {                       \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3); \
@@ -350,6 +375,7 @@
 
 #define FUNC3C(m_type, m_arg1, m_arg2, m_arg3)                                \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) const override {     \
+		MEMORY_TAG_SCOPE                                                      \
 		if (Thread::get_caller_id() != server_thread) {                       \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3); \
 		} else {                                                              \
@@ -360,6 +386,7 @@
 
 #define FUNC4R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                     \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) override {                   \
+		MEMORY_TAG_SCOPE                                                                        \
 		WRITE_ACTION                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                         \
 			m_r ret;                                                                            \
@@ -375,6 +402,7 @@
 
 #define FUNC4RC(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                    \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) const override {             \
+		MEMORY_TAG_SCOPE                                                                        \
 		if (Thread::get_caller_id() != server_thread) {                                         \
 			m_r ret;                                                                            \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3, p4); \
@@ -389,6 +417,7 @@
 
 #define FUNC4S(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                     \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) override {             \
+		MEMORY_TAG_SCOPE                                                                   \
 		WRITE_ACTION                                                                       \
 		if (Thread::get_caller_id() != server_thread) {                                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4); \
@@ -402,6 +431,7 @@
 
 #define FUNC4SC(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                    \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) const override {       \
+		MEMORY_TAG_SCOPE                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4); \
 			SYNC_DEBUG                                                                     \
@@ -414,6 +444,7 @@
 
 #define FUNC4(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                             \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) override {    \
+		MEMORY_TAG_SCOPE                                                          \
 		WRITE_ACTION                                                              \
 		if (Thread::get_caller_id() != server_thread) {                           \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4); \
@@ -425,6 +456,7 @@
 
 #define FUNC4C(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                               \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) const override { \
+		MEMORY_TAG_SCOPE                                                             \
 		if (Thread::get_caller_id() != server_thread) {                              \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4);    \
 		} else {                                                                     \
@@ -435,6 +467,7 @@
 
 #define FUNC5R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                 \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) {                     \
+		MEMORY_TAG_SCOPE                                                                            \
 		WRITE_ACTION                                                                                \
 		if (Thread::get_caller_id() != server_thread) {                                             \
 			m_r ret;                                                                                \
@@ -450,6 +483,7 @@
 
 #define FUNC5RC(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) const override {      \
+		MEMORY_TAG_SCOPE                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                             \
 			m_r ret;                                                                                \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3, p4, p5); \
@@ -464,6 +498,7 @@
 
 #define FUNC5S(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                 \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) override {      \
+		MEMORY_TAG_SCOPE                                                                       \
 		WRITE_ACTION                                                                           \
 		if (Thread::get_caller_id() != server_thread) {                                        \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5); \
@@ -477,6 +512,7 @@
 
 #define FUNC5SC(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                 \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) const override { \
+		MEMORY_TAG_SCOPE                                                                        \
 		if (Thread::get_caller_id() != server_thread) {                                         \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);  \
 			SYNC_DEBUG                                                                          \
@@ -489,6 +525,7 @@
 
 #define FUNC5(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                             \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) override { \
+		MEMORY_TAG_SCOPE                                                                  \
 		WRITE_ACTION                                                                      \
 		if (Thread::get_caller_id() != server_thread) {                                   \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);     \
@@ -500,6 +537,7 @@
 
 #define FUNC5C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                  \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) const override { \
+		MEMORY_TAG_SCOPE                                                                        \
 		if (Thread::get_caller_id() != server_thread) {                                         \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);           \
 		} else {                                                                                \
@@ -510,6 +548,7 @@
 
 #define FUNC6R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                             \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) {              \
+		MEMORY_TAG_SCOPE                                                                                \
 		WRITE_ACTION                                                                                    \
 		if (Thread::get_caller_id() != server_thread) {                                                 \
 			m_r ret;                                                                                    \
@@ -525,6 +564,7 @@
 
 #define FUNC6RC(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                              \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) const override { \
+		MEMORY_TAG_SCOPE                                                                                  \
 		if (Thread::get_caller_id() != server_thread) {                                                   \
 			m_r ret;                                                                                      \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3, p4, p5, p6);   \
@@ -539,6 +579,7 @@
 
 #define FUNC6S(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                               \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) override { \
+		MEMORY_TAG_SCOPE                                                                             \
 		WRITE_ACTION                                                                                 \
 		if (Thread::get_caller_id() != server_thread) {                                              \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);   \
@@ -552,6 +593,7 @@
 
 #define FUNC6SC(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                                    \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) const override { \
+		MEMORY_TAG_SCOPE                                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);         \
 			SYNC_DEBUG                                                                                     \
@@ -564,6 +606,7 @@
 
 #define FUNC6(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                                \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) override { \
+		MEMORY_TAG_SCOPE                                                                             \
 		WRITE_ACTION                                                                                 \
 		if (Thread::get_caller_id() != server_thread) {                                              \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);            \
@@ -575,6 +618,7 @@
 
 #define FUNC6C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                                     \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) const override { \
+		MEMORY_TAG_SCOPE                                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                                    \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);                  \
 		} else {                                                                                           \
@@ -585,6 +629,7 @@
 
 #define FUNC7R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                            \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) override { \
+		MEMORY_TAG_SCOPE                                                                                       \
 		WRITE_ACTION                                                                                           \
 		if (Thread::get_caller_id() != server_thread) {                                                        \
 			m_r ret;                                                                                           \
@@ -600,6 +645,7 @@
 
 #define FUNC7RC(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                 \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) const override { \
+		MEMORY_TAG_SCOPE                                                                                             \
 		if (Thread::get_caller_id() != server_thread) {                                                              \
 			m_r ret;                                                                                                 \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3, p4, p5, p6, p7);          \
@@ -614,6 +660,7 @@
 
 #define FUNC7S(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                  \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) override { \
+		MEMORY_TAG_SCOPE                                                                                        \
 		WRITE_ACTION                                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                                         \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);          \
@@ -627,6 +674,7 @@
 
 #define FUNC7SC(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                       \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) const override { \
+		MEMORY_TAG_SCOPE                                                                                              \
 		if (Thread::get_caller_id() != server_thread) {                                                               \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                \
 			SYNC_DEBUG                                                                                                \
@@ -639,6 +687,7 @@
 
 #define FUNC7(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                   \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) override { \
+		MEMORY_TAG_SCOPE                                                                                        \
 		WRITE_ACTION                                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                                         \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                   \
@@ -650,6 +699,7 @@
 
 #define FUNC7C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                        \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) const override { \
+		MEMORY_TAG_SCOPE                                                                                              \
 		if (Thread::get_caller_id() != server_thread) {                                                               \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                         \
 		} else {                                                                                                      \
@@ -660,6 +710,7 @@
 
 #define FUNC8R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                               \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) override { \
+		MEMORY_TAG_SCOPE                                                                                                  \
 		WRITE_ACTION                                                                                                      \
 		if (Thread::get_caller_id() != server_thread) {                                                                   \
 			m_r ret;                                                                                                      \
@@ -675,6 +726,7 @@
 
 #define FUNC8RC(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                    \
 	virtual m_r m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) const override { \
+		MEMORY_TAG_SCOPE                                                                                                        \
 		if (Thread::get_caller_id() != server_thread) {                                                                         \
 			m_r ret;                                                                                                            \
 			command_queue.push_and_ret(server_name, &ServerName::m_type, &ret, p1, p2, p3, p4, p5, p6, p7, p8);                 \
@@ -689,6 +741,7 @@
 
 #define FUNC8S(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                     \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) override { \
+		MEMORY_TAG_SCOPE                                                                                                   \
 		WRITE_ACTION                                                                                                       \
 		if (Thread::get_caller_id() != server_thread) {                                                                    \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                 \
@@ -702,6 +755,7 @@
 
 #define FUNC8SC(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                          \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) const override { \
+		MEMORY_TAG_SCOPE                                                                                                         \
 		if (Thread::get_caller_id() != server_thread) {                                                                          \
 			command_queue.push_and_sync(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                       \
 			SYNC_DEBUG                                                                                                           \
@@ -714,6 +768,7 @@
 
 #define FUNC8(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                      \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) override { \
+		MEMORY_TAG_SCOPE                                                                                                   \
 		WRITE_ACTION                                                                                                       \
 		if (Thread::get_caller_id() != server_thread) {                                                                    \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                          \
@@ -725,6 +780,7 @@
 
 #define FUNC8C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                           \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) const override { \
+		MEMORY_TAG_SCOPE                                                                                                         \
 		if (Thread::get_caller_id() != server_thread) {                                                                          \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                                \
 		} else {                                                                                                                 \
@@ -735,6 +791,7 @@
 
 #define FUNC9(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9)                                         \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9) override { \
+		MEMORY_TAG_SCOPE                                                                                                              \
 		WRITE_ACTION                                                                                                                  \
 		if (Thread::get_caller_id() != server_thread) {                                                                               \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9);                                 \
@@ -746,6 +803,7 @@
 
 #define FUNC10(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10)                                            \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10) override { \
+		MEMORY_TAG_SCOPE                                                                                                                           \
 		WRITE_ACTION                                                                                                                               \
 		if (Thread::get_caller_id() != server_thread) {                                                                                            \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);                                         \
@@ -757,6 +815,7 @@
 
 #define FUNC11(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10, m_arg11)                                                \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11) override { \
+		MEMORY_TAG_SCOPE                                                                                                                                        \
 		WRITE_ACTION                                                                                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                         \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);                                                 \
@@ -768,6 +827,7 @@
 
 #define FUNC12(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10, m_arg11, m_arg12)                                                    \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12) override { \
+		MEMORY_TAG_SCOPE                                                                                                                                                     \
 		WRITE_ACTION                                                                                                                                                         \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                      \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);                                                         \
@@ -779,6 +839,7 @@
 
 #define FUNC13(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10, m_arg11, m_arg12, m_arg13)                                                        \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13) override { \
+		MEMORY_TAG_SCOPE                                                                                                                                                                  \
 		WRITE_ACTION                                                                                                                                                                      \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                   \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);                                                                 \
@@ -790,6 +851,7 @@
 
 #define FUNC14(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10, m_arg11, m_arg12, m_arg13, m_arg14)                                                            \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13, m_arg14 p14) override { \
+		MEMORY_TAG_SCOPE                                                                                                                                                                               \
 		WRITE_ACTION                                                                                                                                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                                \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);                                                                         \
@@ -801,6 +863,7 @@
 
 #define FUNC15(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8, m_arg9, m_arg10, m_arg11, m_arg12, m_arg13, m_arg14, m_arg15)                                                                \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13, m_arg14 p14, m_arg15 p15) override { \
+		MEMORY_TAG_SCOPE                                                                                                                                                                                            \
 		WRITE_ACTION                                                                                                                                                                                                \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                                             \
 			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);                                                                                 \
@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairingObject {
+	uint32_t layer = 1;
+};
+
+template <typename T>
+class PairingTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return p_a->layer & p_b->layer;
+	}
+};
+
+template <typename T>
+class PairingCullFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairingObject, 2, true, 32, PairingTestFunction<PairingObject>, PairingCullFunction<PairingObject>> PairingBVH;
+
+struct PairingLog {
+	LocalVector<uint64_t> events;
+
+	static void *pair(void *p_self, uint32_t p_a, PairingObject *, int, uint32_t p_b, PairingObject *, int) {
+		static_cast<PairingLog *>(p_self)->events.push_back((uint64_t(p_a) << 32) | p_b);
+		return nullptr;
+	}
+
+	static void unpair(void *p_self, uint32_t p_a, PairingObject *, int, uint32_t p_b, PairingObject *, int, void *) {
+		// Flag unpairs with the top bit so they can't be mistaken for pairs.
+		static_cast<PairingLog *>(p_self)->events.push_back((uint64_t(p_a) << 32) | p_b | (uint64_t(1) << 63));
+	}
+};
+
+static void run_pairing_simulation(uint32_t p_parallel_threshold, PairingLog &r_log) {
+	const uint32_t object_count = 2000;
+
+	LocalVector<PairingObject> objects;
+	objects.resize(object_count);
+
+	PairingBVH bvh;
+	bvh.set_pair_callback(&PairingLog::pair, &r_log);
+	bvh.set_unpair_callback(&PairingLog::unpair, &r_log);
+	bvh.params_set_parallel_pairing_threshold(p_parallel_threshold);
+
+	RandomPCG rng(12345);
+	LocalVector<BVHHandle> handles;
+	LocalVector<Vector3> positions;
+
+	for (uint32_t i = 0; i < object_count; i++) {
+		objects[i].layer = 1 << (i % 3);
+		Vector3 position(rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f));
+		positions.push_back(position);
+		// The first quarter goes in the static tree, which only checks against the dynamic one.
+		bool is_static = i < object_count / 4;
+		handles.push_back(bvh.create(&objects[i], true, is_static ? 0 : 1, is_static ? 2 : 3, AABB(position, Vector3(2, 2, 2))));
+	}
+	bvh.update();
+
+	for (int step = 0; step < 10; step++) {
+		for (uint32_t i = object_count / 4; i < object_count; i++) {
+			positions[i] += Vector3(rng.random(-3.0f, 3.0f), rng.random(-3.0f, 3.0f), rng.random(-3.0f, 3.0f));
+			bvh.move(handles[i], AABB(positions[i], Vector3(2, 2, 2)));
+		}
+		bvh.update();
+	}
+
+	for (const BVHHandle &handle : handles) {
+		bvh.erase(handle);
+	}
+}
+
+TEST_CASE("[BVH] Parallel pairing matches serial pairing") {
+	PairingLog serial;
+	run_pairing_simulation(0, serial);
+
+	PairingLog parallel;
+	run_pairing_simulation(1, parallel);
+
+	CHECK_MESSAGE(serial.events.size() > 0, "The simulation should produce pairs.");
+	REQUIRE(parallel.events.size() == serial.events.size());
+
+	bool same_order = true;
+	for (uint32_t i = 0; i < serial.events.size(); i++) {
+		if (parallel.events[i] != serial.events[i]) {
+			same_order = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(same_order, "Pair and unpair callbacks should be sent in the same order.");
+}
+
+TEST_CASE("[BVH] Culling into own hit buffers matches the shared culls") {
+	const uint32_t object_count = 500;
+
+	LocalVector<PairingObject> objects;
+	objects.resize(object_count);
+
+	PairingBVH bvh;
+	RandomPCG rng(54321);
+
+	for (uint32_t i = 0; i < object_count; i++) {
+		Vector3 position(rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f));
+		bool is_static = i < object_count / 4;
+		bvh.create(&objects[i], true, is_static ? 0 : 1, is_static ? 2 : 3, AABB(position, Vector3(2, 2, 2)), i);
+	}
+	bvh.update();
+
+	const int result_max = 64;
+	PairingObject *results[result_max];
+	PairingObject *own_results[result_max];
+	int subindices[result_max];
+	int own_subindices[result_max];
+	LocalVector<uint32_t> hits;
+
+	bool same_segments = true;
+	bool same_aabbs = true;
+	int total_hits = 0;
+	for (int query = 0; query < 100; query++) {
+		Vector3 from(rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f));
+		Vector3 to(rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f));
+
+		int count = bvh.cull_segment(from, to, results, result_max, nullptr, 0xFFFFFFFF, subindices);
+		int own_count = bvh.cull_segment_hits(from, to, own_results, result_max, nullptr, hits, 0xFFFFFFFF, own_subindices);
+		total_hits += count;
+		if (count != own_count || memcmp(results, own_results, count * sizeof(PairingObject *)) != 0 || memcmp(subindices, own_subindices, count * sizeof(int)) != 0) {
+			same_segments = false;
+		}
+
+		AABB aabb(from, Vector3(10, 10, 10));
+		count = bvh.cull_aabb(aabb, results, result_max, nullptr, 0xFFFFFFFF, subindices);
+		own_count = bvh.cull_aabb_hits(aabb, own_results, result_max, nullptr, hits, 0xFFFFFFFF, own_subindices);
+		total_hits += count;
+		if (count != own_count || memcmp(results, own_results, count * sizeof(PairingObject *)) != 0 || memcmp(subindices, own_subindices, count * sizeof(int)) != 0) {
+			same_aabbs = false;
+		}
+	}
+
+	CHECK_MESSAGE(total_hits > 0, "The queries should hit some objects.");
+	CHECK_MESSAGE(same_segments, "Segment culls should find the same objects in the same order.");
+	CHECK_MESSAGE(same_aabbs, "AABB culls should find the same objects in the same order.");
+}
+
+} // namespace TestBVH
@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/message_queue.h"
+#include "core/object/object.h"
+#include "core/os/thread.h"
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class CallRecorder : public Object {
+public:
+	LocalVector<int> calls;
+	CallQueue *queue = nullptr;
+
+	void record(int p_value) {
+		calls.push_back(p_value);
+	}
+
+	void record_and_push(int p_value) {
+		calls.push_back(p_value);
+		queue->push_callable(callable_mp(this, &CallRecorder::record), p_value + 1);
+	}
+
+	void record_and_clear(int p_value) {
+		calls.push_back(p_value);
+		queue->clear();
+	}
+};
+
+struct PushData {
+	CallQueue *queue = nullptr;
+	CallRecorder *recorder = nullptr;
+	int first = 0;
+	int count = 0;
+};
+
+static void push_from_thread(void *p_data) {
+	PushData *data = static_cast<PushData *>(p_data);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable_mp(data->recorder, &CallRecorder::record), data->first + i);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls from several threads run in submission order") {
+	CallQueue queue;
+	CallRecorder recorder;
+
+	// Alternate between the main thread and fresh threads, so every run of calls lands on a different shard.
+	int next = 0;
+	for (int round = 0; round < 4; round++) {
+		for (int i = 0; i < 100; i++) {
+			queue.push_callable(callable_mp(&recorder, &CallRecorder::record), next++);
+		}
+
+		PushData data;
+		data.queue = &queue;
+		data.recorder = &recorder;
+		data.first = next;
+		data.count = 1000; // Spans several pages.
+		Thread thread;
+		thread.start(&push_from_thread, &data);
+		thread.wait_to_finish();
+		next += data.count;
+	}
+
+	CHECK(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+
+	REQUIRE(recorder.calls.size() == (uint32_t)next);
+	bool in_order = true;
+	for (int i = 0; i < next; i++) {
+		in_order = in_order && recorder.calls[i] == i;
+	}
+	CHECK_MESSAGE(in_order, "Calls should run in the order they were pushed, regardless of the pushing thread.");
+}
+
+TEST_CASE("[MessageQueue] Concurrent producers") {
+	const int thread_count = 4;
+	const int calls_per_thread = 5000;
+
+	CallQueue queue;
+	CallRecorder recorder;
+
+	Thread threads[thread_count];
+	PushData data[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].queue = &queue;
+		data[i].recorder = &recorder;
+		data[i].first = i * calls_per_thread;
+		data[i].count = calls_per_thread;
+		threads[i].start(&push_from_thread, &data[i]);
+	}
+
+	// Flushing while the other threads keep pushing.
+	while (recorder.calls.size() < (uint32_t)(thread_count * calls_per_thread)) {
+		queue.flush();
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	queue.flush();
+
+	REQUIRE(recorder.calls.size() == (uint32_t)(thread_count * calls_per_thread));
+	int last[thread_count] = { -1, -1, -1, -1 };
+	bool in_order = true;
+	for (int value : recorder.calls) {
+		int producer = value / calls_per_thread;
+		in_order = in_order && value > last[producer];
+		last[producer] = value;
+	}
+	CHECK_MESSAGE(in_order, "Calls from the same thread should keep their order.");
+}
+
+TEST_CASE("[MessageQueue] Pushing and clearing while flushing") {
+	CallQueue queue;
+	CallRecorder recorder;
+	recorder.queue = &queue;
+
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record_and_push), 0);
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record), 10);
+	queue.flush();
+
+	REQUIRE(recorder.calls.size() == 3);
+	CHECK_MESSAGE(recorder.calls[0] == 0, "Queued calls run first.");
+	CHECK_MESSAGE(recorder.calls[1] == 10, "Queued calls run first.");
+	CHECK_MESSAGE(recorder.calls[2] == 1, "Calls pushed during a flush run in the same flush.");
+
+	recorder.calls.clear();
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record_and_clear), 0);
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record), 1);
+	queue.flush();
+
+	CHECK_MESSAGE(recorder.calls.size() == 1, "Clearing during a flush drops the remaining calls.");
+	CHECK_FALSE(queue.has_messages());
+
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record), 2);
+	queue.flush();
+	CHECK_MESSAGE(recorder.calls.size() == 2, "Calls pushed after clearing run normally.");
+}
+
+TEST_CASE("[MessageQueue] Shards of exited threads are freed") {
+	CallQueue queue;
+	CallRecorder recorder;
+
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record), 0);
+	queue.flush();
+	const int usage_before = queue.get_max_buffer_usage();
+
+	PushData data;
+	data.queue = &queue;
+	data.recorder = &recorder;
+	data.first = 1;
+	data.count = 1000; // Spans several pages.
+	Thread thread;
+	thread.start(&push_from_thread, &data);
+	thread.wait_to_finish();
+	CHECK(queue.get_max_buffer_usage() > usage_before);
+
+	queue.flush();
+	CHECK_MESSAGE(recorder.calls.size() == 1001, "Calls pushed by a thread still run after it exits.");
+	CHECK_MESSAGE(queue.get_max_buffer_usage() == usage_before, "The pages of an exited thread should be freed once its calls have run.");
+
+	queue.push_callable(callable_mp(&recorder, &CallRecorder::record), 1001);
+	queue.flush();
+	CHECK_MESSAGE(recorder.calls.size() == 1002, "Threads that are still running keep their shard.");
+}
+
+} // namespace TestMessageQueue
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/memory.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Tag scopes nest") {
+	CHECK(Memory::get_current_tag() == Memory::TAG_UNTAGGED);
+	{
+		Memory::TagScope physics(Memory::TAG_PHYSICS);
+		{
+			Memory::TagScope script(Memory::TAG_SCRIPT);
+#ifdef MEMORY_TAGS_ENABLED
+			CHECK(Memory::get_current_tag() == Memory::TAG_SCRIPT);
+#endif
+		}
+#ifdef MEMORY_TAGS_ENABLED
+		CHECK(Memory::get_current_tag() == Memory::TAG_PHYSICS);
+#endif
+	}
+	CHECK(Memory::get_current_tag() == Memory::TAG_UNTAGGED);
+}
+
+#ifdef MEMORY_TAGS_ENABLED
+TEST_CASE("[Memory] Allocations are accounted to their tag") {
+	const uint64_t usage = Memory::get_tag_usage(Memory::TAG_AUDIO);
+	const uint64_t alloc_count = Memory::get_tag_alloc_count(Memory::TAG_AUDIO);
+
+	void *mem = nullptr;
+	{
+		Memory::TagScope tag(Memory::TAG_AUDIO);
+		mem = memalloc(1000);
+	}
+	CHECK(Memory::get_tag_usage(Memory::TAG_AUDIO) == usage + 1000);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_AUDIO) == alloc_count + 1);
+	CHECK(Memory::get_tag_max_usage(Memory::TAG_AUDIO) >= usage + 1000);
+
+	// Reallocating and freeing outside of the scope still goes to the tag the block was allocated with.
+	mem = memrealloc(mem, 3000);
+	CHECK(Memory::get_tag_usage(Memory::TAG_AUDIO) == usage + 3000);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_AUDIO) == alloc_count + 2);
+	mem = memrealloc(mem, 500);
+	CHECK(Memory::get_tag_usage(Memory::TAG_AUDIO) == usage + 500);
+
+	memfree(mem);
+	CHECK(Memory::get_tag_usage(Memory::TAG_AUDIO) == usage);
+}
+
+TEST_CASE("[Memory] Large allocations are sampled") {
+	Memory::set_large_alloc_sampling(1 << 20, 2);
+
+	void *small = nullptr;
+	void *large[3] = {};
+	{
+		Memory::TagScope tag(Memory::TAG_RESOURCES);
+		small = memalloc(1024);
+		for (int i = 0; i < 3; i++) {
+			large[i] = memalloc((2 + i) << 20);
+		}
+	}
+	Memory::set_large_alloc_sampling(0);
+
+	Memory::LargeAllocSample samples[Memory::MAX_LARGE_ALLOC_SAMPLES];
+	int sample_count = Memory::get_large_alloc_samples(samples, Memory::MAX_LARGE_ALLOC_SAMPLES);
+	REQUIRE(sample_count >= 2);
+	// Only every second large allocation is recorded, newest first.
+	CHECK(samples[0].bytes == (4 << 20));
+	CHECK(samples[0].tag == Memory::TAG_RESOURCES);
+	CHECK(samples[1].bytes == (2 << 20));
+	CHECK(samples[1].tag == Memory::TAG_RESOURCES);
+
+	memfree(small);
+	for (int i = 0; i < 3; i++) {
+		memfree(large[i]);
+	}
+}
+
+static void _record_task_tag(void *p_tag, uint32_t p_index) {
+	static_cast<Memory::Tag *>(p_tag)[p_index] = Memory::get_current_tag();
+}
+
+TEST_CASE("[Memory] Pool tasks are accounted to the tag they were added with") {
+	Memory::Tag tags[4] = { Memory::TAG_MAX, Memory::TAG_MAX, Memory::TAG_MAX, Memory::TAG_MAX };
+	WorkerThreadPool::TaskID task_id;
+	WorkerThreadPool::GroupID group_id;
+	{
+		Memory::TagScope tag(Memory::TAG_PHYSICS);
+		task_id = WorkerThreadPool::get_singleton()->add_native_task([](void *p_tag) { _record_task_tag(p_tag, 0); }, tags);
+		group_id = WorkerThreadPool::get_singleton()->add_native_group_task([](void *p_tag, uint32_t p_index) { _record_task_tag(p_tag, p_index + 1); }, tags, 2);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	// Pool threads don't keep the tag of their previous task.
+	task_id = WorkerThreadPool::get_singleton()->add_native_task([](void *p_tag) { _record_task_tag(p_tag, 3); }, tags);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+
+	CHECK(tags[0] == Memory::TAG_PHYSICS);
+	CHECK(tags[1] == Memory::TAG_PHYSICS);
+	CHECK(tags[2] == Memory::TAG_PHYSICS);
+	CHECK(tags[3] == Memory::TAG_UNTAGGED);
+}
+#endif // MEMORY_TAGS_ENABLED
+
+} // namespace TestMemory
@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  test_slab_allocator.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/os/slab_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestSlabAllocator {
+
+TEST_CASE("[SlabAllocator] Size classes") {
+	for (size_t bytes = 1; bytes <= SlabAllocator::MAX_BLOCK_SIZE; bytes++) {
+		uint32_t size_class = SlabAllocator::get_size_class(bytes);
+		REQUIRE(size_class < SlabAllocator::CLASS_COUNT);
+		CHECK(SlabAllocator::get_class_size(size_class) >= bytes);
+		if (size_class > 0) {
+			CHECK(SlabAllocator::get_class_size(size_class - 1) < bytes);
+		}
+		CHECK(SlabAllocator::get_class_size(size_class) % 16 == 0);
+	}
+	CHECK(SlabAllocator::get_class_size(SlabAllocator::CLASS_COUNT - 1) == SlabAllocator::MAX_BLOCK_SIZE);
+}
+
+TEST_CASE("[SlabAllocator] Blocks are distinct and reused") {
+	const uint32_t size_class = SlabAllocator::get_size_class(48);
+	const size_t class_size = SlabAllocator::get_class_size(size_class);
+
+	LocalVector<uint8_t *> blocks;
+	for (int i = 0; i < 1000; i++) {
+		uint8_t *block = (uint8_t *)SlabAllocator::alloc(size_class);
+		REQUIRE(block != nullptr);
+		CHECK(uintptr_t(block) % 16 == 0);
+		memset(block, i & 0xFF, class_size);
+		blocks.push_back(block);
+	}
+	bool intact = true;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		for (size_t j = 0; j < class_size; j++) {
+			intact = intact && blocks[i][j] == (i & 0xFF);
+		}
+	}
+	CHECK_MESSAGE(intact, "Blocks must not overlap.");
+	CHECK(SlabAllocator::get_reserved_bytes() >= 1000 * class_size);
+
+	// The thread cache hands back the last freed block first.
+	uint8_t *last = blocks[blocks.size() - 1];
+	SlabAllocator::free(last, size_class);
+	CHECK(SlabAllocator::alloc(size_class) == last);
+
+	const uint64_t reserved = SlabAllocator::get_reserved_bytes();
+	for (uint8_t *block : blocks) {
+		SlabAllocator::free(block, size_class);
+	}
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		blocks[i] = (uint8_t *)SlabAllocator::alloc(size_class);
+	}
+	CHECK_MESSAGE(SlabAllocator::get_reserved_bytes() == reserved, "Freed blocks should be reused before reserving new slabs.");
+	for (uint8_t *block : blocks) {
+		SlabAllocator::free(block, size_class);
+	}
+}
+
+TEST_CASE("[SlabAllocator] Blocks freed on another thread are reused") {
+	const uint32_t size_class = SlabAllocator::get_size_class(500);
+
+	struct Data {
+		uint32_t size_class = 0;
+		LocalVector<void *> blocks;
+	} data;
+	data.size_class = size_class;
+
+	HashSet<void *> freed;
+	for (int i = 0; i < 5000; i++) {
+		data.blocks.push_back(SlabAllocator::alloc(size_class));
+		freed.insert(data.blocks[i]);
+	}
+
+	Thread thread;
+	thread.start([](void *p_userdata) {
+		Data *d = (Data *)p_userdata;
+		for (void *block : d->blocks) {
+			SlabAllocator::free(block, d->size_class);
+		}
+	},
+			&data);
+	thread.wait_to_finish();
+
+	// The freeing thread gave its cached blocks back when it exited. Only the few blocks this
+	// thread still had cached before can come first.
+	int reused = 0;
+	for (uint32_t i = 0; i < data.blocks.size(); i++) {
+		data.blocks[i] = SlabAllocator::alloc(size_class);
+		reused += freed.has(data.blocks[i]) ? 1 : 0;
+	}
+	CHECK(reused >= 5000 - 16);
+	for (void *block : data.blocks) {
+		SlabAllocator::free(block, size_class);
+	}
+}
+
+#ifdef SLAB_ALLOCATOR_ENABLED
+TEST_CASE("[SlabAllocator] Memory reallocates across size classes") {
+	uint8_t *mem = (uint8_t *)memalloc(24);
+	for (int i = 0; i < 24; i++) {
+		mem[i] = i;
+	}
+	// Within the same class, then to a bigger class, then out of the slabs and back.
+	const size_t sizes[] = { 30, 100, 4000, 64 };
+	size_t prev_size = 24;
+	for (size_t size : sizes) {
+		mem = (uint8_t *)memrealloc(mem, size);
+		REQUIRE(mem != nullptr);
+		bool preserved = true;
+		for (size_t i = 0; i < MIN(prev_size, size); i++) {
+			preserved = preserved && mem[i] == (i < 24 ? i : 0xAB);
+		}
+		CHECK(preserved);
+		for (size_t i = prev_size; i < size; i++) {
+			mem[i] = 0xAB;
+		}
+		prev_size = size;
+	}
+	memfree(mem);
+
+	uint64_t *zeroed = (uint64_t *)memalloc_zeroed(sizeof(uint64_t) * 8);
+	bool zero = true;
+	for (int i = 0; i < 8; i++) {
+		zero = zero && zeroed[i] == 0;
+	}
+	CHECK(zero);
+	memfree(zeroed);
+
+	// Blocks keep working when the allocator is turned off in between.
+	void *slab_block = memalloc(32);
+	SlabAllocator::set_enabled(false);
+	void *system_block = memalloc(32);
+	memfree(slab_block);
+	SlabAllocator::set_enabled(true);
+	memfree(system_block);
+}
+#endif // SLAB_ALLOCATOR_ENABLED
+
+} // namespace TestSlabAllocator
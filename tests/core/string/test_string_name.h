@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/print_string.h"
+#include "core/string/string_name.h"
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+struct InternData {
+	const LocalVector<String> *names = nullptr;
+	LocalVector<StringName> interned;
+	int rounds = 1;
+};
+
+static void intern_names(void *p_userdata) {
+	InternData *data = static_cast<InternData *>(p_userdata);
+	for (int round = 0; round < data->rounds; round++) {
+		data->interned.clear();
+		for (const String &name : *data->names) {
+			data->interned.push_back(StringName(name));
+		}
+	}
+}
+
+TEST_CASE("[StringName] Interning is unique") {
+	const StringName a = "test_string_name_unique";
+	const StringName b = String("test_string_name_unique");
+	const StringName c = "test_string_name_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == "test_string_name_unique");
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Many names stay distinct and can be found again") {
+	// More names than the initial bucket arrays hold, so the table has to grow.
+	const int count = 200000;
+
+	LocalVector<StringName> names;
+	for (int i = 0; i < count; i++) {
+		names.push_back(StringName("test_string_name_" + itos(i)));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const StringName again = StringName("test_string_name_" + itos(i));
+		if (again.data_unique_pointer() != names[i].data_unique_pointer() || again != names[i]) {
+			all_found = false;
+			break;
+		}
+	}
+	CHECK(all_found);
+
+	// Release every other name, then check the remaining ones are still there.
+	for (int i = 0; i < count; i += 2) {
+		names[i] = StringName();
+	}
+	bool remaining_found = true;
+	for (int i = 1; i < count; i += 2) {
+		if (StringName("test_string_name_" + itos(i)).data_unique_pointer() != names[i].data_unique_pointer()) {
+			remaining_found = false;
+			break;
+		}
+	}
+	CHECK(remaining_found);
+}
+
+TEST_CASE("[StringName] Interning from several threads gives the same names") {
+	const int thread_count = 8;
+
+	LocalVector<String> names;
+	for (int i = 0; i < 5000; i++) {
+		names.push_back("test_string_name_thread_" + itos(i));
+	}
+
+	InternData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].names = &names;
+		data[i].rounds = 4;
+		threads[i].start(&intern_names, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	bool same = true;
+	for (int i = 1; i < thread_count; i++) {
+		for (uint32_t j = 0; j < names.size(); j++) {
+			if (data[i].interned[j].data_unique_pointer() != data[0].interned[j].data_unique_pointer()) {
+				same = false;
+			}
+		}
+	}
+	CHECK_MESSAGE(same, "Every thread should get the same StringName for the same string.");
+	CHECK(String(data[thread_count - 1].interned[42]) == names[42]);
+}
+
+TEST_CASE_BENCHMARK("[StringName] Interning contention") {
+	const int ROUNDS = 20;
+
+	// A mix of names shared by all threads and names only one thread uses,
+	// so both lookups of existing names and first interning are measured.
+	LocalVector<String> shared_names;
+	for (int i = 0; i < 2000; i++) {
+		shared_names.push_back("benchmark_shared_" + itos(i));
+	}
+
+	const int MAX_THREADS = 32;
+	InternData data[MAX_THREADS];
+	Thread threads[MAX_THREADS];
+
+	for (int thread_count = 1; thread_count <= MAX_THREADS; thread_count *= 2) {
+		LocalVector<LocalVector<String>> names;
+		names.resize(thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			names[i] = shared_names;
+			for (int j = 0; j < 2000; j++) {
+				names[i].push_back("benchmark_thread_" + itos(i) + "_" + itos(j));
+			}
+		}
+
+		const double msec = benchmark_msec(1, [&]() {
+			for (int i = 0; i < thread_count; i++) {
+				data[i].names = &names[i];
+				data[i].rounds = ROUNDS;
+				threads[i].start(&intern_names, &data[i]);
+			}
+			for (int i = 0; i < thread_count; i++) {
+				threads[i].wait_to_finish();
+			}
+		});
+
+		uint64_t interned = uint64_t(thread_count) * ROUNDS * names[0].size();
+		print_line(vformat("StringName interning, %d threads: %.3f ms, %.1f M names/s.",
+				thread_count, msec, double(interned) / msec / 1000.0));
+	}
+}
+
+} // namespace TestStringName
@@ -36,6 +36,7 @@
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/safe_refcount.h"
 #include "tests/test_macros.h"
 
 namespace TestCommandQueue {
@@ -560,4 +561,138 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+class MultiProducerState {
+public:
+	static const int PRODUCER_COUNT = 4;
+	static const int COMMANDS_PER_PRODUCER = 20000;
+
+	CommandQueueMT command_queue;
+	SafeFlag exit_consumer;
+
+	// Only touched by the consumer.
+	int64_t last_sequence[PRODUCER_COUNT];
+	int received = 0;
+	int order_errors = 0;
+
+	SafeNumeric<int> return_errors;
+
+	void receive(int p_producer, int64_t p_sequence) {
+		if (p_sequence != last_sequence[p_producer] + 1) {
+			order_errors++;
+		}
+		last_sequence[p_producer] = p_sequence;
+		received++;
+	}
+
+	void receive_large(int p_producer, int64_t p_sequence, Transform3D p_t1, Transform3D p_t2, Transform3D p_t3) {
+		receive(p_producer, p_sequence);
+	}
+
+	int64_t receive_and_ret(int p_producer, int64_t p_sequence) {
+		receive(p_producer, p_sequence);
+		return p_sequence * 2;
+	}
+
+	struct ProducerData {
+		MultiProducerState *state = nullptr;
+		int index = 0;
+	};
+
+	static void producer_loop(void *p_data) {
+		ProducerData *data = static_cast<ProducerData *>(p_data);
+		MultiProducerState *state = data->state;
+		Transform3D tr;
+		for (int64_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			switch ((i + data->index) % 50) {
+				case 0: {
+					state->command_queue.push_and_sync(state, &MultiProducerState::receive, data->index, i);
+				} break;
+				case 1: {
+					int64_t ret = 0;
+					state->command_queue.push_and_ret(state, &MultiProducerState::receive_and_ret, &ret, data->index, i);
+					if (ret != i * 2) {
+						state->return_errors.increment();
+					}
+				} break;
+				case 2:
+				case 3:
+				case 4: {
+					state->command_queue.push(state, &MultiProducerState::receive_large, data->index, i, tr, tr, tr);
+				} break;
+				default: {
+					state->command_queue.push(state, &MultiProducerState::receive, data->index, i);
+				} break;
+			}
+		}
+	}
+
+	static void consumer_loop(void *p_data) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_data);
+		while (!state->exit_consumer.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+
+	MultiProducerState() {
+		for (int i = 0; i < PRODUCER_COUNT; i++) {
+			last_sequence[i] = -1;
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Multiple producers keep their own order") {
+	MultiProducerState state;
+
+	Thread consumer;
+	consumer.start(&MultiProducerState::consumer_loop, &state);
+
+	Thread producers[MultiProducerState::PRODUCER_COUNT];
+	MultiProducerState::ProducerData producer_data[MultiProducerState::PRODUCER_COUNT];
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		producer_data[i].state = &state;
+		producer_data[i].index = i;
+		producers[i].start(&MultiProducerState::producer_loop, &producer_data[i]);
+	}
+	for (int i = 0; i < MultiProducerState::PRODUCER_COUNT; i++) {
+		producers[i].wait_to_finish();
+	}
+
+	state.exit_consumer.set();
+	consumer.wait_to_finish();
+
+	CHECK_MESSAGE(state.received == MultiProducerState::PRODUCER_COUNT * MultiProducerState::COMMANDS_PER_PRODUCER,
+			"Every command pushed should have been run exactly once.");
+	CHECK_MESSAGE(state.order_errors == 0,
+			"Commands from the same producer should run in the order they were pushed.");
+	CHECK_MESSAGE(state.return_errors.get() == 0,
+			"Commands with return values should have returned the right value.");
+}
+
+TEST_CASE("[CommandQueue] Flushing from the pushing thread and stats") {
+	SharedThreadState sts;
+
+	uint32_t max_commands_per_flush = 0;
+	uint64_t stall_usec = 0;
+	CommandQueueMT::get_and_reset_stats(max_commands_per_flush, stall_usec);
+
+	// Enough commands to span several blocks.
+	const int count = 10000;
+	Transform3D tr;
+	for (int i = 0; i < count; i++) {
+		sts.command_queue.push(&sts, &SharedThreadState::func3, tr, tr, tr, tr, tr, tr);
+	}
+	CHECK(sts.func1_count == 0);
+	sts.command_queue.flush_if_pending();
+	CHECK(sts.func1_count == count);
+
+	sts.command_queue.flush_all();
+	CHECK_MESSAGE(sts.func1_count == count,
+			"Flushing an empty queue should do nothing.");
+
+	CommandQueueMT::get_and_reset_stats(max_commands_per_flush, stall_usec);
+	CHECK(max_commands_per_flush >= (uint32_t)count);
+}
+
 } // namespace TestCommandQueue
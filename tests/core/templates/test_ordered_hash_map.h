@@ -0,0 +1,271 @@
+/**************************************************************************/
+/*  test_ordered_hash_map.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/ordered_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOrderedHashMap {
+
+TEST_CASE("[OrderedHashMap] List initialization") {
+	OrderedHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[OrderedHashMap] Insert, overwrite and erase") {
+	OrderedHashMap<int, int> map;
+	OrderedHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map.has(42));
+
+	map.insert(42, 1234);
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+
+	map.remove(map.find(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+	CHECK(map.getptr(42) == nullptr);
+}
+
+TEST_CASE("[OrderedHashMap] Order is kept when erasing and inserting again") {
+	OrderedHashMap<int, int> map;
+	for (int i = 0; i < 6; i++) {
+		map.insert(i, i * 10);
+	}
+	map.erase(1);
+	map.erase(3);
+	map.insert(1, 100);
+	map.insert(4, 400);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(0, 0));
+	expected.push_back(Pair<int, int>(2, 20));
+	expected.push_back(Pair<int, int>(4, 400));
+	expected.push_back(Pair<int, int>(5, 50));
+	expected.push_back(Pair<int, int>(1, 100));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+	CHECK(idx == expected.size());
+}
+
+TEST_CASE("[OrderedHashMap] Insert, iterate and remove many elements") {
+	// Enough elements to go past the small linear scan and through several chunks.
+	const int elem_max = 1234;
+	OrderedHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	int idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		CHECK(map.has(idx));
+		idx++;
+	}
+
+	Vector<int> elems_still_valid;
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) != 0) {
+			map.erase(i);
+		} else {
+			elems_still_valid.push_back(i);
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(elems_still_valid[idx] == K.key);
+		idx++;
+	}
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(map.has(i) == ((i % 5) == 0));
+	}
+}
+
+TEST_CASE("[OrderedHashMap] Inserting keeps pointers to existing values") {
+	OrderedHashMap<int, String> map;
+	map[0] = "zero";
+	String *zero = &map[0];
+
+	for (int i = 1; i < 500; i++) {
+		map[i] = itos(i);
+	}
+
+	CHECK(zero == map.getptr(0));
+	CHECK(*zero == "zero");
+}
+
+TEST_CASE("[OrderedHashMap] Erasing keeps pointers to the other values") {
+	OrderedHashMap<int, String> map;
+	for (int i = 0; i < 500; i++) {
+		map[i] = itos(i);
+	}
+	String *last = map.getptr(499);
+
+	// Erase while iterating, like Dictionary users filtering their own contents. Few enough to keep the holes.
+	for (const KeyValue<int, String> &E : map) {
+		if (E.key % 5 == 0) {
+			map.erase(E.key);
+		}
+	}
+
+	CHECK(map.size() == 400);
+	CHECK(last == map.getptr(499));
+	CHECK(*last == "499");
+}
+
+TEST_CASE("[OrderedHashMap] Inserting into a full map with holes keeps pointers") {
+	OrderedHashMap<int, String> map;
+	int key = 0;
+	while (map.size() < map.get_capacity() || map.size() < 100) {
+		map[key] = itos(key);
+		key++;
+	}
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 0; i < key; i += 3) {
+		map.erase(i);
+	}
+	String *one = map.getptr(1);
+	String *last = map.getptr(key - 1);
+
+	// The first insertion needs more space than the holes left behind. Copy a value from the map, like `d[a] = d[b]`.
+	for (int i = 0; i < 50; i++) {
+		map[key + i] = *map.getptr(1);
+	}
+
+	CHECK(map.get_capacity() > capacity);
+	CHECK(one == map.getptr(1));
+	CHECK(last == map.getptr(key - 1));
+	CHECK(*one == "1");
+	CHECK(*last == itos(key - 1));
+	CHECK(map[key + 49] == "1");
+}
+
+TEST_CASE("[OrderedHashMap] Erasing half of the pairs packs the holes") {
+	OrderedHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map[i] = itos(i);
+	}
+	const uint32_t capacity = map.get_capacity();
+	LocalVector<int> expected;
+	for (int i = 0; i < 100; i++) {
+		if (i % 4 == 1) {
+			expected.push_back(i);
+		} else {
+			map.erase(i);
+		}
+	}
+
+	// Keys that keep changing reuse the packed space instead of growing the map.
+	for (int i = 0; i < 1000; i++) {
+		map.insert(100 + i, itos(100 + i));
+		map.erase(100 + i);
+	}
+	map.insert(1000, *map.getptr(1));
+	expected.push_back(1000);
+
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map[1000] == "1");
+	CHECK(map.size() == expected.size());
+	uint32_t idx = 0;
+	for (const KeyValue<int, String> &E : map) {
+		CHECK(E.key == expected[idx]);
+		CHECK(E.value == itos(E.key == 1000 ? 1 : E.key));
+		idx++;
+	}
+}
+
+TEST_CASE("[OrderedHashMap] Copy and clear") {
+	OrderedHashMap<int, String> map;
+	for (int i = 0; i < 20; i++) {
+		map.insert(i, itos(i));
+	}
+	for (int i = 0; i < 20; i += 2) {
+		map.erase(i);
+	}
+
+	OrderedHashMap<int, String> copy = map;
+	CHECK(copy.size() == 10);
+	int idx = 1;
+	for (const KeyValue<int, String> &E : copy) {
+		CHECK(E.key == idx);
+		CHECK(E.value == itos(idx));
+		idx += 2;
+	}
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(1));
+	CHECK(copy.has(1));
+	map.insert(7, "7");
+	CHECK(map[7] == "7");
+}
+
+TEST_CASE("[OrderedHashMap] Sort") {
+	OrderedHashMap<int, int> map;
+	const int keys[] = { 12, 3, 45, 7, 30, 1, 99, 18, 5, 60 };
+	for (int key : keys) {
+		map.insert(key, -key);
+	}
+	map.erase(45);
+	map.sort();
+
+	int previous = -1;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key > previous);
+		CHECK(E.value == -E.key);
+		previous = E.key;
+	}
+	CHECK(map.size() == 9);
+	CHECK(map.has(99));
+	CHECK(!map.has(45));
+}
+
+} // namespace TestOrderedHashMap
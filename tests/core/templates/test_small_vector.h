@@ -0,0 +1,215 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "core/templates/small_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] Inline elements") {
+	SmallVector<String, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+
+	vector.push_back("a");
+	vector.push_back("c");
+	vector.insert(1, "b");
+	vector.push_back("d");
+	CHECK(vector.size() == 4);
+	CHECK(vector.is_inline());
+	CHECK(vector[0] == "a");
+	CHECK(vector[1] == "b");
+	CHECK(vector[2] == "c");
+	CHECK(vector[3] == "d");
+
+	vector.remove_at(0);
+	CHECK(vector.erase("c"));
+	CHECK(!vector.erase("x"));
+	CHECK(vector.size() == 2);
+	CHECK(vector[0] == "b");
+	CHECK(vector[1] == "d");
+	CHECK(vector.find("d") == 1);
+
+	vector.reverse();
+	CHECK(vector[0] == "d");
+	vector.resize(3);
+	CHECK(vector[2].is_empty());
+	vector.clear();
+	CHECK(vector.is_empty());
+}
+
+TEST_CASE("[SmallVector] Spill to the heap and back") {
+	SmallVector<int, 2> vector;
+	for (int i = 0; i < 10; i++) {
+		vector.push_back(i);
+	}
+	CHECK(!vector.is_inline());
+	CHECK(vector.size() == 10);
+	for (int i = 0; i < 10; i++) {
+		CHECK(vector[i] == i);
+	}
+
+	vector.insert(0, -1);
+	CHECK(vector[0] == -1);
+	CHECK(vector[10] == 9);
+
+	vector.clear();
+	CHECK(vector.is_inline());
+	vector.push_back(5);
+	CHECK(vector.is_inline());
+	CHECK(vector[0] == 5);
+
+	// Inserting into a full inline vector spills it.
+	vector.push_back(6);
+	vector.insert(1, 7);
+	CHECK(!vector.is_inline());
+	CHECK(vector[0] == 5);
+	CHECK(vector[1] == 7);
+	CHECK(vector[2] == 6);
+}
+
+TEST_CASE("[SmallVector] Copies are independent") {
+	SmallVector<String, 2> small;
+	small.push_back("a");
+	SmallVector<String, 2> small_copy = small;
+	small_copy.set(0, "b");
+	CHECK(small[0] == "a");
+	CHECK(small_copy[0] == "b");
+
+	SmallVector<String, 2> big;
+	for (int i = 0; i < 5; i++) {
+		big.push_back(itos(i));
+	}
+	SmallVector<String, 2> big_copy;
+	big_copy = big;
+	CHECK(big_copy.ptr() == big.ptr()); // Shared until written.
+	big_copy.ptrw()[0] = "x";
+	CHECK(big[0] == "0");
+	CHECK(big_copy[0] == "x");
+
+	big.append_array(big);
+	CHECK(big.size() == 10);
+	CHECK(big[5] == "0");
+}
+
+TEST_CASE("[SmallVector] Sort") {
+	SmallVector<int, 4> vector = { 3, 1, 2 };
+	vector.sort_custom<Comparator<int>>();
+	CHECK(vector[0] == 1);
+	CHECK(vector[1] == 2);
+	CHECK(vector[2] == 3);
+	CHECK(vector.bsearch_custom<Comparator<int>>(2, true) == 1);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[SmallVector] Small arrays don't allocate elements") {
+	uint64_t begin = Memory::get_alloc_count();
+	{
+		SmallVector<Variant, 4> vector;
+		vector.push_back(1);
+		vector.push_back(2.0);
+		vector.push_back(Vector2(1, 2));
+		SmallVector<Variant, 4> copy = vector;
+		CHECK(copy.size() == 3);
+	}
+	CHECK(Memory::get_alloc_count() == begin);
+
+	begin = Memory::get_alloc_count();
+	{
+		Array array;
+		array.push_back(1);
+		array.push_back(2);
+		Array copy = array.duplicate();
+		CHECK(copy.size() == 2);
+	}
+	// One allocation for each Array, none for their elements.
+	CHECK(Memory::get_alloc_count() - begin == 2);
+
+	Array array = { 1, 2, 3, 4 };
+	begin = Memory::get_alloc_count();
+	array.push_back(5);
+	// Growing past the inline capacity moves the elements to the heap.
+	CHECK(Memory::get_alloc_count() - begin == 1);
+	CHECK(array.size() == 5);
+	CHECK(array[0] == Variant(1));
+	CHECK(array[4] == Variant(5));
+}
+#endif
+
+template <typename V>
+static void benchmark_allocations(const char *p_name, int p_elements, int p_iterations) {
+	uint64_t allocs = Memory::get_alloc_count();
+	const double msec = benchmark_msec(p_iterations, [&]() {
+		V vector;
+		for (int j = 0; j < p_elements; j++) {
+			vector.push_back(Variant(j));
+		}
+		V copy = vector;
+		copy.set(0, Variant());
+	});
+	allocs = Memory::get_alloc_count() - allocs;
+	print_line(vformat("%s, %d elements: %.2f allocations and %.1f ns per build and copy.",
+			p_name, p_elements, double(allocs) / p_iterations, msec * 1000000.0));
+}
+
+static void benchmark_array_allocations(int p_elements, int p_iterations) {
+	uint64_t allocs = Memory::get_alloc_count();
+	const double msec = benchmark_msec(p_iterations, [&]() {
+		Array array;
+		for (int j = 0; j < p_elements; j++) {
+			array.push_back(j);
+		}
+		Array copy = array.duplicate();
+		copy[0] = Variant();
+	});
+	allocs = Memory::get_alloc_count() - allocs;
+	print_line(vformat("Array, %d elements: %.2f allocations and %.1f ns per build and duplicate.",
+			p_elements, double(allocs) / p_iterations, msec * 1000000.0));
+}
+
+// Allocation counts are only available in debug builds.
+TEST_CASE_BENCHMARK("[SmallVector] Allocations per operation") {
+	const int ITERATIONS = 200000;
+	for (int elements = 1; elements <= 8; elements *= 2) {
+		benchmark_allocations<Vector<Variant>>("Vector<Variant>", elements, ITERATIONS);
+		benchmark_allocations<SmallVector<Variant, 4>>("SmallVector<Variant, 4>", elements, ITERATIONS);
+		benchmark_array_allocations(elements, ITERATIONS);
+	}
+}
+
+} // namespace TestSmallVector
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_frame_task_graph.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/frame_task_graph.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameTaskGraph {
+
+struct StageLog {
+	Mutex mutex;
+	LocalVector<int> order;
+	SafeNumeric<int> active;
+	SafeFlag overlapped;
+	SafeFlag wrong_thread;
+	Thread::ID main_thread_id = Thread::UNASSIGNED_ID;
+};
+
+static StageLog *stage_log = nullptr;
+
+static void log_stage(int p_id) {
+	OS::get_singleton()->delay_usec(200);
+	MutexLock lock(stage_log->mutex);
+	stage_log->order.push_back(p_id);
+}
+
+static void log_main_thread_stage(int p_id) {
+	if (Thread::get_caller_id() != stage_log->main_thread_id) {
+		stage_log->wrong_thread.set();
+	}
+	log_stage(p_id);
+}
+
+static void log_exclusive_stage(int p_id) {
+	if (stage_log->active.increment() != 1) {
+		stage_log->overlapped.set();
+	}
+	log_stage(p_id);
+	stage_log->active.decrement();
+}
+
+static void log_shared_stage(int p_id) {
+	stage_log->active.increment();
+	log_stage(p_id);
+	stage_log->active.decrement();
+}
+
+static int64_t find_stage(int p_id) {
+	return stage_log->order.find(p_id);
+}
+
+TEST_CASE("[FrameTaskGraph] Hazards keep registration order") {
+	StageLog log;
+	stage_log = &log;
+
+	FrameTaskGraph graph;
+	for (int run = 0; run < 2; run++) {
+		log.order.clear();
+
+		graph.add_stage("Write A", callable_mp_static(&log_stage).bind(0), {}, { "a" });
+		graph.add_stage("Read A", callable_mp_static(&log_stage).bind(1), { "a" }, {});
+		graph.add_stage("Read A again", callable_mp_static(&log_stage).bind(2), { "a" }, {});
+		graph.add_stage("Write A after read", callable_mp_static(&log_stage).bind(3), {}, { "a" });
+		graph.add_stage("Write B", callable_mp_static(&log_stage).bind(4), {}, { "b" });
+		graph.add_stage("Read A and B", callable_mp_static(&log_stage).bind(5), { "a", "b" }, {});
+		CHECK(graph.get_stage_count() == 6);
+
+		graph.run();
+
+		REQUIRE(log.order.size() == 6);
+		// Read after write.
+		CHECK(find_stage(0) < find_stage(1));
+		CHECK(find_stage(0) < find_stage(2));
+		// Write after read.
+		CHECK(find_stage(1) < find_stage(3));
+		CHECK(find_stage(2) < find_stage(3));
+		CHECK(find_stage(3) < find_stage(5));
+		CHECK(find_stage(4) < find_stage(5));
+
+		// The graph can be reused once cleared.
+		graph.clear();
+		CHECK(graph.get_stage_count() == 0);
+	}
+
+	stage_log = nullptr;
+}
+
+TEST_CASE("[FrameTaskGraph] Main thread and exclusive stages") {
+	StageLog log;
+	log.main_thread_id = Thread::get_caller_id();
+	stage_log = &log;
+
+	FrameTaskGraph graph;
+	for (int i = 0; i < 4; i++) {
+		graph.add_stage("Shared", callable_mp_static(&log_shared_stage).bind(i), {}, {});
+	}
+	graph.add_stage("Exclusive", callable_mp_static(&log_exclusive_stage).bind(4), {}, {}, FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+	for (int i = 5; i < 9; i++) {
+		graph.add_stage("Shared", callable_mp_static(&log_shared_stage).bind(i), {}, {});
+	}
+	graph.add_stage("Main thread", callable_mp_static(&log_main_thread_stage).bind(9), {}, {}, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD);
+	FrameTaskGraph::StageID last = graph.add_stage("Main thread exclusive", callable_mp_static(&log_main_thread_stage).bind(10), {}, {}, FrameTaskGraph::STAGE_FLAG_MAIN_THREAD | FrameTaskGraph::STAGE_FLAG_EXCLUSIVE);
+
+	graph.run();
+
+	REQUIRE(log.order.size() == 11);
+	CHECK_FALSE_MESSAGE(log.overlapped.is_set(), "Exclusive stages must not overlap other stages.");
+	CHECK_FALSE_MESSAGE(log.wrong_thread.is_set(), "Main thread stages must run on the thread calling run().");
+	for (int i = 0; i < 4; i++) {
+		CHECK(find_stage(i) < find_stage(4));
+	}
+	for (int i = 5; i < 10; i++) {
+		CHECK(find_stage(4) < find_stage(i));
+	}
+	CHECK(find_stage(10) == 10);
+	CHECK(graph.get_stage_name(last) == StringName("Main thread exclusive"));
+	CHECK(graph.get_stage_time_usec(last) >= 200);
+
+	graph.clear();
+	stage_log = nullptr;
+}
+
+} // namespace TestFrameTaskGraph
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner push and pop") {
+	WorkStealingDeque<intptr_t, 8> deque;
+	CHECK(deque.is_empty());
+	CHECK(deque.pop() == 0);
+	CHECK(deque.steal() == 0);
+
+	for (intptr_t i = 1; i <= 8; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_MESSAGE(!deque.push(9), "Pushing to a full deque should fail.");
+	CHECK(deque.size() == 8);
+
+	// The owner end is LIFO, the stealing end is FIFO.
+	CHECK(deque.pop() == 8);
+	CHECK(deque.steal() == 1);
+	CHECK(deque.pop() == 7);
+	CHECK(deque.steal() == 2);
+	CHECK(deque.size() == 4);
+
+	// Wrapping around the ring buffer.
+	for (intptr_t i = 9; i <= 12; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.size() == 8);
+	for (intptr_t i = 12; i >= 9; i--) {
+		CHECK(deque.pop() == i);
+	}
+	for (intptr_t i = 3; i <= 6; i++) {
+		CHECK(deque.steal() == i);
+	}
+	CHECK(deque.is_empty());
+	CHECK(deque.pop() == 0);
+}
+
+static const int STRESS_ITEMS = 200000;
+static const int STRESS_THIEVES = 4;
+
+struct StressData {
+	WorkStealingDeque<intptr_t, 64> deque;
+	LocalVector<SafeNumeric<uint32_t>> hits;
+	SafeFlag done;
+};
+
+static void thief_function(void *p_user) {
+	StressData *data = (StressData *)p_user;
+	while (!data->done.is_set() || !data->deque.is_empty()) {
+		intptr_t value = data->deque.steal();
+		if (value) {
+			data->hits[value].increment();
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingDeque][Threads] Every item is taken exactly once under contention") {
+	StressData data;
+	data.hits.resize(STRESS_ITEMS + 1);
+
+	Thread thieves[STRESS_THIEVES];
+	for (int i = 0; i < STRESS_THIEVES; i++) {
+		thieves[i].start(thief_function, &data);
+	}
+
+	for (intptr_t i = 1; i <= STRESS_ITEMS; i++) {
+		while (!data.deque.push(i)) {
+			intptr_t value = data.deque.pop();
+			if (value) {
+				data.hits[value].increment();
+			}
+		}
+		// Interleave owner pops to race thieves for the last element.
+		if (i % 3 == 0) {
+			intptr_t value = data.deque.pop();
+			if (value) {
+				data.hits[value].increment();
+			}
+		}
+	}
+	while (!data.deque.is_empty()) {
+		intptr_t value = data.deque.pop();
+		if (value) {
+			data.hits[value].increment();
+		}
+	}
+
+	data.done.set();
+	for (int i = 0; i < STRESS_THIEVES; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (int i = 1; i <= STRESS_ITEMS; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= data.hits[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingDeque
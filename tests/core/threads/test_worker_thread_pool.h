@@ -172,4 +172,237 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static const int NESTED_OUTER_ELEMENTS = 64;
+static const int NESTED_INNER_ELEMENTS = 32;
+
+static void static_nested_inner_group_test(void *p_arg, uint32_t p_index) {
+	counter[(uintptr_t)p_arg * NESTED_INNER_ELEMENTS + p_index].increment();
+}
+
+static void static_nested_outer_group_test(void *p_arg, uint32_t p_index) {
+	// Posted from a pool thread, so the inner group goes to this thread's local queue.
+	WorkerThreadPool::GroupID inner = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_inner_group_test, (void *)(uintptr_t)p_index, NESTED_INNER_ELEMENTS, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(inner);
+}
+
+TEST_CASE("[WorkerThreadPool] Nested group tasks posted and awaited from pool threads") {
+	for (int iterations = 0; iterations < 50; iterations++) {
+		counter.clear();
+		counter.resize(NESTED_OUTER_ELEMENTS * NESTED_INNER_ELEMENTS);
+
+		WorkerThreadPool::GroupID outer = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_outer_group_test, nullptr, NESTED_OUTER_ELEMENTS, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(outer);
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < counter.size(); i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_mixed_stress_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+	if (p_index % 8 == 0) {
+		// Also submit plain tasks from inside group tasks, competing for the shared queue.
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)p_index, false);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Stress mixed group and individual tasks from many submitters") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(3.0f, 10.0f));
+
+		counter.clear();
+		counter.resize(count);
+
+		LocalVector<WorkerThreadPool::GroupID> groups;
+		for (int i = 0; i < 4; i++) {
+			groups.push_back(WorkerThreadPool::get_singleton()->add_native_group_task(static_mixed_stress_group_test, nullptr, count, -1, i % 2 == 0));
+		}
+		for (WorkerThreadPool::GroupID group : groups) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		}
+
+		// Each element was run once per group, and each plain task added 1 to its element plus 2 to the first one.
+		int plain_tasks = (count + 7) / 8 * groups.size();
+		bool all_counts_right = counter[0].get() == int(groups.size()) + (int)groups.size() + plain_tasks * 2;
+		for (int i = 1; i < count; i++) {
+			//Reduce number of check messages
+			all_counts_right &= counter[i].get() == int(groups.size()) * (i % 8 == 0 ? 2 : 1);
+		}
+		CHECK(all_counts_right);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] parallel_for runs every element once, with any grain") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t count = 10000;
+
+	for (uint32_t grain : { 0u, 1u, 7u, 64u, count, count * 2 }) {
+		counter.clear();
+		counter.resize(count);
+		pool->parallel_for(100, count, grain, [](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from; i < p_to; i++) {
+				counter[i].increment();
+			}
+		});
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == (i < 100 ? 0 : 1);
+		}
+		CHECK_MESSAGE(all_run_once, vformat("Grain %d.", grain));
+	}
+
+	// Empty ranges are fine.
+	pool->parallel_for(5, 5, 0, [](uint32_t p_from, uint32_t p_to) {
+		counter[0].increment();
+	});
+	CHECK(counter[0].get() == 0);
+}
+
+TEST_CASE("[WorkerThreadPool] parallel_for can be nested from pool threads") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t outer = 64;
+	const uint32_t inner = 256;
+
+	counter.clear();
+	counter.resize(outer * inner);
+	pool->parallel_for(0, outer, 1, [pool](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			pool->parallel_for(0, inner, 0, [i](uint32_t p_inner_from, uint32_t p_inner_to) {
+				for (uint32_t j = p_inner_from; j < p_inner_to; j++) {
+					counter[i * inner + j].increment();
+				}
+			});
+		}
+	});
+
+	bool all_run_once = true;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		//Reduce number of check messages
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+TEST_CASE("[WorkerThreadPool] parallel_for_with_scratch splits the range in order") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t count = 1000;
+
+	LocalVector<LocalVector<uint32_t>> scratch;
+	scratch.resize(pool->get_thread_count() + 3);
+	pool->parallel_for_with_scratch(0, count, scratch, [](uint32_t p_from, uint32_t p_to, LocalVector<uint32_t> &r_values) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			r_values.push_back(i);
+		}
+	});
+
+	// Merging the scratch storage in order must give back the whole range, in order.
+	LocalVector<uint32_t> merged;
+	for (const LocalVector<uint32_t> &values : scratch) {
+		for (uint32_t value : values) {
+			merged.push_back(value);
+		}
+	}
+	REQUIRE(merged.size() == count);
+	bool in_order = true;
+	for (uint32_t i = 0; i < count; i++) {
+		in_order &= merged[i] == i;
+	}
+	CHECK(in_order);
+}
+
+TEST_CASE("[WorkerThreadPool] parallel_reduce and parallel_scan") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t count = 100000;
+
+	auto sum = [](const uint64_t &p_a, const uint64_t &p_b) { return p_a + p_b; };
+	auto accumulate = [](uint32_t p_from, uint32_t p_to, uint64_t &r_value) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			r_value += i;
+		}
+	};
+
+	for (uint32_t grain : { 0u, 1u, 333u, count }) {
+		uint64_t total = pool->parallel_reduce(0, count, grain, uint64_t(0), accumulate, sum);
+		CHECK(total == uint64_t(count) * (count - 1) / 2);
+
+		LocalVector<uint64_t> prefix_sums;
+		prefix_sums.resize(count);
+		auto scan = [&prefix_sums](uint32_t p_from, uint32_t p_to, const uint64_t &p_prefix) {
+			uint64_t running = p_prefix;
+			for (uint32_t i = p_from; i < p_to; i++) {
+				prefix_sums[i] = running; // Exclusive scan.
+				running += i;
+			}
+		};
+		total = pool->parallel_scan(0, count, grain, uint64_t(0), accumulate, sum, scan);
+		CHECK(total == uint64_t(count) * (count - 1) / 2);
+
+		bool scan_right = true;
+		for (uint32_t i = 0; i < count; i++) {
+			//Reduce number of check messages
+			scan_right &= prefix_sums[i] == uint64_t(i) * (i - 1) / 2;
+		}
+		CHECK_MESSAGE(scan_right, vformat("Grain %d.", grain));
+	}
+
+	// Folding happens in range order, so non-commutative reductions work too.
+	auto append = [](uint32_t p_from, uint32_t p_to, String &r_value) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			r_value += itos(i) + ",";
+		}
+	};
+	auto concatenate = [](const String &p_a, const String &p_b) { return p_a + p_b; };
+	String joined = pool->parallel_reduce(0, 100, 3, String(), append, concatenate);
+	String expected;
+	for (int i = 0; i < 100; i++) {
+		expected += itos(i) + ",";
+	}
+	CHECK(joined == expected);
+}
+
+static void static_benchmark_noop(void *p_arg) {
+}
+
+static void static_benchmark_group_noop(void *p_arg, uint32_t p_index) {
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool] Task submission and completion latency") {
+	const int TASKS = 10000;
+	const int GROUPS = 1000;
+	const int GROUP_ELEMENTS = 256;
+
+	for (int thread_count = 1; thread_count <= 64; thread_count *= 2) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		task_ids.resize(TASKS);
+
+		int submitted = 0;
+		const double submit_msec = benchmark_msec(TASKS, [&]() {
+			task_ids[submitted++] = pool->add_native_task(static_benchmark_noop, nullptr, true);
+		});
+		int waited = 0;
+		const double wait_msec = benchmark_msec(TASKS, [&]() {
+			pool->wait_for_task_completion(task_ids[waited++]);
+		});
+		const double group_msec = benchmark_msec(GROUPS, [&]() {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(static_benchmark_group_noop, nullptr, GROUP_ELEMENTS, -1, true);
+			pool->wait_for_group_task_completion(group);
+		});
+
+		print_line(vformat("WorkerThreadPool %2d threads: task submit %.3f us, task submit+complete %.3f us, group round-trip %.3f us.",
+				thread_count, submit_msec * 1000.0, (submit_msec + wait_msec) * 1000.0, group_msec * 1000.0));
+
+		memdelete(pool);
+	}
+}
+
 } // namespace TestWorkerThreadPool
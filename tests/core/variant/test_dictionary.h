@@ -30,6 +30,10 @@
 
 #pragma once
 
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/ordered_hash_map.h"
 #include "core/variant/typed_dictionary.h"
 #include "tests/test_macros.h"
 
@@ -617,4 +621,65 @@ TEST_CASE("[Dictionary] RefCounted value init") {
 	CHECK_EQ(tdict[5.0], Variant(b));
 }
 
+template <typename M>
+static void benchmark_variant_map(const char *p_name, const LocalVector<Variant> &p_keys, int p_maps) {
+	double insert = 0;
+	double lookup = 0;
+	double iterate = 0;
+	double copy = 0;
+	int64_t checksum = 0;
+
+	for (int n = 0; n < p_maps; n++) {
+		M map;
+		insert += benchmark_msec(1, [&]() {
+			for (uint32_t i = 0; i < p_keys.size(); i++) {
+				map[p_keys[i]] = int64_t(i);
+			}
+		});
+		lookup += benchmark_msec(1, [&]() {
+			for (const Variant &key : p_keys) {
+				checksum += int64_t(*map.getptr(key));
+			}
+		});
+		iterate += benchmark_msec(1, [&]() {
+			for (const KeyValue<Variant, Variant> &E : map) {
+				checksum += int64_t(E.value);
+			}
+		});
+		copy += benchmark_msec(1, [&]() {
+			M duplicate = map;
+			checksum += duplicate.size();
+		});
+	}
+
+	print_line(vformat("%s, %d keys x %d: insert %.3f ms, lookup %.3f ms, iterate %.3f ms, duplicate %.3f ms (checksum %d).",
+			p_name, p_keys.size(), p_maps, insert, lookup, iterate, copy, checksum));
+}
+
+// Compares the HashMap Dictionary used before with the OrderedHashMap it uses now.
+TEST_CASE_BENCHMARK("[Dictionary] Backend") {
+	struct Shape {
+		int keys;
+		int maps;
+	} shapes[] = {
+		{ 4, 200000 },
+		{ 16, 50000 },
+		{ 10000, 50 },
+	};
+
+	for (const Shape &shape : shapes) {
+		LocalVector<Variant> keys;
+		for (int i = 0; i < shape.keys; i++) {
+			// Like the mix of names and numbers used as keys in gameplay data.
+			if (i % 2) {
+				keys.push_back(StringName("key_" + itos(i)));
+			} else {
+				keys.push_back(i * 7);
+			}
+		}
+		benchmark_variant_map<HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>>("HashMap", keys, shape.maps);
+		benchmark_variant_map<OrderedHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>>("OrderedHashMap", keys, shape.maps);
+	}
+}
+
 } // namespace TestDictionary
@@ -30,6 +30,10 @@
 
 #pragma once
 
+#include "core/os/slab_allocator.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +284,60 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+// Spawns `p_count` instances at once and frees them on the next frame, like a burst of projectiles.
+// Returns the time of a round in milliseconds, and the allocations of a round in `r_allocs`.
+static double benchmark_spawn_churn(const Ref<PackedScene> &p_scene, int p_count, int p_rounds, uint64_t &r_allocs) {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	const uint64_t allocs = Memory::get_alloc_count();
+	const double msec = benchmark_msec(p_rounds, [&]() {
+		for (int i = 0; i < p_count; i++) {
+			parent->add_child(p_scene->instantiate());
+		}
+		for (int i = 0; i < p_count; i++) {
+			parent->get_child(i)->queue_free();
+		}
+		SceneTree::get_singleton()->process(0);
+	});
+	r_allocs = (Memory::get_alloc_count() - allocs) / p_rounds;
+
+	memdelete(parent);
+	return msec;
+}
+
+TEST_CASE_BENCHMARK("[PackedScene] Instantiate and free churn") {
+	const int COUNT = 5000;
+	const int ROUNDS = 10;
+
+	Node2D *projectile = memnew(Node2D);
+	projectile->set_name("Projectile");
+	for (int i = 0; i < 4; i++) {
+		Node2D *part = memnew(Node2D);
+		part->set_name(vformat("Part%d", i));
+		part->set_position(Vector2(i, 0));
+		projectile->add_child(part);
+		part->set_owner(projectile);
+	}
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	REQUIRE(packed_scene->pack(projectile) == OK);
+	memdelete(projectile);
+
+	uint64_t allocs = 0;
+#ifdef SLAB_ALLOCATOR_ENABLED
+	// Blocks remember which allocator they come from, so it can be switched at any time.
+	SlabAllocator::set_enabled(false);
+	double system = benchmark_spawn_churn(packed_scene, COUNT, ROUNDS, allocs);
+	SlabAllocator::set_enabled(true);
+	double slab = benchmark_spawn_churn(packed_scene, COUNT, ROUNDS, allocs);
+	print_line(vformat("Instantiate and free %d scenes: system allocator %.3f ms, slab allocator %.3f ms per round, %d allocations per round, %d KiB reserved in slabs.",
+			COUNT, system, slab, allocs, SlabAllocator::get_reserved_bytes() / 1024));
+#else
+	double system = benchmark_spawn_churn(packed_scene, COUNT, ROUNDS, allocs);
+	print_line(vformat("Instantiate and free %d scenes: system allocator %.3f ms per round, %d allocations per round. Build with `slab_allocator=yes` to compare with the slab allocator.",
+			COUNT, system, allocs));
+#endif
+}
+
 } // namespace TestPackedScene
@@ -0,0 +1,208 @@
+/**************************************************************************/
+/*  test_scene_tree_transform_hierarchy.h                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneTreeTransformHierarchy {
+
+static Transform3D compute_global_transform(const Node3D *p_node) {
+	Transform3D global = p_node->get_transform();
+	const Node3D *parent = Object::cast_to<Node3D>(p_node->get_parent());
+	if (parent && !p_node->is_set_as_top_level()) {
+		global = compute_global_transform(parent) * global;
+	}
+	if (p_node->is_scale_disabled()) {
+		global.basis.orthonormalize();
+	}
+	return global;
+}
+
+// Builds `p_width` chains of `p_depth` nodes below `p_root`.
+static void build_tree(Node3D *p_root, int p_width, int p_depth, LocalVector<Node3D *> &r_nodes) {
+	for (int i = 0; i < p_width; i++) {
+		Node3D *parent = p_root;
+		for (int j = 0; j < p_depth; j++) {
+			Node3D *node = memnew(Node3D);
+			node->set_position(Vector3(1, 0, 0));
+			node->set_rotation(Vector3(0, 0.01 * (i + 1), 0));
+			parent->add_child(node);
+			r_nodes.push_back(node);
+			parent = node;
+		}
+	}
+}
+
+static bool check_global_transforms(const LocalVector<Node3D *> &p_nodes) {
+	for (const Node3D *node : p_nodes) {
+		if (!node->get_global_transform().is_equal_approx(compute_global_transform(node))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][Node3D] Batched transform updates") {
+	SceneTreeTransformHierarchy &hierarchy = SceneTree::get_singleton()->get_transform_hierarchy();
+	hierarchy.set_enabled(true);
+
+	Node3D *root = memnew(Node3D);
+	LocalVector<Node3D *> nodes;
+	// Wide enough to be split in several ranges, and deep enough to need splitting below the root.
+	build_tree(root, 40, 20, nodes);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	CHECK(hierarchy.get_node_count() >= nodes.size() + 1);
+	CHECK_MESSAGE(check_global_transforms(nodes), "Global transforms should be correct after entering the tree.");
+
+	SUBCASE("Moving the root updates every node") {
+		root->set_position(Vector3(5, 6, 7));
+		root->set_scale(Vector3(2, 2, 2));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(check_global_transforms(nodes));
+	}
+
+	SUBCASE("Changes in several subtrees at once") {
+		nodes[3]->set_rotation(Vector3(1, 0, 0));
+		nodes[25]->set_scale(Vector3(0.5, 1, 3));
+		nodes[26]->set_position(Vector3(0, 2, 0)); // Inside the subtree of the previous one.
+		nodes[nodes.size() - 1]->set_position(Vector3(3, 3, 3));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(check_global_transforms(nodes));
+	}
+
+	SUBCASE("Top level and disabled scale") {
+		root->set_scale(Vector3(2, 3, 4));
+		nodes[50]->set_as_top_level(true);
+		nodes[70]->set_disable_scale(true);
+		nodes[69]->set_rotation(Vector3(0, 0, 1)); // Parent of the one with scale disabled.
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(check_global_transforms(nodes));
+	}
+
+	SUBCASE("Structure changes") {
+		Node3D *moved = nodes[100];
+		moved->get_parent()->remove_child(moved);
+		nodes[300]->add_child(moved);
+		root->set_position(Vector3(-1, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(check_global_transforms(nodes));
+
+		Node3D *removed = nodes[500];
+		removed->set_position(Vector3(1, 1, 1));
+		removed->get_parent()->remove_child(removed);
+		SceneTree::get_singleton()->flush_transform_notifications();
+
+		nodes[10]->set_position(Vector3(1, 1, 1));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(hierarchy.get_node_count() < nodes.size() + 1);
+		CHECK(nodes[10]->get_global_transform().is_equal_approx(compute_global_transform(nodes[10])));
+		memdelete(removed);
+	}
+
+	SUBCASE("Removing nodes waiting for an update") {
+		// The removed node sits between other dirty nodes, so the ones after it get moved around.
+		nodes[5]->set_position(Vector3(2, 0, 0));
+		Node3D *removed = nodes[219];
+		removed->set_position(Vector3(0, 2, 0));
+		nodes[399]->set_position(Vector3(0, 0, 2));
+		nodes[799]->set_position(Vector3(1, 2, 3));
+		removed->get_parent()->remove_child(removed);
+		SceneTree::get_singleton()->flush_transform_notifications();
+
+		CHECK(nodes[5]->get_global_transform().is_equal_approx(compute_global_transform(nodes[5])));
+		CHECK(nodes[399]->get_global_transform().is_equal_approx(compute_global_transform(nodes[399])));
+		CHECK(nodes[799]->get_global_transform().is_equal_approx(compute_global_transform(nodes[799])));
+		memdelete(removed);
+	}
+
+	memdelete(root);
+	hierarchy.set_enabled(false);
+}
+
+// Returns the time of a frame in milliseconds.
+static double benchmark_propagation(bool p_batched, int p_width, int p_depth, int p_iterations) {
+	SceneTreeTransformHierarchy &hierarchy = SceneTree::get_singleton()->get_transform_hierarchy();
+	hierarchy.set_enabled(p_batched);
+
+	Node3D *root = memnew(Node3D);
+	LocalVector<Node3D *> nodes;
+	build_tree(root, p_width, p_depth, nodes);
+	for (Node3D *node : nodes) {
+		// Like visual instances, which read their global transform on the notification.
+		node->set_notify_transform(true);
+	}
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	int iteration = 0;
+	real_t checksum = 0;
+	const double msec = benchmark_msec(p_iterations, [&]() {
+		root->set_rotation(Vector3(0, 0.1 * iteration++, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		for (const Node3D *node : nodes) {
+			checksum += node->get_global_transform().origin.x;
+		}
+	});
+	CHECK(Math::is_finite(checksum));
+
+	memdelete(root);
+	hierarchy.set_enabled(false);
+	return msec;
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Node3D] Batched transform updates") {
+	const int ITERATIONS = 20;
+
+	struct Shape {
+		const char *name;
+		int width;
+		int depth;
+	} shapes[] = {
+		{ "wide", 100000, 1 },
+		{ "bushy", 1000, 100 },
+		{ "deep", 10, 2000 },
+	};
+
+	for (const Shape &shape : shapes) {
+		double lazy = benchmark_propagation(false, shape.width, shape.depth, ITERATIONS);
+		double batched = benchmark_propagation(true, shape.width, shape.depth, ITERATIONS);
+		print_line(vformat("Node3D transform propagation (%s, %d nodes): lazy %.3f ms, batched %.3f ms per frame.",
+				shape.name, shape.width * shape.depth, lazy, batched));
+	}
+}
+
+} // namespace TestSceneTreeTransformHierarchy
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/rendering/frustum_cull_simd.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[FrustumCullSIMD] Every supported kernel matches the plane distance test") {
+	const uint32_t COUNT = 4099; // Not a multiple of any SIMD width, to cover the tails.
+	const uint64_t FROM = 5;
+
+	LocalVector<real_t> bounds[6];
+	const real_t *bounds_ptrs[6];
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+	for (uint32_t j = 0; j < 6; j++) {
+		bounds[j].resize(FROM + COUNT);
+		bounds_ptrs[j] = bounds[j].ptr();
+	}
+	for (uint32_t i = 0; i < FROM + COUNT; i++) {
+		for (uint32_t j = 0; j < 3; j++) {
+			real_t position = rng->randf_range(-100, 100);
+			bounds[j][i] = position;
+			bounds[j + 3][i] = position + rng->randf_range(0, 10);
+		}
+	}
+
+	Vector<Plane> planes;
+	planes.push_back(Plane(Vector3(1, 0, 0), 50));
+	planes.push_back(Plane(Vector3(-1, 0, 0), 50));
+	planes.push_back(Plane(Vector3(0, 1, 0), 30));
+	planes.push_back(Plane(Vector3(0, -0.7, 0.7).normalized(), 30));
+	planes.push_back(Plane(Vector3(0.3, 0.3, 0.9).normalized(), 20));
+	planes.push_back(Plane(Vector3(0, 0, -1), 60));
+
+	LocalVector<FrustumCullSIMD::CullPlane> cull_planes;
+	for (const Plane &plane : planes) {
+		FrustumCullSIMD::CullPlane cull_plane;
+		for (uint32_t j = 0; j < 3; j++) {
+			cull_plane.normal[j] = plane.normal[j];
+			cull_plane.signs[j] = plane.normal[j] > 0 ? j : j + 3;
+		}
+		cull_plane.d = plane.d;
+		cull_planes.push_back(cull_plane);
+	}
+
+	LocalVector<uint8_t> expected;
+	expected.resize(COUNT);
+	uint32_t inside_count = 0;
+	for (uint32_t i = 0; i < COUNT; i++) {
+		expected[i] = 1;
+		for (const FrustumCullSIMD::CullPlane &plane : cull_planes) {
+			Vector3 corner(bounds[plane.signs[0]][FROM + i], bounds[plane.signs[1]][FROM + i], bounds[plane.signs[2]][FROM + i]);
+			if (Plane(Vector3(plane.normal[0], plane.normal[1], plane.normal[2]), plane.d).distance_to(corner) >= 0.0) {
+				expected[i] = 0;
+				break;
+			}
+		}
+		inside_count += expected[i];
+	}
+	// Make sure the planes actually split the set.
+	CHECK(inside_count > 0);
+	CHECK(inside_count < COUNT);
+
+	LocalVector<uint8_t> result;
+	result.resize(COUNT);
+	for (int k = 0; k < FrustumCullSIMD::KERNEL_MAX; k++) {
+		FrustumCullSIMD::Kernel kernel = FrustumCullSIMD::Kernel(k);
+		if (!FrustumCullSIMD::is_kernel_supported(kernel)) {
+			continue;
+		}
+
+		memset(result.ptr(), 0xFF, COUNT);
+		FrustumCullSIMD::cull_with_kernel(kernel, bounds_ptrs, FROM, COUNT, cull_planes.ptr(), cull_planes.size(), result.ptr());
+
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < COUNT; i++) {
+			mismatches += result[i] != expected[i];
+		}
+		CHECK_MESSAGE(mismatches == 0, vformat("%s kernel disagrees with the scalar test.", FrustumCullSIMD::get_kernel_name(kernel)));
+	}
+
+	CHECK(FrustumCullSIMD::is_kernel_supported(FrustumCullSIMD::get_kernel()));
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][RendererSceneCull] Cull one million instances") {
+	const int INSTANCE_COUNT = 1000000;
+	const int FRAMES = 20;
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	LocalVector<RID> instances;
+	instances.reserve(INSTANCE_COUNT);
+	for (int i = 0; i < INSTANCE_COUNT; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(rng->randf_range(-500, 500), rng->randf_range(-500, 500), rng->randf_range(-500, 500))));
+		instances.push_back(instance);
+	}
+	RSG::scene->update();
+
+	// Looks down -Z from the center, so roughly an eighth of the instances are visible.
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 1000.0);
+	rs->camera_set_transform(camera, Transform3D());
+
+	Ref<RenderSceneBuffers> render_buffers = memnew(RenderSceneBuffersExtension);
+	Ref<XRInterface> xr_interface;
+	const FrustumCullSIMD::Kernel best_kernel = FrustumCullSIMD::get_kernel();
+
+	for (int k = 0; k < FrustumCullSIMD::KERNEL_MAX; k++) {
+		FrustumCullSIMD::Kernel kernel = FrustumCullSIMD::Kernel(k);
+		if (!FrustumCullSIMD::is_kernel_supported(kernel)) {
+			continue;
+		}
+		FrustumCullSIMD::set_kernel(kernel);
+
+		auto render = [&]() {
+			RSG::scene->render_camera(render_buffers, camera, scenario, RID(), Size2(1920, 1080), 0, 1.0, RID(), xr_interface);
+		};
+		// Warm up once, then time.
+		render();
+		double msec = benchmark_msec(FRAMES, render);
+		print_line(vformat("RendererSceneCull, %d instances, %s kernel: %.3f ms per frame (%.1f M instances/s).",
+				INSTANCE_COUNT, FrustumCullSIMD::get_kernel_name(kernel), msec, INSTANCE_COUNT / msec / 1000.0));
+	}
+	FrustumCullSIMD::set_kernel(best_kernel);
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(camera);
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
@@ -0,0 +1,245 @@
+/**************************************************************************/
+/*  test_rendering_server_transforms.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#ifndef _3D_DISABLED
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#endif // _3D_DISABLED
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServerTransforms {
+
+static Transform3D get_instance_transform(RID p_instance) {
+	RendererSceneCull *scene = static_cast<RendererSceneCull *>(RSG::scene);
+	return scene->instance_owner.get_or_null(p_instance)->transform;
+}
+
+static Transform2D get_canvas_item_transform(RID p_item) {
+	return RSG::canvas->canvas_item_owner.get_or_null(p_item)->xform_curr;
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Setting instance transforms in bulk") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < 4; i++) {
+		instances.push_back(rs->instance_create());
+		transforms.push_back(Transform3D(Basis::from_euler(Vector3(0, 0.5 * i, 0)), Vector3(i, 2 * i, -i)));
+	}
+
+	SUBCASE("Matches setting them one by one") {
+		rs->instances_set_transforms(instances, transforms);
+		for (int i = 0; i < instances.size(); i++) {
+			CHECK(get_instance_transform(instances[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	SUBCASE("Later entries for the same instance win") {
+		instances.push_back(instances[1]);
+		transforms.push_back(Transform3D(Basis(), Vector3(7, 7, 7)));
+		rs->instances_set_transforms(instances, transforms);
+		CHECK(get_instance_transform(instances[1]).is_equal_approx(Transform3D(Basis(), Vector3(7, 7, 7))));
+		instances.resize(4);
+	}
+
+	SUBCASE("Freed instances are skipped") {
+		RID freed = rs->instance_create();
+		rs->free(freed);
+		instances.insert(2, freed);
+		transforms.insert(2, Transform3D(Basis(), Vector3(9, 9, 9)));
+		rs->instances_set_transforms(instances, transforms);
+		instances.remove_at(2);
+		transforms.remove_at(2);
+		for (int i = 0; i < instances.size(); i++) {
+			CHECK(get_instance_transform(instances[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	SUBCASE("Mismatched sizes change nothing") {
+		Vector<Transform3D> too_few = transforms;
+		too_few.resize(2);
+		ERR_PRINT_OFF;
+		rs->instances_set_transforms(instances, too_few);
+		ERR_PRINT_ON;
+		for (const RID &instance : instances) {
+			CHECK(get_instance_transform(instance).is_equal_approx(Transform3D()));
+		}
+	}
+
+	SUBCASE("Script binding uses the multimesh layout") {
+		TypedArray<RID> instance_array;
+		PackedFloat32Array floats;
+		for (int i = 0; i < instances.size(); i++) {
+			instance_array.push_back(instances[i]);
+			const Transform3D &t = transforms[i];
+			for (int j = 0; j < 3; j++) {
+				floats.push_back(t.basis.rows[j].x);
+				floats.push_back(t.basis.rows[j].y);
+				floats.push_back(t.basis.rows[j].z);
+				floats.push_back(t.origin[j]);
+			}
+		}
+		rs->call("instances_set_transforms", instance_array, floats);
+		for (int i = 0; i < instances.size(); i++) {
+			CHECK(get_instance_transform(instances[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Setting canvas item transforms in bulk") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Vector<RID> items;
+	Vector<Transform2D> transforms;
+	for (int i = 0; i < 4; i++) {
+		items.push_back(rs->canvas_item_create());
+		transforms.push_back(Transform2D(0.3 * i, Size2(1, 1 + i), 0.1 * i, Vector2(10 * i, -5 * i)));
+	}
+
+	SUBCASE("Matches setting them one by one") {
+		rs->canvas_items_set_transforms(items, transforms);
+		for (int i = 0; i < items.size(); i++) {
+			CHECK(get_canvas_item_transform(items[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	SUBCASE("Freed items are skipped") {
+		RID freed = rs->canvas_item_create();
+		rs->free(freed);
+		items.insert(0, freed);
+		transforms.insert(0, Transform2D(0, Vector2(9, 9)));
+		rs->canvas_items_set_transforms(items, transforms);
+		items.remove_at(0);
+		transforms.remove_at(0);
+		for (int i = 0; i < items.size(); i++) {
+			CHECK(get_canvas_item_transform(items[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	SUBCASE("Mismatched sizes change nothing") {
+		Vector<Transform2D> too_many = transforms;
+		too_many.push_back(Transform2D());
+		ERR_PRINT_OFF;
+		rs->canvas_items_set_transforms(items, too_many);
+		ERR_PRINT_ON;
+		for (const RID &item : items) {
+			CHECK(get_canvas_item_transform(item).is_equal_approx(Transform2D()));
+		}
+	}
+
+	SUBCASE("Script binding uses the multimesh layout") {
+		TypedArray<RID> item_array;
+		PackedFloat32Array floats;
+		for (int i = 0; i < items.size(); i++) {
+			item_array.push_back(items[i]);
+			const Transform2D &t = transforms[i];
+			floats.push_back(t.columns[0].x);
+			floats.push_back(t.columns[1].x);
+			floats.push_back(t.columns[2].x);
+			floats.push_back(t.columns[0].y);
+			floats.push_back(t.columns[1].y);
+			floats.push_back(t.columns[2].y);
+		}
+		rs->call("canvas_items_set_transforms", item_array, floats);
+		for (int i = 0; i < items.size(); i++) {
+			CHECK(get_canvas_item_transform(items[i]).is_equal_approx(transforms[i]));
+		}
+	}
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+}
+
+#ifndef _3D_DISABLED
+class IdentityMeshInstance3D : public MeshInstance3D {
+	GDCLASS(IdentityMeshInstance3D, MeshInstance3D);
+
+public:
+	void set_use_identity_transform(bool p_enable) {
+		set_instance_use_identity_transform(p_enable);
+	}
+};
+
+// Changes another node's instance while transform notifications are being flushed, like a script would.
+class IdentityTransformSwitcher : public Node3D {
+	GDCLASS(IdentityTransformSwitcher, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED && target) {
+			target->set_use_identity_transform(true);
+		}
+	}
+
+public:
+	IdentityMeshInstance3D *target = nullptr;
+};
+
+TEST_CASE("[SceneTree][RenderingServer] Direct instance transform changes aren't overwritten by the batch") {
+	GDREGISTER_CLASS(IdentityMeshInstance3D);
+	GDREGISTER_CLASS(IdentityTransformSwitcher);
+
+	IdentityMeshInstance3D *mesh_instance = memnew(IdentityMeshInstance3D);
+	IdentityTransformSwitcher *switcher = memnew(IdentityTransformSwitcher);
+	switcher->target = mesh_instance;
+	switcher->set_notify_transform(true);
+	SceneTree::get_singleton()->get_root()->add_child(mesh_instance);
+	SceneTree::get_singleton()->get_root()->add_child(switcher);
+	SceneTree::get_singleton()->flush_transform_notifications();
+	mesh_instance->set_use_identity_transform(false);
+
+	// Notifications go newest first, so the mesh instance batches its new transform before the switcher asks for the identity.
+	switcher->set_position(Vector3(4, 5, 6));
+	mesh_instance->set_position(Vector3(1, 2, 3));
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	CHECK_MESSAGE(get_instance_transform(mesh_instance->get_instance()).is_equal_approx(Transform3D()),
+			"The identity transform set during the flush should be the one the server keeps.");
+
+	memdelete(switcher);
+	memdelete(mesh_instance);
+}
+#endif // _3D_DISABLED
+
+} // namespace TestRenderingServerTransforms
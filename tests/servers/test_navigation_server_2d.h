@@ -79,6 +79,47 @@ struct RegisterHeapIndexes {
 	}
 };
 
+// Creates a navigation polygon with a square polygon of 10 pixels for each '.' in `p_rows`.
+static Ref<NavigationPolygon> create_grid_navigation_polygon(const Vector<String> &p_rows) {
+	Ref<NavigationPolygon> navigation_polygon;
+	navigation_polygon.instantiate();
+	Vector<Vector2> vertices;
+	for (int y = 0; y < p_rows.size(); y++) {
+		for (int x = 0; x < p_rows[y].length(); x++) {
+			if (p_rows[y][x] != '.') {
+				continue;
+			}
+			const int first_vertex = vertices.size();
+			vertices.push_back(Vector2(x, y) * 10);
+			vertices.push_back(Vector2(x + 1, y) * 10);
+			vertices.push_back(Vector2(x + 1, y + 1) * 10);
+			vertices.push_back(Vector2(x, y + 1) * 10);
+			navigation_polygon->add_polygon({ first_vertex, first_vertex + 1, first_vertex + 2, first_vertex + 3 });
+		}
+	}
+	navigation_polygon->set_vertices(vertices);
+	return navigation_polygon;
+}
+
+static real_t get_path_length(const Vector<Vector2> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+// Queries the map with hierarchical pathfinding turned off for a moment.
+static Vector<Vector2> get_path_without_hierarchical_pathfinding(RID p_map, const Vector2 &p_origin, const Vector2 &p_destination, bool p_optimize) {
+	NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+	navigation_server->map_set_use_hierarchical_pathfinding(p_map, false);
+	navigation_server->physics_process(0.0);
+	const Vector<Vector2> path = navigation_server->map_get_path(p_map, p_origin, p_destination, p_optimize);
+	navigation_server->map_set_use_hierarchical_pathfinding(p_map, true);
+	navigation_server->physics_process(0.0);
+	return path;
+}
+
 TEST_SUITE("[Navigation2D]") {
 	TEST_CASE("[NavigationServer2D] Server should be empty when initialized") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
@@ -741,6 +782,149 @@ TEST_SUITE("[Navigation2D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer2D] Server should respond to queries with hierarchical pathfinding properly") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		// The chunk in the middle of the top row holds two unconnected pieces, so the cluster route along
+		// the top row doesn't connect on the polygons. The only way around leaves the clusters next to it.
+		const Vector<String> rows = {
+			"#########",
+			"....#....",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.....#",
+			"#########",
+		};
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->map_set_hierarchical_pathfinding_chunk_size(map, 30.0);
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+		CHECK_EQ(navigation_server->map_get_hierarchical_pathfinding_chunk_size(map), doctest::Approx(30.0));
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, create_grid_navigation_polygon(rows));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Query within the top row should be as short as without hierarchical pathfinding") {
+			const Vector2 start_position = Vector2(75, 15);
+			const Vector2 target_position = Vector2(75, 75);
+			Vector<Vector2> path = navigation_server->map_get_path(map, start_position, target_position, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(target_position));
+			CHECK_EQ(get_path_length(path), doctest::Approx(get_path_length(get_path_without_hierarchical_pathfinding(map, start_position, target_position, true))));
+		}
+
+		SUBCASE("Query along a dead end cluster route should fall back to the full search") {
+			const Vector2 start_position = Vector2(5, 15);
+			const Vector2 target_position = Vector2(85, 15);
+			Vector<Vector2> path = navigation_server->map_get_path(map, start_position, target_position, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[path.size() - 1].is_equal_approx(target_position));
+			CHECK_GT(get_path_length(path), 160.0);
+			CHECK_EQ(get_path_length(path), doctest::Approx(get_path_length(get_path_without_hierarchical_pathfinding(map, start_position, target_position, true))));
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer2D] Server should reuse cached path corridors and batch queries properly") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		const Vector<String> rows = {
+			"#########",
+			"....#....",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.....#",
+			"#########",
+		};
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, create_grid_navigation_polygon(rows));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector2 target_position = Vector2(85, 15);
+
+		SUBCASE("Cached corridor should yield the same path as a new search from another start position") {
+			navigation_server->map_set_path_cache_size(map, 4);
+			navigation_server->physics_process(0.0);
+			CHECK_EQ(navigation_server->map_get_path_cache_size(map), 4);
+
+			// Both start positions are on the same polygon, so the second query reuses the stored corridor.
+			const Vector2 other_start_position = Vector2(8, 18);
+			navigation_server->map_get_path(map, Vector2(2, 12), target_position, true);
+			const Vector<Vector2> cached_path = navigation_server->map_get_path(map, other_start_position, target_position, true);
+
+			navigation_server->map_set_path_cache_size(map, 0);
+			navigation_server->physics_process(0.0);
+			CHECK_EQ(navigation_server->map_get_path_cache_size(map), 0);
+			const Vector<Vector2> path = navigation_server->map_get_path(map, other_start_position, target_position, true);
+
+			REQUIRE_GE(path.size(), 2);
+			REQUIRE_EQ(cached_path.size(), path.size());
+			CHECK(cached_path[0].is_equal_approx(other_start_position));
+			for (int i = 0; i < path.size(); i++) {
+				CHECK(cached_path[i].is_equal_approx(path[i]));
+			}
+		}
+
+		SUBCASE("Batched queries should yield the same paths as single queries") {
+			const Vector<Vector2> start_positions = {
+				Vector2(5, 15),
+				Vector2(35, 45),
+				Vector2(55, 75),
+				Vector2(75, 45),
+			};
+			TypedArray<NavigationPathQueryParameters2D> parameters_array;
+			TypedArray<NavigationPathQueryResult2D> results_array;
+			for (const Vector2 &start_position : start_positions) {
+				Ref<NavigationPathQueryParameters2D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(start_position);
+				query_parameters->set_target_position(target_position);
+				parameters_array.push_back(query_parameters);
+				Ref<NavigationPathQueryResult2D> query_result;
+				query_result.instantiate();
+				results_array.push_back(query_result);
+			}
+			navigation_server->query_paths(parameters_array, results_array);
+
+			for (int i = 0; i < parameters_array.size(); i++) {
+				Ref<NavigationPathQueryResult2D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(parameters_array[i], query_result);
+				const Vector<Vector2> path = query_result->get_path();
+				const Vector<Vector2> batched_path = Ref<NavigationPathQueryResult2D>(results_array[i])->get_path();
+				REQUIRE_GE(path.size(), 2);
+				REQUIRE_EQ(batched_path.size(), path.size());
+				for (int j = 0; j < path.size(); j++) {
+					CHECK(batched_path[j].is_equal_approx(path[j]));
+				}
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer2D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector2> source_path;
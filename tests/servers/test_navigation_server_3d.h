@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -50,6 +51,47 @@ public:
 	Variant function1_latest_arg0;
 };
 
+// Creates a navigation mesh with a square polygon for each '.' in `p_rows`, the rows go along the z axis.
+static Ref<NavigationMesh> create_grid_navigation_mesh(const Vector<String> &p_rows) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	Vector<Vector3> vertices;
+	for (int z = 0; z < p_rows.size(); z++) {
+		for (int x = 0; x < p_rows[z].length(); x++) {
+			if (p_rows[z][x] != '.') {
+				continue;
+			}
+			const int first_vertex = vertices.size();
+			vertices.push_back(Vector3(x, 0, z));
+			vertices.push_back(Vector3(x + 1, 0, z));
+			vertices.push_back(Vector3(x + 1, 0, z + 1));
+			vertices.push_back(Vector3(x, 0, z + 1));
+			navigation_mesh->add_polygon({ first_vertex, first_vertex + 1, first_vertex + 2, first_vertex + 3 });
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	return navigation_mesh;
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+// Queries the map with hierarchical pathfinding turned off for a moment.
+static Vector<Vector3> get_path_without_hierarchical_pathfinding(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, bool p_optimize) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	navigation_server->map_set_use_hierarchical_pathfinding(p_map, false);
+	navigation_server->physics_process(0.0);
+	const Vector<Vector3> path = navigation_server->map_get_path(p_map, p_origin, p_destination, p_optimize);
+	navigation_server->map_set_use_hierarchical_pathfinding(p_map, true);
+	navigation_server->physics_process(0.0);
+	return path;
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -758,6 +800,30 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries sharing a target should yield paths to that target") {
+			const Vector3 target_position = Vector3(4, 0, 4);
+			TypedArray<NavigationPathQueryParameters3D> parameters_array;
+			TypedArray<NavigationPathQueryResult3D> results_array;
+			for (int i = 0; i < 3; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(-4 + i * 2, 0, -4));
+				query_parameters->set_target_position(target_position);
+				parameters_array.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				results_array.push_back(query_result);
+			}
+			navigation_server->query_paths(parameters_array, results_array);
+			for (int i = 0; i < results_array.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = results_array[i];
+				const Vector<Vector3> path = query_result->get_path();
+				REQUIRE_GE(path.size(), 2);
+				CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, target_position)));
+			}
+		}
+
 		SUBCASE("Elaborate query with excluded region should yield empty path") {
 			Ref<NavigationPathQueryParameters3D> query_parameters;
 			query_parameters.instantiate();
@@ -803,6 +869,273 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should respond to queries with hierarchical pathfinding properly") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_pathfinding_chunk_size", 4.0);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_pathfinding_chunk_size", 32.0);
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+		CHECK_EQ(navigation_server->map_get_hierarchical_pathfinding_chunk_size(map), doctest::Approx(4.0));
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(40.0, 0.001, 40.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Query across clusters should reach the target") {
+			const Vector3 start_position = Vector3(-18, 0, -18);
+			const Vector3 target_position = Vector3(18, 0, 18);
+			Vector<Vector3> path = navigation_server->map_get_path(map, start_position, target_position, true);
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, start_position)));
+			CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, target_position)));
+		}
+
+		SUBCASE("Query across clusters should be about as short as without hierarchical pathfinding") {
+			const Vector3 positions[] = { Vector3(-18, 0, -18), Vector3(18, 0, 18), Vector3(-18, 0, 15), Vector3(17, 0, -16), Vector3(0, 0, -18) };
+			for (const Vector3 &start_position : positions) {
+				for (const Vector3 &target_position : positions) {
+					if (start_position == target_position) {
+						continue;
+					}
+					const real_t path_length = get_path_length(navigation_server->map_get_path(map, start_position, target_position, true));
+					const real_t full_path_length = get_path_length(get_path_without_hierarchical_pathfinding(map, start_position, target_position, true));
+					// The full search finds the shortest path, the route through the clusters may only cost a detour.
+					CHECK_GE(path_length, full_path_length - 0.001);
+					CHECK_LE(path_length, full_path_length * 1.05);
+				}
+			}
+		}
+
+		SUBCASE("Query with excluded region should yield empty path") {
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(-18, 0, -18));
+			query_parameters->set_target_position(Vector3(18, 0, 18));
+			query_parameters->set_excluded_regions({ region });
+			Ref<NavigationPathQueryResult3D> query_result;
+			query_result.instantiate();
+			navigation_server->query_path(query_parameters, query_result);
+			CHECK_EQ(query_result->get_path().size(), 0);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should fall back to the full search when the cluster route is a dead end") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// The chunk in the middle of the top row holds two unconnected pieces, so the cluster route along
+		// the top row doesn't connect on the polygons. The only way around leaves the clusters next to it.
+		const Vector<String> rows = {
+			"#########",
+			"....#....",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.....#",
+			"#########",
+		};
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->map_set_hierarchical_pathfinding_chunk_size(map, 3.0);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh(rows));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start_position = Vector3(0.5, 0, 1.5);
+		const Vector3 target_position = Vector3(8.5, 0, 1.5);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start_position, target_position, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(target_position));
+		CHECK_GT(get_path_length(path), 16.0);
+		CHECK_EQ(get_path_length(path), doctest::Approx(get_path_length(get_path_without_hierarchical_pathfinding(map, start_position, target_position, true))));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should reuse cached path corridors and batch queries properly") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Vector<String> rows = {
+			"#########",
+			"....#....",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.###.#",
+			"###.....#",
+			"#########",
+		};
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh(rows));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 target_position = Vector3(8.5, 0, 1.5);
+
+		SUBCASE("Cached corridor should yield the same path as a new search from another start position") {
+			navigation_server->map_set_path_cache_size(map, 4);
+			navigation_server->physics_process(0.0);
+			CHECK_EQ(navigation_server->map_get_path_cache_size(map), 4);
+
+			// Both start positions are on the same polygon, so the second query reuses the stored corridor.
+			const Vector3 other_start_position = Vector3(0.8, 0, 1.8);
+			navigation_server->map_get_path(map, Vector3(0.2, 0, 1.2), target_position, true);
+			const Vector<Vector3> cached_path = navigation_server->map_get_path(map, other_start_position, target_position, true);
+
+			navigation_server->map_set_path_cache_size(map, 0);
+			navigation_server->physics_process(0.0);
+			CHECK_EQ(navigation_server->map_get_path_cache_size(map), 0);
+			const Vector<Vector3> path = navigation_server->map_get_path(map, other_start_position, target_position, true);
+
+			REQUIRE_GE(path.size(), 2);
+			REQUIRE_EQ(cached_path.size(), path.size());
+			CHECK(cached_path[0].is_equal_approx(other_start_position));
+			for (int i = 0; i < path.size(); i++) {
+				CHECK(cached_path[i].is_equal_approx(path[i]));
+			}
+		}
+
+		SUBCASE("Batched queries should yield the same paths as single queries") {
+			const Vector<Vector3> start_positions = {
+				Vector3(0.5, 0, 1.5),
+				Vector3(3.5, 0, 4.5),
+				Vector3(5.5, 0, 7.5),
+				Vector3(7.5, 0, 4.5),
+			};
+			TypedArray<NavigationPathQueryParameters3D> parameters_array;
+			TypedArray<NavigationPathQueryResult3D> results_array;
+			for (const Vector3 &start_position : start_positions) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(start_position);
+				query_parameters->set_target_position(target_position);
+				parameters_array.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				results_array.push_back(query_result);
+			}
+			navigation_server->query_paths(parameters_array, results_array);
+
+			for (int i = 0; i < parameters_array.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(parameters_array[i], query_result);
+				const Vector<Vector3> path = query_result->get_path();
+				const Vector<Vector3> batched_path = Ref<NavigationPathQueryResult3D>(results_array[i])->get_path();
+				REQUIRE_GE(path.size(), 2);
+				REQUIRE_EQ(batched_path.size(), path.size());
+				for (int j = 0; j < path.size(); j++) {
+					CHECK(batched_path[j].is_equal_approx(path[j]));
+				}
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should only cluster changed regions again with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Vector<String> open_rows = {
+			"........",
+			"........",
+			"........",
+			"........",
+			"........",
+			"........",
+			"........",
+			"........",
+		};
+
+		RID map = navigation_server->map_create();
+		RID region_1 = navigation_server->region_create();
+		RID region_2 = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->map_set_hierarchical_pathfinding_chunk_size(map, 2.0);
+		navigation_server->region_set_use_async_iterations(region_1, false);
+		navigation_server->region_set_use_async_iterations(region_2, false);
+		navigation_server->region_set_map(region_1, map);
+		navigation_server->region_set_map(region_2, map);
+		navigation_server->region_set_navigation_mesh(region_1, create_grid_navigation_mesh(open_rows));
+		navigation_server->region_set_navigation_mesh(region_2, create_grid_navigation_mesh(open_rows));
+		navigation_server->region_set_transform(region_2, Transform3D(Basis(), Vector3(8, 0, 0)));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start_position = Vector3(0.5, 0, 0.5);
+		const Vector3 target_position = Vector3(15.5, 0, 0.5);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start_position, target_position, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(target_position));
+		CHECK_EQ(get_path_length(path), doctest::Approx(15.0));
+
+		// Only the second region changes, the clusters of the first one are kept.
+		const Vector<String> walled_rows = {
+			"..#.....",
+			"..#.....",
+			"..#.....",
+			"..#.....",
+			"..#.....",
+			"..#.....",
+			"..#.....",
+			"........",
+		};
+		navigation_server->region_set_navigation_mesh(region_2, create_grid_navigation_mesh(walled_rows));
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		path = navigation_server->map_get_path(map, start_position, target_position, true);
+		REQUIRE_GE(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(target_position));
+		const real_t path_length = get_path_length(path);
+		const real_t full_path_length = get_path_length(get_path_without_hierarchical_pathfinding(map, start_position, target_position, true));
+		CHECK_GT(path_length, 15.5);
+		CHECK_GE(path_length, full_path_length - 0.001);
+		CHECK_LE(path_length, full_path_length * 1.05);
+
+		navigation_server->free(region_2);
+		navigation_server->free(region_1);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
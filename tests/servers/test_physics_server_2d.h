@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+// A floor and a few boxes of different heights, standing on it.
+struct TestScene2D {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space;
+	RID box_shape;
+	RID floor_shape;
+	LocalVector<RID> bodies;
+
+	RID add_static_body(RID p_shape, const Transform2D &p_transform) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(body, p_shape);
+		server->body_set_space(body, space);
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, p_transform);
+		bodies.push_back(body);
+		return body;
+	}
+
+	TestScene2D() {
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		box_shape = server->rectangle_shape_create();
+		server->shape_set_data(box_shape, Vector2(1, 1));
+		floor_shape = server->rectangle_shape_create();
+		server->shape_set_data(floor_shape, Vector2(20, 0.5));
+
+		add_static_body(floor_shape, Transform2D(0, Vector2(0, 0.5)));
+		for (int i = 0; i < 5; i++) {
+			add_static_body(box_shape, Transform2D(0.3 * i, Vector2(i * 5 - 10, -1 - (i % 3))));
+		}
+	}
+
+	~TestScene2D() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		server->free(box_shape);
+		server->free(floor_shape);
+		server->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Batched queries match single queries") {
+	TestScene2D scene;
+	PhysicsDirectSpaceState2D *space_state = scene.server->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	// Enough queries to be split in several parts, some of them missing everything.
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	for (int i = 0; i < 200; i++) {
+		const Vector2 position(i * 0.2 - 20, -10);
+		from.push_back(position);
+		to.push_back(position + Vector2((i % 9) - 4, 20));
+	}
+	from.push_back(Vector2(30, -10));
+	to.push_back(Vector2(30, -20));
+	const int count = from.size();
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState2D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+		results.resize(count);
+		LocalVector<bool> hits;
+		hits.resize(count);
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), count, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < count; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState2D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+				CHECK(results[i].position.is_equal_approx(result.position));
+				CHECK(results[i].normal.is_equal_approx(result.normal));
+			}
+		}
+		CHECK(hit_count > 0);
+		CHECK(hit_count < count);
+	}
+
+	SUBCASE("Shape casts") {
+		RID circle_shape = scene.server->circle_shape_create();
+		scene.server->shape_set_data(circle_shape, 0.5);
+
+		PhysicsDirectSpaceState2D::ShapeParameters parameters;
+		parameters.shape_rid = circle_shape;
+		LocalVector<Transform2D> transforms;
+		LocalVector<Vector2> motions;
+		for (int i = 0; i < count; i++) {
+			transforms.push_back(Transform2D(0, from[i]));
+			motions.push_back(to[i] - from[i]);
+		}
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(count);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(count);
+		space_state->cast_motions(parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int blocked_count = 0;
+		for (int i = 0; i < count; i++) {
+			parameters.transform = transforms[i];
+			parameters.motion = motions[i];
+			real_t safe = 1.0;
+			real_t unsafe = 1.0;
+			space_state->cast_motion(parameters, safe, unsafe);
+			CHECK(closest_safe[i] == doctest::Approx(safe));
+			CHECK(closest_unsafe[i] == doctest::Approx(unsafe));
+			if (safe < 1.0) {
+				blocked_count++;
+			}
+		}
+		CHECK(blocked_count > 0);
+		CHECK(blocked_count < count);
+
+		scene.server->free(circle_shape);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Batched queries from scripts") {
+	TestScene2D scene;
+	PhysicsDirectSpaceState2D *space_state = scene.server->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	Ref<PhysicsRayQueryParameters2D> ray_query;
+	ray_query.instantiate();
+	Ref<PhysicsShapeQueryParameters2D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(scene.box_shape);
+
+	SUBCASE("Empty batches") {
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, PackedVector2Array(), PackedVector2Array());
+		CHECK(PackedByteArray(rays["hit"]).is_empty());
+		CHECK(PackedVector2Array(rays["position"]).is_empty());
+
+		Vector<real_t> casts = space_state->call("cast_motions_batch", shape_query, PackedVector2Array(), PackedVector2Array());
+		CHECK(casts.is_empty());
+	}
+
+	SUBCASE("Arrays of different sizes are rejected") {
+		const PackedVector2Array one = { Vector2(0, -10) };
+		const PackedVector2Array two = { Vector2(0, 10), Vector2(5, 10) };
+
+		ERR_PRINT_OFF;
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, one, two);
+		Vector<real_t> casts = space_state->call("cast_motions_batch", shape_query, two, one);
+		ERR_PRINT_ON;
+
+		CHECK(rays.is_empty());
+		CHECK(casts.is_empty());
+	}
+
+	SUBCASE("Results are packed per query") {
+		const PackedVector2Array from = { Vector2(-10, -10), Vector2(30, -10) };
+		const PackedVector2Array to = { Vector2(-10, 10), Vector2(30, 10) };
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, from, to);
+		const PackedByteArray hit = rays["hit"];
+		REQUIRE(hit.size() == 2);
+		CHECK(hit[0] == 1);
+		CHECK(hit[1] == 0);
+		CHECK(PackedVector2Array(rays["position"])[0].y == doctest::Approx(-2));
+	}
+}
+
+} // namespace TestPhysicsServer2D
@@ -0,0 +1,342 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A floor and a few boxes of different heights, standing on it.
+struct TestScene3D {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space;
+	RID box_shape;
+	RID floor_shape;
+	LocalVector<RID> bodies;
+
+	RID add_static_body(RID p_shape, const Transform3D &p_transform) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, p_shape);
+		server->body_set_space(body, space);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+		bodies.push_back(body);
+		return body;
+	}
+
+	TestScene3D() {
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		box_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+		server->shape_set_data(box_shape, Vector3(1, 1, 1));
+		floor_shape = server->shape_create(PhysicsServer3D::SHAPE_BOX);
+		server->shape_set_data(floor_shape, Vector3(20, 0.5, 20));
+
+		add_static_body(floor_shape, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+		for (int i = 0; i < 9; i++) {
+			const Vector3 position((i % 3) * 5 - 5, 1 + (i % 4), (i / 3) * 5 - 5);
+			add_static_body(box_shape, Transform3D(Basis(Vector3(0, 1, 0), 0.3 * i), position));
+		}
+	}
+
+	~TestScene3D() {
+		for (const RID &body : bodies) {
+			server->free(body);
+		}
+		server->free(box_shape);
+		server->free(floor_shape);
+		server->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries match single queries") {
+	TestScene3D scene;
+	PhysicsDirectSpaceState3D *space_state = scene.server->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	// Enough queries to be split in several parts, some of them missing everything.
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int x = 0; x < 16; x++) {
+		for (int z = 0; z < 16; z++) {
+			const Vector3 position(x * 2 - 15, 10, z * 2 - 15);
+			from.push_back(position);
+			to.push_back(position + Vector3(x - 8, -20, 0));
+		}
+	}
+	from.push_back(Vector3(30, 10, 30));
+	to.push_back(Vector3(30, 20, 30));
+	const int count = from.size();
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(count);
+		LocalVector<bool> hits;
+		hits.resize(count);
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), count, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < count; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].collider_id == result.collider_id);
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+				CHECK(results[i].position.is_equal_approx(result.position));
+				CHECK(results[i].normal.is_equal_approx(result.normal));
+			}
+		}
+		CHECK(hit_count > 0);
+		CHECK(hit_count < count);
+	}
+
+	SUBCASE("Shape casts") {
+		RID sphere_shape = scene.server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+		scene.server->shape_set_data(sphere_shape, 0.5);
+
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere_shape;
+		LocalVector<Transform3D> transforms;
+		LocalVector<Vector3> motions;
+		for (int i = 0; i < count; i++) {
+			transforms.push_back(Transform3D(Basis(), from[i]));
+			motions.push_back(to[i] - from[i]);
+		}
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(count);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(count);
+		space_state->cast_motions(parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int blocked_count = 0;
+		for (int i = 0; i < count; i++) {
+			parameters.transform = transforms[i];
+			parameters.motion = motions[i];
+			real_t safe = 1.0;
+			real_t unsafe = 1.0;
+			space_state->cast_motion(parameters, safe, unsafe);
+			CHECK(closest_safe[i] == doctest::Approx(safe));
+			CHECK(closest_unsafe[i] == doctest::Approx(unsafe));
+			if (safe < 1.0) {
+				blocked_count++;
+			}
+		}
+		CHECK(blocked_count > 0);
+		CHECK(blocked_count < count);
+
+		scene.server->free(sphere_shape);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries from scripts") {
+	TestScene3D scene;
+	PhysicsDirectSpaceState3D *space_state = scene.server->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	Ref<PhysicsShapeQueryParameters3D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(scene.box_shape);
+
+	SUBCASE("Empty batches") {
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, PackedVector3Array(), PackedVector3Array());
+		CHECK(PackedByteArray(rays["hit"]).is_empty());
+		CHECK(PackedVector3Array(rays["position"]).is_empty());
+
+		Vector<real_t> casts = space_state->call("cast_motions_batch", shape_query, PackedVector3Array(), PackedVector3Array());
+		CHECK(casts.is_empty());
+	}
+
+	SUBCASE("Arrays of different sizes are rejected") {
+		const PackedVector3Array one = { Vector3(0, 10, 0) };
+		const PackedVector3Array two = { Vector3(0, -10, 0), Vector3(5, -10, 0) };
+
+		ERR_PRINT_OFF;
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, one, two);
+		Vector<real_t> casts = space_state->call("cast_motions_batch", shape_query, two, one);
+		ERR_PRINT_ON;
+
+		CHECK(rays.is_empty());
+		CHECK(casts.is_empty());
+	}
+
+	SUBCASE("Results are packed per query") {
+		const PackedVector3Array from = { Vector3(-5, 10, -5), Vector3(30, 10, 30) };
+		const PackedVector3Array to = { Vector3(-5, -10, -5), Vector3(30, -10, 30) };
+		Dictionary rays = space_state->call("intersect_rays_batch", ray_query, from, to);
+		const PackedByteArray hit = rays["hit"];
+		const PackedInt64Array collider_id = rays["collider_id"];
+		REQUIRE(hit.size() == 2);
+		CHECK(hit[0] == 1);
+		CHECK(hit[1] == 0);
+		CHECK(collider_id[1] == 0);
+		CHECK(PackedInt32Array(rays["face_index"])[1] == -1);
+	}
+}
+
+static bool _test_body_motion(void *p_userdata, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+	const RID *body = static_cast<const RID *>(p_userdata);
+	return PhysicsServer3D::get_singleton()->body_test_motion(*body, p_parameters, r_result);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched slides match sequential slides") {
+	TestScene3D scene;
+	RID sphere_shape = scene.server->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	scene.server->shape_set_data(sphere_shape, 0.3);
+
+	// Characters standing on the floor and running into the boxes from all sides, enough to be split in several parts.
+	LocalVector<RID> characters;
+	LocalVector<PhysicsServer3D::SlideState> initial_states;
+	for (int i = 0; i < 80; i++) {
+		RID body = scene.server->body_create();
+		scene.server->body_set_mode(body, PhysicsServer3D::BODY_MODE_KINEMATIC);
+		scene.server->body_add_shape(body, sphere_shape);
+		scene.server->body_set_space(body, scene.space);
+
+		PhysicsServer3D::SlideState state;
+		const real_t angle = Math::TAU * i / 80;
+		state.transform.origin = Vector3(Math::cos(angle) * 9, 0.301, Math::sin(angle) * 9);
+		state.velocity = Vector3(-Math::cos(angle * 3) * 40, -10, -Math::sin(angle * 3) * 40);
+		scene.server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, state.transform);
+
+		characters.push_back(body);
+		initial_states.push_back(state);
+	}
+	const int count = characters.size();
+	const real_t delta = 0.1;
+	PhysicsServer3D::SlideParameters parameters;
+
+	SUBCASE("Solving") {
+		LocalVector<PhysicsServer3D::SlideState> states = initial_states;
+		REQUIRE(scene.server->body_solve_slide_batch(characters.ptr(), states.ptr(), count, parameters, delta));
+
+		int wall_count = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsServer3D::SlideState expected = initial_states[i];
+			PhysicsServer3D::solve_slide(parameters, delta, expected, _test_body_motion, &characters[i]);
+
+			CHECK(states[i].transform.is_equal_approx(expected.transform));
+			CHECK(states[i].velocity.is_equal_approx(expected.velocity));
+			CHECK(states[i].floor_normal.is_equal_approx(expected.floor_normal));
+			CHECK(states[i].wall_normal.is_equal_approx(expected.wall_normal));
+			CHECK(states[i].on_floor == expected.on_floor);
+			CHECK(states[i].on_wall == expected.on_wall);
+			CHECK(states[i].on_ceiling == expected.on_ceiling);
+			if (states[i].on_wall) {
+				wall_count++;
+				// Walls are steeper than the floor angle, so they point away from up.
+				CHECK(states[i].wall_normal.is_normalized());
+				CHECK(states[i].wall_normal.angle_to(parameters.up_direction) > parameters.floor_max_angle);
+			} else {
+				CHECK(states[i].wall_normal == Vector3());
+			}
+			// Solving doesn't move the bodies.
+			const Transform3D transform = scene.server->body_get_state(characters[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(initial_states[i].transform));
+		}
+		CHECK(wall_count > 0);
+	}
+
+	SUBCASE("Moving") {
+		LocalVector<PhysicsServer3D::SlideState> states = initial_states;
+		REQUIRE(scene.server->body_move_and_slide_batch(characters.ptr(), states.ptr(), count, parameters, delta));
+		for (int i = 0; i < count; i++) {
+			const Transform3D transform = scene.server->body_get_state(characters[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(states[i].transform));
+		}
+	}
+
+	SUBCASE("Results are packed per body for scripts") {
+		LocalVector<PhysicsServer3D::SlideState> states = initial_states;
+		REQUIRE(scene.server->body_solve_slide_batch(characters.ptr(), states.ptr(), count, parameters, delta));
+
+		TypedArray<RID> bodies;
+		TypedArray<Transform3D> transforms;
+		PackedVector3Array velocities;
+		for (int i = 0; i < count; i++) {
+			bodies.push_back(characters[i]);
+			transforms.push_back(initial_states[i].transform);
+			velocities.push_back(initial_states[i].velocity);
+		}
+		Dictionary result = scene.server->call("body_move_and_slide_batch", bodies, transforms, velocities, delta);
+
+		const PackedVector3Array floor_normal = result["floor_normal"];
+		const PackedVector3Array wall_normal = result["wall_normal"];
+		const PackedByteArray on_wall = result["on_wall"];
+		REQUIRE(floor_normal.size() == count);
+		REQUIRE(wall_normal.size() == count);
+		REQUIRE(on_wall.size() == count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floor_normal[i].is_equal_approx(states[i].floor_normal));
+			CHECK(wall_normal[i].is_equal_approx(states[i].wall_normal));
+			CHECK(on_wall[i] == (uint8_t)states[i].on_wall);
+		}
+	}
+
+	SUBCASE("A body outside the space fails the whole batch") {
+		RID outside = scene.server->body_create();
+		scene.server->body_set_mode(outside, PhysicsServer3D::BODY_MODE_KINEMATIC);
+		scene.server->body_add_shape(outside, sphere_shape);
+		LocalVector<RID> bodies = characters;
+		bodies.push_back(outside);
+		LocalVector<PhysicsServer3D::SlideState> states = initial_states;
+		states.push_back(PhysicsServer3D::SlideState());
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(scene.server->body_move_and_slide_batch(bodies.ptr(), states.ptr(), bodies.size(), parameters, delta));
+		ERR_PRINT_ON;
+
+		for (int i = 0; i < count; i++) {
+			CHECK(states[i].transform == initial_states[i].transform);
+			CHECK(states[i].velocity == initial_states[i].velocity);
+			const Transform3D transform = scene.server->body_get_state(characters[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform == initial_states[i].transform);
+		}
+		scene.server->free(outside);
+	}
+
+	for (const RID &body : characters) {
+		scene.server->free(body);
+	}
+	scene.server->free(sphere_shape);
+}
+
+} // namespace TestPhysicsServer3D
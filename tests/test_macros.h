@@ -35,6 +35,7 @@
 #include "core/core_globals.h"
 #include "core/input/input_map.h"
 #include "core/object/message_queue.h"
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 
 // See documentation for doctest at:
@@ -44,6 +45,20 @@
 // The test is skipped with this, run pending tests with `--test --no-skip`.
 #define TEST_CASE_PENDING(name) TEST_CASE(name *doctest::skip())
 
+// Benchmarks only print their timings, so they are pending tests too.
+// Run them with `--test --no-skip --test-case="*Benchmark*"`.
+#define TEST_CASE_BENCHMARK(name) TEST_CASE_PENDING("[Benchmark]" name)
+
+// Returns the average time of `p_runs` calls to `p_function`, in milliseconds.
+template <typename F>
+double benchmark_msec(int p_runs, F &&p_function) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_runs; i++) {
+		p_function();
+	}
+	return double(OS::get_singleton()->get_ticks_usec() - begin) / p_runs / 1000.0;
+}
+
 // The test case is marked as failed, but does not fail the entire test run.
 #define TEST_CASE_MAY_FAIL(name) TEST_CASE(name *doctest::may_fail())
 